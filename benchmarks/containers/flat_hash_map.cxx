@@ -0,0 +1,112 @@
+module;
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.benchmarks:flat_hash_map;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    constexpr usize count = 100'000;
+
+    /// --------------------------------------------------------------------------------------------
+    /// keys spread over the whole `u64` range, `count` hits followed by `count` misses.
+    /// --------------------------------------------------------------------------------------------
+    auto make_keys() -> dynamic_array<u64>
+    {
+        dynamic_array<u64> keys;
+        keys.reserve(count * 2);
+
+        u64 state = 0x9e3779b97f4a7c15;
+        for (usize i = 0; i < count * 2; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            keys.emplace_last(state);
+        }
+
+        return keys;
+    }
+
+    template <typename map_type, typename insert_type>
+    auto run_benchmarks(const char* name, insert_type insert)
+    {
+        const dynamic_array<u64> keys = make_keys();
+
+        map_type filled;
+        for (usize i = 0; i < count; i++)
+            insert(filled, keys.get_at(i));
+
+        BENCHMARK(std::string(name) + " insert")
+        {
+            map_type map;
+            for (usize i = 0; i < count; i++)
+                insert(map, keys.get_at(i));
+
+            return map.size();
+        };
+
+        BENCHMARK(std::string(name) + " hit")
+        {
+            usize found = 0;
+            for (usize i = 0; i < count; i++)
+                found += filled.contains(keys.get_at(i));
+
+            return found;
+        };
+
+        BENCHMARK(std::string(name) + " miss")
+        {
+            usize found = 0;
+            for (usize i = count; i < count * 2; i++)
+                found += filled.contains(keys.get_at(i));
+
+            return found;
+        };
+
+        BENCHMARK_ADVANCED(std::string(name) + " erase")(Catch::Benchmark::Chronometer meter)
+        {
+            // a filled copy for each run, made outside of the measured code.
+            std::vector<map_type> maps(meter.runs(), filled);
+            meter.measure([&](int run) {
+                usize removed = 0;
+                for (usize i = 0; i < count; i++)
+                    removed += maps[run].erase(keys.get_at(i));
+
+                return removed;
+            });
+        };
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// adapts `flat_hash_map` to the names used by `std::unordered_map`, so both run the same
+    /// benchmark code.
+    /// --------------------------------------------------------------------------------------------
+    class flat_hash_map_adapter: public flat_hash_map<u64, u64>
+    {
+    public:
+        auto size() const -> usize
+        {
+            return get_count();
+        }
+
+        auto erase(u64 key) -> usize
+        {
+            return remove(key);
+        }
+    };
+}
+
+TEST_CASE("atom_core.benchmarks.flat_hash_map")
+{
+    run_benchmarks<flat_hash_map_adapter>(
+        "flat_hash_map", [](auto& map, u64 key) { map.emplace(key, key); });
+
+    run_benchmarks<unordered_map<u64, u64>>(
+        "unordered_map", [](auto& map, u64 key) { map.emplace(key, key); });
+}
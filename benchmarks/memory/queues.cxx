@@ -0,0 +1,179 @@
+module;
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.benchmarks:queues;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    constexpr u64 count = 200'000;
+    constexpr usize capacity = 1024;
+    constexpr u64 round_trips = 10'000;
+
+    /// --------------------------------------------------------------------------------------------
+    /// pushes `count` values from each of `producer_count` threads and pops them all from
+    /// `consumer_count` threads, so the time taken is the throughput of `queue_type`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename queue_type>
+    auto run_throughput(usize producer_count, usize consumer_count) -> u64
+    {
+        queue_type queue{ capacity };
+        std::atomic<u64> sum{ 0 };
+        const u64 total = count * producer_count;
+
+        dynamic_array<std::thread> threads;
+        for (usize i = 0; i < consumer_count; i++)
+        {
+            threads.emplace_last([&] {
+                u64 local_sum = 0;
+                for (u64 j = 0; j < total / consumer_count; j++)
+                    local_sum += queue.pop();
+
+                sum.fetch_add(local_sum, std::memory_order_relaxed);
+            });
+        }
+
+        for (usize i = 0; i < producer_count; i++)
+        {
+            threads.emplace_last([&] {
+                for (u64 j = 0; j < count; j++)
+                    queue.push(j);
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        return sum.load();
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// same as `run_throughput()` for one producer and consumer, moving values in batches.
+    /// --------------------------------------------------------------------------------------------
+    template <typename queue_type>
+    auto run_batch_throughput() -> u64
+    {
+        static constexpr usize batch_size = 64;
+
+        queue_type queue{ capacity };
+        u64 sum = 0;
+
+        std::thread consumer{ [&] {
+            u64 out[batch_size];
+            for (u64 popped = 0; popped < count;)
+            {
+                usize batch = queue.try_pop_batch(out, batch_size);
+                if (batch == 0)
+                    std::this_thread::yield();
+
+                for (usize i = 0; i < batch; i++)
+                    sum += out[i];
+
+                popped += batch;
+            }
+        } };
+
+        u64 values[batch_size];
+        for (u64 pushed = 0; pushed < count; pushed += batch_size)
+        {
+            for (usize i = 0; i < batch_size; i++)
+                values[i] = pushed + i;
+
+            for (usize done = 0; done < batch_size;)
+            {
+                usize pushed_now = queue.try_push_batch(values + done, batch_size - done);
+                if (pushed_now == 0)
+                    std::this_thread::yield();
+
+                done += pushed_now;
+            }
+        }
+
+        consumer.join();
+        return sum;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// bounces a value between two threads `round_trips` times, so the time taken divided by
+    /// `round_trips` is the latency of two pushes and pops, including wakeups.
+    /// --------------------------------------------------------------------------------------------
+    template <typename queue_type>
+    auto run_latency() -> u64
+    {
+        queue_type ping{ capacity };
+        queue_type pong{ capacity };
+
+        std::thread echo{ [&] {
+            for (u64 i = 0; i < round_trips; i++)
+                pong.push(ping.pop() + 1);
+        } };
+
+        u64 value = 0;
+        for (u64 i = 0; i < round_trips; i++)
+        {
+            ping.push(value);
+            value = pong.pop();
+        }
+
+        echo.join();
+        return value;
+    }
+}
+
+TEST_CASE("atom_core.benchmarks.queues")
+{
+    BENCHMARK("spsc_queue 1p 1c")
+    {
+        return run_throughput<spsc_queue<u64>>(1, 1);
+    };
+
+    BENCHMARK("spsc_queue 1p 1c batches")
+    {
+        return run_batch_throughput<spsc_queue<u64>>();
+    };
+
+    BENCHMARK("mpmc_queue 1p 1c")
+    {
+        return run_throughput<mpmc_queue<u64>>(1, 1);
+    };
+
+    BENCHMARK("mpmc_queue 1p 1c batches")
+    {
+        return run_batch_throughput<mpmc_queue<u64>>();
+    };
+
+    BENCHMARK("mpmc_queue 2p 2c")
+    {
+        return run_throughput<mpmc_queue<u64>>(2, 2);
+    };
+
+    BENCHMARK("mpmc_queue 4p 1c")
+    {
+        return run_throughput<mpmc_queue<u64>>(4, 1);
+    };
+
+    BENCHMARK("mpmc_queue 1p 4c")
+    {
+        return run_throughput<mpmc_queue<u64>>(1, 4);
+    };
+
+    BENCHMARK("mpmc_queue 4p 4c")
+    {
+        return run_throughput<mpmc_queue<u64>>(4, 4);
+    };
+
+    BENCHMARK("spsc_queue round trip latency")
+    {
+        return run_latency<spsc_queue<u64>>();
+    };
+
+    BENCHMARK("mpmc_queue round trip latency")
+    {
+        return run_latency<mpmc_queue<u64>>();
+    };
+}
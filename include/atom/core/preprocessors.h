@@ -73,6 +73,13 @@
 #    define ATOM_PLATFORM_UNKNOWN
 #endif
 
+/// ------------------------------------------------------------------------------------------------
+/// architecture
+/// ------------------------------------------------------------------------------------------------
+#if defined(__x86_64__) || defined(_M_X64)
+#    define ATOM_ARCH_X86_64
+#endif
+
 /// ------------------------------------------------------------------------------------------------
 /// compiler
 /// ------------------------------------------------------------------------------------------------
@@ -110,6 +117,39 @@
 
 #endif
 
+/// ------------------------------------------------------------------------------------------------
+/// simd instruction sets enabled for the target.
+///
+/// \par macros
+/// - `ATOM_SIMD_SSE2`: sse2 instructions are available.
+/// - `ATOM_SIMD_SSE4_2`: sse4.2 instructions are available.
+/// - `ATOM_SIMD_AVX2`: avx2 instructions are available.
+/// ------------------------------------------------------------------------------------------------
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ATOM_SIMD_SSE2
+#endif
+
+#if defined(__SSE4_2__)
+#    define ATOM_SIMD_SSE4_2
+#endif
+
+#if defined(__AVX2__)
+#    define ATOM_SIMD_AVX2
+#endif
+
+/// ------------------------------------------------------------------------------------------------
+/// `ATOM_ATTR_TARGET(isa)`: compiles a function for instruction set `isa`, like `"avx2"`, even if
+/// it's not enabled for the target. callers must check for support at runtime.
+///
+/// `ATOM_HAS_ATTR_TARGET` is defined if the compiler supports it.
+/// ------------------------------------------------------------------------------------------------
+#if defined(ATOM_COMPILER_CLANG) || defined(ATOM_COMPILER_GNUC)
+#    define ATOM_HAS_ATTR_TARGET
+#    define ATOM_ATTR_TARGET(isa) __attribute__((target(isa)))
+#else
+#    define ATOM_ATTR_TARGET(isa)
+#endif
+
 /// ------------------------------------------------------------------------------------------------
 /// optimization handling macros.
 ///
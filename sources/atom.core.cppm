@@ -13,6 +13,8 @@ export import :time;
 export import :hash;
 export import :filesystem;
 export import :io;
+export import :parallel;
+export import :coroutines;
 
 export import :mem_helper;
 export import :lock_guard;
@@ -22,11 +24,17 @@ export import :atomic;
 export import :mutex;
 export import :null_lockable;
 export import :shared_ptr;
+export import :intrusive_ptr;
 export import :unique_ptr;
 export import :default_mem_allocator;
 export import :legacy_mem_allocator;
+export import :pool_mem_allocator;
+export import :arena_allocator;
 export import :function_box;
 export import :dynamic_buffer;
+export import :futex;
+export import :spsc_queue;
+export import :mpmc_queue;
 
 export
 {
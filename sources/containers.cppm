@@ -6,3 +6,7 @@ export import :containers.buf_array;
 export import :containers.array_slice;
 export import :containers.array_view;
 export import :containers.unordered_map;
+export import :containers.flat_hash_map;
+export import :containers.flat_hash_set;
+export import :containers.enum_set;
+export import :containers.enum_map;
@@ -7,18 +7,51 @@ import :containers.dynamic_array;
 
 namespace atom
 {
-    template <typename allocator_type>
+    /// --------------------------------------------------------------------------------------------
+    /// wraps `allocator_type` to ask `dynamic_array` for an inline buffer of `buf_size` values.
+    /// --------------------------------------------------------------------------------------------
+    template <typename allocator_type, usize buf_size>
     class _buf_array_alloc_wrap: public allocator_type
-    {};
+    {
+    public:
+        constexpr _buf_array_alloc_wrap() = default;
+
+        constexpr _buf_array_alloc_wrap(allocator_type allocator)
+            : allocator_type{ move(allocator) }
+        {}
 
+    public:
+        static consteval auto get_buf_size() -> usize
+        {
+            return buf_size;
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// `dynamic_array` which stores upto `buf_size` values inline, without allocating. when the
+    /// count exceeds `buf_size`, values are moved to memory allocated using `allocator_type`.
+    /// --------------------------------------------------------------------------------------------
     export template <typename value_type, usize buf_size,
         typename allocator_type = default_mem_allocator>
-    class buf_array: public dynamic_array<value_type, _buf_array_alloc_wrap<allocator_type>>
+    class buf_array
+        : public dynamic_array<value_type, _buf_array_alloc_wrap<allocator_type, buf_size>>
     {
-        using base_type = dynamic_array<value_type, _buf_array_alloc_wrap<allocator_type>>;
+        static_assert(buf_size > 0, "buf_array requires a non zero buf_size.");
+
+        using base_type =
+            dynamic_array<value_type, _buf_array_alloc_wrap<allocator_type, buf_size>>;
 
     public:
         using base_type::base_type;
         using base_type::operator=;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of values that can be stored without allocating.
+        /// ----------------------------------------------------------------------------------------
+        static consteval auto get_buf_size() -> usize
+        {
+            return buf_size;
+        }
     };
 }
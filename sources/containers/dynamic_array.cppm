@@ -5,7 +5,7 @@ import :ranges;
 import :types;
 import :contracts;
 import :default_mem_allocator;
-import :containers.dynamic_array_impl_vector;
+import :containers.dynamic_array_impl;
 
 namespace atom
 {
@@ -27,7 +27,8 @@ namespace atom
 
     private:
         using this_type = dynamic_array<in_value_type, in_allocator_type>;
-        using impl_type = dynamic_array_impl_vector<in_value_type, in_allocator_type>;
+        using impl_type = _dynamic_array_impl<in_value_type, in_allocator_type,
+            _get_dynamic_array_buf_size<in_allocator_type>()>;
         using value_type_info = type_info<in_value_type>;
 
     public:
@@ -46,6 +47,13 @@ namespace atom
             : _impl{}
         {}
 
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with nothing, using `allocator` to allocate memory.
+        /// ----------------------------------------------------------------------------------------
+        constexpr dynamic_array(create_with_allocator_tag, allocator_type allocator)
+            : _impl{ create_with_allocator, move(allocator) }
+        {}
+
         /// ----------------------------------------------------------------------------------------
         /// initializes by copying each value to a new allocated array.
         /// ----------------------------------------------------------------------------------------
@@ -107,6 +115,7 @@ namespace atom
                     value_type>)
         {
             _impl.assign_range(ranges::get_iterator(range), ranges::get_iterator_end(range));
+            return *this;
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -240,7 +249,7 @@ namespace atom
         {
             contract_debug_expects(is_index_in_range_or_end(i), "index is out of range.");
 
-            _impl.emplace_at(i, forward<arg_types>(args)...);
+            _impl.emplace_many_at(i, count, args...);
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -264,7 +273,7 @@ namespace atom
             contract_debug_expects(is_iterator_in_range_or_end(it), "iterator is out of range.");
 
             usize index = get_index_for_iterator(it);
-            _impl.emplace_many_at(index, count, forward<arg_types>(args)...);
+            _impl.emplace_many_at(index, count, args...);
             return _impl.get_iterator_at(index);
         }
 
@@ -374,8 +383,9 @@ namespace atom
                 and value_type_info::template is_constructible_from<
                     ranges::value_type<typename type_info<range_type>::pure_type::value_type>>())
         {
-            usize count = _impl.insert_range_first(move(range));
-            return _impl.get_iterator(count);
+            usize count = _impl.insert_range_first(
+                ranges::get_iterator(range), ranges::get_iterator_end(range));
+            return _impl.get_iterator_at(count);
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -445,21 +455,21 @@ namespace atom
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// removes values from index `from` to `to`.
+        /// removes values in index range `[from, to)`.
         ///
-        /// \pre if debug `is_index_in_range(to)`: index was out of range.
+        /// \pre if debug `is_index_in_range_or_end(to)`: index was out of range.
         /// \pre if debug `from <= to`: index was out of range.
         /// ----------------------------------------------------------------------------------------
         constexpr auto remove_range(usize from, usize to) -> void
         {
-            contract_debug_expects(is_index_in_range(to), "index was out of range.");
+            contract_debug_expects(is_index_in_range_or_end(to), "index was out of range.");
             contract_debug_expects(from <= to, "index was out of range.");
 
-            _impl.remove_range(from, to);
+            _impl.remove_range(from, to - from);
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// removes values from position referenced by `from` to `to`.
+        /// removes values in range `[from, to)`.
         ///
         /// \returns `iterator_type` to next value of the last removed value. if the last
         /// removed value was also the last value of the array, returns `get_iterator_end()`.
@@ -467,7 +477,7 @@ namespace atom
         /// \pre if debug `is_iterator_valid(from)`: invalid iterator.
         /// \pre if debug `is_iterator_valid(to)`: invalid iterator.
         /// \pre if debug `is_iterator_in_range(from)`: iterator is out range.
-        /// \pre if debug `is_iterator_in_range(to)`: iterator is out range.
+        /// \pre if debug `is_iterator_in_range_or_end(to)`: iterator is out range.
         /// \pre if debug `(from - to) <= 0`: invalid range.
         /// ----------------------------------------------------------------------------------------
         constexpr auto remove_range(
@@ -476,14 +486,14 @@ namespace atom
             contract_debug_expects(is_iterator_valid(from), "invalid iterator.");
             contract_debug_expects(is_iterator_valid(to), "invalid iterator.");
             contract_debug_expects(is_iterator_in_range(from), "iterator is out range.");
-            contract_debug_expects(is_iterator_in_range(to), "iterator is out range.");
+            contract_debug_expects(is_iterator_in_range_or_end(to), "iterator is out range.");
             contract_debug_expects((from - to) <= 0, "invalid range.");
 
             usize from_index = get_index_for_iterator(from);
             usize to_index = get_index_for_iterator(to);
-            _impl.remove_range(from_index, to_index);
+            _impl.remove_range(from_index, to_index - from_index);
 
-            return _impl.get_iterator(from_index);
+            return _impl.get_iterator_at(from_index);
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -680,7 +690,25 @@ namespace atom
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// releases unused memory.
+        /// adds `count` values already written into the reserved places after the last value,
+        /// through `get_data()`. this lets the array be filled in bulk, without inserting values
+        /// one by one.
+        ///
+        /// \pre `count <= get_reserved_count()`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto commit_reserved(usize count) -> void
+            requires(type_info<value_type>::is_trivially_copyable())
+        {
+            contract_debug_expects(count <= get_reserved_count(), "not enough reserved places.");
+
+            _impl.commit_reserved(count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// releases unused memory, shrinking capacity to count. if the values fit in the inline
+        /// buffer, they are moved back into it.
+        ///
+        /// \note all iterators are invalidated after this operation.
         /// ----------------------------------------------------------------------------------------
         constexpr auto release_mem() -> void
         {
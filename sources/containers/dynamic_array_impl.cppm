@@ -2,15 +2,77 @@ export module atom_core:containers.dynamic_array_impl;
 
 import std;
 import :core;
+import :types;
 import :ranges;
 import :contracts;
 
+#include "atom/core/preprocessors.h"
+
 namespace atom
 {
-    template <typename in_value_type, typename in_allocator_type>
+    /// --------------------------------------------------------------------------------------------
+    /// \returns count of values `allocator_type` asks the array to store inline, before using the
+    /// allocator. allocators opt into this by providing `static consteval get_buf_size()`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename allocator_type>
+    consteval auto _get_dynamic_array_buf_size() -> usize
+    {
+        if constexpr (requires { allocator_type::get_buf_size(); })
+            return allocator_type::get_buf_size();
+        else
+            return 0;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// inline storage for `count` values of `value_type`, left uninitialized.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type, usize count>
+    class _dynamic_array_buf
+    {
+    public:
+        auto get_data() const -> const value_type*
+        {
+            return reinterpret_cast<const value_type*>(_storage);
+        }
+
+        auto get_data() -> value_type*
+        {
+            return reinterpret_cast<value_type*>(_storage);
+        }
+
+    public:
+        alignas(value_type) byte _storage[count * sizeof(value_type)];
+    };
+
+    template <typename value_type>
+    class _dynamic_array_buf<value_type, 0>
+    {
+    public:
+        constexpr auto get_data() const -> const value_type*
+        {
+            return nullptr;
+        }
+
+        constexpr auto get_data() -> value_type*
+        {
+            return nullptr;
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// native storage engine for `dynamic_array`. all memory is managed through `allocator_type`.
+    ///
+    /// trivially relocatable values are moved around using `memmove` and allocations holding them
+    /// are grown and shrunk using `allocator_type::realloc`.
+    ///
+    /// if `in_buf_size` is not `0`, the first `in_buf_size` values are stored in an inline buffer
+    /// and the allocator is used only when the count exceeds it.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_value_type, typename in_allocator_type, usize in_buf_size = 0>
     class _dynamic_array_impl
     {
         using this_type = _dynamic_array_impl;
+        using value_type_info = type_info<in_value_type>;
 
     public:
         using value_type = in_value_type;
@@ -38,20 +100,23 @@ namespace atom
             , _allocator{}
         {}
 
-        constexpr _dynamic_array_impl(copy_tag, const _dynamic_array_impl& that)
-            : this_type{ range_tag(), that.get_iterator(), that.get_iterator_end() }
+        constexpr _dynamic_array_impl(create_with_allocator_tag, allocator_type allocator)
+            : _data{ nullptr }
+            , _count{ 0 }
+            , _capacity{ 0 }
+            , _allocator{ move(allocator) }
         {}
 
+        constexpr _dynamic_array_impl(copy_tag, const _dynamic_array_impl& that)
+            : _dynamic_array_impl{ create_with_allocator, that._allocator }
+        {
+            _insert_range_last_counted(that._data, that._count);
+        }
+
         constexpr _dynamic_array_impl(move_tag, _dynamic_array_impl& that)
-            : _data{ that._data }
-            , _count{ that._count }
-            , _capacity{ that._capacity }
-            , _allocator{ that._allocator }
+            : _dynamic_array_impl{ create_with_allocator, that._allocator }
         {
-            that._data = nullptr;
-            that._count = 0;
-            that._capacity = 0;
-            that._allocator = allocator_type();
+            _take_from(that);
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
@@ -62,55 +127,49 @@ namespace atom
             insert_range_last(move(it), move(it_end));
         }
 
+        constexpr _dynamic_array_impl(create_from_raw_tag, const value_type* arr, usize count)
+            : _dynamic_array_impl{}
+        {
+            _insert_range_last_counted(arr, count);
+        }
+
         constexpr _dynamic_array_impl(create_with_count_tag, usize count)
-            : _count{ count }
-            , _capacity{ count }
-            , _allocator{}
+            : _dynamic_array_impl{}
         {
-            _data = (value_type*)_allocator.alloc(count);
+            emplace_many_last(count);
         }
 
         constexpr _dynamic_array_impl(create_with_count_tag, usize count, const value_type& value)
-            : _count{ count }
-            , _capacity{ count }
-            , _allocator{}
+            : _dynamic_array_impl{}
         {
-            _data = (value_type*)_allocator.alloc(count);
-
-            for (usize i = 0; i < _count; i++)
-                _data[i] = value;
+            emplace_many_last(count, value);
         }
 
         constexpr _dynamic_array_impl(create_with_capacity_tag, usize capacity)
-            : _count{ 0 }
-            , _capacity{ capacity }
-            , _allocator{}
+            : _dynamic_array_impl{}
         {
-            _data = (value_type*)_allocator.alloc(capacity);
+            _ensure_cap_for(capacity);
         }
 
         constexpr ~_dynamic_array_impl()
         {
-            if (_count != 0)
-            {
-                _destruct_all();
-                _release_all_mem();
-            }
+            _destruct_all();
+            _release_mem();
         }
 
     public:
         constexpr auto move_this(this_type& that) -> void
         {
-            if (_count != 0)
-            {
-                _destruct_all();
-                _release_all_mem();
-            }
+            if (this == &that)
+                return;
+
+            _destruct_all();
+            _release_mem();
 
-            _data = that._data;
-            _count = that._count;
-            _capacity = that._capacity;
-            _allocator = that._allocator;
+            _data = nullptr;
+            _count = 0;
+            _capacity = 0;
+            _take_from(that);
         }
 
         constexpr auto get_at(usize index) const -> const value_type&
@@ -118,7 +177,7 @@ namespace atom
             return _data[index];
         }
 
-        constexpr auto get_mut_at(usize index) -> value_type&
+        constexpr auto get_at(usize index) -> value_type&
         {
             return _data[index];
         }
@@ -138,17 +197,17 @@ namespace atom
             return iterator_end_type(_data + _count);
         }
 
-        constexpr auto get_mut_iterator() -> mut_iterator_type
+        constexpr auto get_iterator() -> mut_iterator_type
         {
             return mut_iterator_type(_data);
         }
 
-        constexpr auto get_mut_iterator_at(usize index) -> mut_iterator_type
+        constexpr auto get_iterator_at(usize index) -> mut_iterator_type
         {
             return mut_iterator_type(_data + index);
         }
 
-        constexpr auto get_mut_iterator_end() -> mut_iterator_end_type
+        constexpr auto get_iterator_end() -> mut_iterator_end_type
         {
             return mut_iterator_end_type(_data + _count);
         }
@@ -161,9 +220,80 @@ namespace atom
         }
 
         template <typename... arg_types>
-        constexpr auto emplace_at(usize index, arg_types&&... args)
+        constexpr auto emplace_at(usize index, arg_types&&... args) -> usize
+        {
+            // fast path, the value is constructed in place. in every other case the value is
+            // constructed first, as `args` may refer to a value inside this array.
+            if (index == _count and _count < _capacity)
+            {
+                _construct_at(_count, forward<arg_types>(args)...);
+                _count += 1;
+                return index;
+            }
+
+            value_type value(forward<arg_types>(args)...);
+            _ensure_space_at(index, 1);
+            _construct_at(index, move(value));
+            _count += 1;
+
+            return index;
+        }
+
+        template <typename... arg_types>
+        constexpr auto emplace_first(arg_types&&... args) -> usize
+        {
+            return emplace_at(0, forward<arg_types>(args)...);
+        }
+
+        template <typename... arg_types>
+        constexpr auto emplace_last(arg_types&&... args) -> usize
+        {
+            return emplace_at(_count, forward<arg_types>(args)...);
+        }
+
+        template <typename... arg_types>
+        constexpr auto emplace_many_at(usize index, usize count, const arg_types&... args) -> usize
+        {
+            if (count == 0)
+                return index;
+
+            // `args` may refer to a value inside this array, which is moved while making space. so
+            // unless values are only added at the end of the capacity, a value is constructed
+            // first and copied.
+            if constexpr (sizeof...(arg_types) > 0 and value_type_info::is_copy_constructible())
+            {
+                if (index != _count or _count + count > _capacity)
+                {
+                    value_type value(args...);
+                    _ensure_space_at(index, count);
+
+                    for (usize i = 0; i < count; i++)
+                        _construct_at(index + i, value);
+
+                    _count += count;
+                    return index;
+                }
+            }
+
+            _ensure_space_at(index, count);
+
+            for (usize i = 0; i < count; i++)
+                _construct_at(index + i, args...);
+
+            _count += count;
+            return index;
+        }
+
+        template <typename... arg_types>
+        constexpr auto emplace_many_first(usize count, const arg_types&... args) -> usize
+        {
+            return emplace_many_at(0, count, args...);
+        }
+
+        template <typename... arg_types>
+        constexpr auto emplace_many_last(usize count, const arg_types&... args) -> usize
         {
-            return _emplace_at(index, forward<arg_types>(args)...);
+            return emplace_many_at(_count, count, args...);
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
@@ -172,7 +302,9 @@ namespace atom
         {
             if constexpr (_can_get_range_size<other_iterator_type, other_iterator_end_type>())
             {
-                return _insert_range_at_counted(index, it, _get_range_size(move(it), move(it_end)));
+                usize count = _get_range_size(it, move(it_end));
+                _insert_range_at_counted(index, move(it), count);
+                return count;
             }
             else
             {
@@ -180,12 +312,6 @@ namespace atom
             }
         }
 
-        template <typename... arg_types>
-        constexpr auto emplace_first(arg_types&&... args)
-        {
-            return _emplace_first(forward<arg_types>(args)...);
-        }
-
         template <typename other_iterator_type, typename other_iterator_end_type>
         constexpr auto insert_range_first(
             other_iterator_type it, other_iterator_end_type it_end) -> usize
@@ -193,20 +319,14 @@ namespace atom
             return insert_range_at(0, move(it), move(it_end));
         }
 
-        template <typename... arg_types>
-        constexpr auto emplace_last(arg_types&&... args)
-        {
-            return _emplace_at(_count, forward<arg_types>(args)...);
-        }
-
         template <typename other_iterator_type, typename other_iterator_end_type>
         constexpr auto insert_range_last(
             other_iterator_type it, other_iterator_end_type it_end) -> usize
         {
             if constexpr (_can_get_range_size<other_iterator_type, other_iterator_end_type>())
             {
-                usize count = _get_range_size(move(it), move(it_end));
-                _insert_range_last_counted(it, count);
+                usize count = _get_range_size(it, move(it_end));
+                _insert_range_last_counted(move(it), count);
                 return count;
             }
             else
@@ -215,39 +335,82 @@ namespace atom
             }
         }
 
-        constexpr auto remove_at(usize index)
+        constexpr auto remove_at(usize index) -> void
         {
-            _destruct_at(index);
-            _shift_range_first(index, 1);
+            remove_range(index, 1);
         }
 
-        constexpr auto remove_range(usize begin, usize count)
+        constexpr auto remove_range(usize index, usize count) -> void
         {
-            _destruct_range(begin, count);
-            _shift_range_first(begin + count, count);
+            if (count == 0)
+                return;
+
+            _destruct_range(index, count);
+            _relocate_range_first(index + count, count);
+            _count -= count;
         }
 
-        constexpr auto remove_all()
+        constexpr auto remove_first(usize count) -> void
         {
-            if (_count != 0)
-            {
-                _destruct_all();
-                _count = 0;
-            }
+            remove_range(0, count);
+        }
+
+        constexpr auto remove_last(usize count) -> void
+        {
+            _destruct_range(_count - count, count);
+            _count -= count;
+        }
+
+        constexpr auto remove_all() -> void
+        {
+            _destruct_all();
+            _count = 0;
         }
 
-        constexpr auto reserve(usize count)
+        constexpr auto reserve(usize count) -> void
         {
             _ensure_cap_for(count);
         }
 
-        constexpr auto reserve_more(usize count)
+        constexpr auto reserve_more(usize count) -> void
         {
             _ensure_cap_for(_count + count);
         }
 
-        // todo: implement this.
-        constexpr auto release_unused_mem() {}
+        constexpr auto commit_reserved(usize count) -> void
+        {
+            _count += count;
+        }
+
+        constexpr auto release_unused_mem() -> void
+        {
+            if (_count == _capacity or _is_using_buf())
+                return;
+
+            if (_count == 0)
+            {
+                _release_mem();
+                _data = nullptr;
+                _capacity = 0;
+                return;
+            }
+
+            // values fit in the inline buffer again.
+            if constexpr (in_buf_size != 0)
+            {
+                if (_count <= in_buf_size)
+                {
+                    value_type* old_data = _data;
+                    _data = _buf.get_data();
+                    _relocate_to(old_data, _count, _data);
+                    _allocator.dealloc(old_data);
+                    _capacity = in_buf_size;
+                    return;
+                }
+            }
+
+            _realloc_mem(_count);
+        }
 
         constexpr auto get_capacity() const -> usize
         {
@@ -264,7 +427,7 @@ namespace atom
             return _data;
         }
 
-        constexpr auto get_mut_data() -> value_type*
+        constexpr auto get_data() -> value_type*
         {
             return _data;
         }
@@ -311,138 +474,218 @@ namespace atom
         }
 
     private:
-        constexpr auto _release_all_mem()
+        /// ----------------------------------------------------------------------------------------
+        /// takes values of `that`, which is left empty. `this` must be empty and own no memory.
+        ///
+        /// if `that` stores its values in its inline buffer, the values are moved into our inline
+        /// buffer, else the allocated memory is stolen.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _take_from(this_type& that) -> void
+        {
+            if (that._is_using_buf())
+            {
+                _data = _buf.get_data();
+                _capacity = in_buf_size;
+                _relocate_to(that._data, that._count, _data);
+                _count = that._count;
+            }
+            else
+            {
+                _data = that._data;
+                _count = that._count;
+                _capacity = that._capacity;
+                _allocator = move(that._allocator);
+            }
+
+            that._data = nullptr;
+            that._count = 0;
+            that._capacity = 0;
+        }
+
+        constexpr auto _is_using_buf() const -> bool
         {
-            _allocator.dealloc(_data);
+            if constexpr (in_buf_size == 0)
+                return false;
+            else
+                return _data != nullptr and _data == _buf.get_data();
         }
 
-        template <typename... arg_types>
-        constexpr auto _emplace_at(usize index, arg_types&&... args) -> usize
+        constexpr auto _alloc_mem(usize count) -> value_type*
         {
-            _ensure_space_at(index, 1);
-            _construct_at(index, forward<arg_types>(args)...);
-            _count += 1;
+            return static_cast<value_type*>(_allocator.alloc(count * sizeof(value_type)));
+        }
 
-            return index;
+        constexpr auto _release_mem() -> void
+        {
+            if (_data != nullptr and not _is_using_buf())
+                _allocator.dealloc(_data);
         }
 
         template <typename other_iterator_type>
         constexpr auto _insert_range_at_counted(
-            usize index, other_iterator_type it, usize count) -> usize
+            usize index, other_iterator_type it, usize count) -> void
         {
             if (count == 0)
-                return index;
-
-            _ensure_space_at(count);
+                return;
 
-            for (usize i = 0; i < count; i++)
+            // the range is inside this array, read it from where the values are moved to.
+            if (usize src = _get_index_for_aliased(it); src != nums::get_max_usize())
             {
-                _construct_at(index + i, it.value());
-                it.next();
-            }
+                _ensure_space_at(index, count);
 
-            _count += count;
-            return index;
-        }
+                for (usize i = 0; i < count; i++)
+                {
+                    usize src_index = src + i < index ? src + i : src + i + count;
+                    _construct_at(index + i, _data[src_index]);
+                }
 
-        // todo: improve performance.
-        constexpr auto _ensure_space_first(usize count) -> void
-        {
-            _ensure_space_at(0, count);
-        }
+                _count += count;
+                return;
+            }
 
-        // todo: improve performance.
-        constexpr auto _ensure_space_at(usize index, usize count) -> void
-        {
-            _ensure_cap_for(count);
+            _ensure_space_at(index, count);
 
-            if (_count != 0)
-                _shift_range_last(index, count);
-        }
+            for (usize i = 0; i < count; i++)
+            {
+                _construct_at(index + i, *it);
+                ++it;
+            }
 
-        // todo: improve performance.
-        constexpr auto _ensure_space_last(usize count) -> void
-        {
-            _ensure_cap_for(count);
+            _count += count;
         }
 
-        // unchecked
         template <typename other_iterator_type, typename other_iterator_end_type>
         constexpr auto _insert_range_at_uncounted(
             usize index, other_iterator_type it, other_iterator_end_type it_end) -> usize
         {
-            usize rotate_size = _count - index;
-            _insert_range_last_uncounted(move(it), move(it_end));
-            _rotate_range_last(index, rotate_size);
+            usize count = _insert_range_last_uncounted(move(it), move(it_end));
+            std::rotate(_data + index, _data + _count - count, _data + _count);
 
-            return index;
+            return count;
         }
 
         template <typename other_iterator_type>
-        constexpr auto _insert_range_last_counted(other_iterator_type it, usize count)
+        constexpr auto _insert_range_last_counted(other_iterator_type it, usize count) -> void
         {
             if (count == 0)
                 return;
 
-            _ensure_space_last(count);
+            // the range is inside this array, read it from where the values are moved to.
+            if (usize src = _get_index_for_aliased(it); src != nums::get_max_usize())
+            {
+                _ensure_cap_for(_count + count);
+
+                for (usize i = 0; i < count; i++)
+                    _construct_at(_count + i, _data[src + i]);
+
+                _count += count;
+                return;
+            }
+
+            _ensure_cap_for(_count + count);
 
             for (usize i = 0; i < count; i++)
             {
-                _construct_at(_count + i, it.value());
-                it.next();
+                _construct_at(_count + i, *it);
+                ++it;
             }
 
             _count += count;
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// \returns index of the value `it` points to, if it points into this array. else
+        /// `nums::get_max_usize()`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_iterator_type>
+        constexpr auto _get_index_for_aliased(const other_iterator_type& it) const -> usize
+        {
+            if constexpr (std::is_convertible_v<other_iterator_type, const value_type*>)
+            {
+                const value_type* ptr = it;
+                std::less<const value_type*> less;
+                if (not less(ptr, _data) and less(ptr, _data + _count))
+                    return usize(ptr - _data);
+            }
+
+            return nums::get_max_usize();
+        }
+
         template <typename other_iterator_type, typename other_iterator_end_type>
         constexpr auto _insert_range_last_uncounted(
             other_iterator_type it, other_iterator_end_type it_end) -> usize
         {
             usize count = 0;
-            while (it != it_end)
+            for (; it != it_end; ++it)
             {
-                _ensure_space_last(1);
-                _construct_at(_count + count, it.value());
-
-                it.next();
+                _ensure_cap_for(_count + 1);
+                _construct_at(_count, *it);
+                _count++;
                 count++;
             }
 
-            _count += count;
             return count;
         }
 
-        // todo: implement this.
-        constexpr auto _update_iterator_debug_id() {}
+        /// ----------------------------------------------------------------------------------------
+        /// makes space for `count` values at `index`, growing storage if needed. the space is left
+        /// uninitialized, `_count` is not updated.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _ensure_space_at(usize index, usize count) -> void
+        {
+            _ensure_cap_for(_count + count);
+            _relocate_range_last(index, count);
+        }
 
         constexpr auto _calc_cap_growth(usize required) const -> usize
         {
-            const usize max = _count < nums::get_max_usize() / 2 ? _count : nums::get_max_usize();
-            return std::max(max, required);
+            const usize doubled =
+                _capacity < nums::get_max_usize() / 2 ? _capacity * 2 : nums::get_max_usize();
+            return std::max(doubled, required);
         }
 
-        constexpr auto _ensure_cap_for(usize count)
+        constexpr auto _ensure_cap_for(usize required) -> void
         {
             // we have enough capacity.
-            if (_capacity - _count >= count)
+            if (required <= _capacity)
                 return;
 
-            _update_iterator_debug_id();
-
-            usize new_cap = _calc_cap_growth(count);
-            value_type* new_data = (value_type*)_allocator.alloc(new_cap);
-
-            if (_count != 0)
+            // nothing to move, start with the inline buffer.
+            if constexpr (in_buf_size != 0)
             {
-                _move_range_to(0, new_data);
+                if (_data == nullptr and required <= in_buf_size)
+                {
+                    _data = _buf.get_data();
+                    _capacity = in_buf_size;
+                    return;
+                }
             }
 
-            if (_data != nullptr)
+            _realloc_mem(_calc_cap_growth(required));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves values into allocated memory of `new_cap` capacity. `new_cap` must be greater
+        /// than or equal to `_count`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _realloc_mem(usize new_cap) -> void
+        {
+            if constexpr (value_type_info::is_trivially_relocatable())
             {
-                _allocator.dealloc(_data);
+                if (_data != nullptr and not _is_using_buf())
+                {
+                    _data = static_cast<value_type*>(
+                        _allocator.realloc(_data, new_cap * sizeof(value_type)));
+                    _capacity = new_cap;
+                    return;
+                }
             }
 
+            value_type* new_data = _alloc_mem(new_cap);
+
+            _relocate_to(_data, _count, new_data);
+            _release_mem();
+
             _data = new_data;
             _capacity = new_cap;
         }
@@ -450,59 +693,72 @@ namespace atom
         template <typename... arg_types>
         constexpr auto _construct_at(usize index, arg_types&&... args) -> void
         {
-            value_type* src = _data + index;
-            std::construct_at(src, forward<arg_types>(args)...);
-        }
-
-        constexpr auto _destruct_at(usize index) -> void
-        {
-            value_type* src = _data + index;
-            std::destroy_at(src);
+            std::construct_at(_data + index, forward<arg_types>(args)...);
         }
 
         constexpr auto _destruct_range(usize index, usize count) -> void
         {
-            value_type* begin = _data + index;
-            value_type* end = begin + count;
-            std::destroy(begin, end);
+            if constexpr (not value_type_info::is_trivially_destructible())
+                std::destroy(_data + index, _data + index + count);
         }
 
         constexpr auto _destruct_all() -> void
         {
-            value_type* begin = _data;
-            value_type* end = _data + _count;
-            std::destroy(begin, end);
+            _destruct_range(0, _count);
         }
 
-        constexpr auto _shift_range_first(usize index, usize steps) -> void
+        /// ----------------------------------------------------------------------------------------
+        /// moves `count` values from `src` into uninitialized memory `dest`, destroying values in
+        /// `src`. handles overlapping memory when `dest < src`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto _relocate_to(value_type* src, usize count, value_type* dest) -> void
         {
-            value_type* begin = _data + index;
-            value_type* end = _data + _count;
-            value_type* dest = begin - steps;
-            std::move(begin, end, dest);
-        }
+            if (count == 0)
+                return;
 
-        constexpr auto _shift_range_last(usize index, usize steps) -> void
-        {
-            value_type* begin = _data + index;
-            value_type* end = _data + _count;
-            value_type* dest = begin + steps;
-            std::move_backward(begin, end, dest);
+            if constexpr (value_type_info::is_trivially_relocatable())
+            {
+                std::memmove(dest, src, count * sizeof(value_type));
+            }
+            else
+            {
+                for (usize i = 0; i < count; i++)
+                {
+                    std::construct_at(dest + i, move(src[i]));
+                    std::destroy_at(src + i);
+                }
+            }
         }
 
-        constexpr auto _rotate_range_last(usize index, usize count) -> void
+        /// ----------------------------------------------------------------------------------------
+        /// moves values in range `[index, _count)` `steps` places to the right, leaving a gap of
+        /// `steps` uninitialized values at `index`. there must be enough capacity.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _relocate_range_last(usize index, usize steps) -> void
         {
-            value_type* begin = _data;
-            value_type* mid = begin + index;
-            value_type* end = begin + _count;
-            std::rotate(begin, mid, end);
+            if constexpr (value_type_info::is_trivially_relocatable())
+            {
+                if (index != _count)
+                    std::memmove(_data + index + steps, _data + index,
+                        (_count - index) * sizeof(value_type));
+            }
+            else
+            {
+                for (usize i = _count; i > index; i--)
+                {
+                    std::construct_at(_data + i - 1 + steps, move(_data[i - 1]));
+                    std::destroy_at(_data + i - 1);
+                }
+            }
         }
 
-        constexpr auto _move_range_to(usize index, value_type* dest) -> void
+        /// ----------------------------------------------------------------------------------------
+        /// moves values in range `[index, _count)` `steps` places to the left, into the gap of
+        /// uninitialized values.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _relocate_range_first(usize index, usize steps) -> void
         {
-            value_type* begin = _data + index;
-            value_type* end = _data + _count;
-            std::move(begin, end, dest);
+            _relocate_to(_data + index, _count - index, _data + index - steps);
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
@@ -516,17 +772,21 @@ namespace atom
         static constexpr auto _get_range_size(
             other_iterator_type it, other_iterator_end_type it_end) -> usize
         {
+            // views like `map_view` over arrays can't be random access, but still know their size.
             if constexpr (ranges::const_random_access_iterator_pair_concept<other_iterator_type,
-                              other_iterator_end_type>)
+                              other_iterator_end_type>
+                          or std::sized_sentinel_for<other_iterator_end_type, other_iterator_type>)
             {
-                return it - it_end;
+                return it_end - it;
             }
+            else
+            {
+                usize count = 0;
+                for (; it != it_end; ++it)
+                    count++;
 
-            usize count = 0;
-            for (; it != it_end; it++)
-                count++;
-
-            return count;
+                return count;
+            }
         }
 
     private:
@@ -534,5 +794,6 @@ namespace atom
         usize _count;
         usize _capacity;
         allocator_type _allocator;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS _dynamic_array_buf<value_type, in_buf_size> _buf;
     };
 }
@@ -0,0 +1,444 @@
+export module atom_core:containers.enum_map;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :containers.enum_set;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// storage for one value of `enum_map`, constructed only when the key is present.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    union _enum_map_slot
+    {
+    public:
+        constexpr _enum_map_slot() {}
+
+        constexpr ~_enum_map_slot() {}
+
+    public:
+        value_type value;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// key and reference to value, yielded by iterators of `enum_map`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_enum_type, typename in_value_type>
+    class enum_map_entry
+    {
+    public:
+        using enum_type = in_enum_type;
+        using value_type = in_value_type;
+
+    public:
+        constexpr enum_map_entry(enum_type key, value_type& value)
+            : _key{ key }
+            , _value{ &value }
+        {}
+
+    public:
+        constexpr auto get_key() const -> enum_type
+        {
+            return _key;
+        }
+
+        constexpr auto get_value() const -> value_type&
+        {
+            return *_value;
+        }
+
+    private:
+        enum_type _key;
+        value_type* _value;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// forward iterator over the entries of `enum_map`, in the order of enumerators.
+    /// --------------------------------------------------------------------------------------------
+    template <typename enum_type, typename map_value_type, typename slot_type, typename bits_type>
+    class _enum_map_iterator
+    {
+        using this_type = _enum_map_iterator;
+        using slot_ptr_type = std::conditional_t<type_info<map_value_type>::is_const(),
+            const slot_type*, slot_type*>;
+
+    public:
+        using value_type = enum_map_entry<enum_type, map_value_type>;
+        using difference_type = isize;
+        using iterator_category = std::forward_iterator_tag;
+
+    public:
+        constexpr _enum_map_iterator()
+            : _bits{ nullptr }
+            , _slots{ nullptr }
+            , _index{ bits_type::bit_count }
+        {}
+
+        constexpr _enum_map_iterator(const bits_type* bits, slot_ptr_type slots, usize index)
+            : _bits{ bits }
+            , _slots{ slots }
+            , _index{ bits->find_next(index) }
+        {}
+
+    public:
+        constexpr auto operator*() const -> value_type
+        {
+            return value_type{ enums::from_index_unchecked<enum_type>(_index),
+                _slots[_index].value };
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _index = _bits->find_next(_index + 1);
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _index == that._index;
+        }
+
+    private:
+        const bits_type* _bits;
+        slot_ptr_type _slots;
+        usize _index;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export class enum_map_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// map from values of `enum_type` to `value_type`, storing a slot for each enumerator inline
+    /// and indexed by `enums::to_index()`. lookups don't hash or probe, and the map never
+    /// allocates.
+    ///
+    /// for flag enums, keys are single flags.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_enum_type, typename in_value_type>
+        requires enums::is_enum<in_enum_type>
+    class enum_map: public enum_map_tag
+    {
+        static_assert(type_info<in_value_type>::is_pure(), "enum_map does not non pure values.");
+
+    private:
+        using this_type = enum_map;
+        using slot_type = _enum_map_slot<in_value_type>;
+        using bits_type = _enum_bits<enums::get_count<in_enum_type>()>;
+
+        static constexpr usize _slot_count = enums::get_count<in_enum_type>();
+
+    public:
+        using key_type = in_enum_type;
+        using mapped_type = in_value_type;
+        using value_type = enum_map_entry<key_type, mapped_type>;
+        using iterator_type = _enum_map_iterator<key_type, mapped_type, slot_type, bits_type>;
+        using iterator_end_type = iterator_type;
+        using const_iterator_type =
+            _enum_map_iterator<key_type, const mapped_type, slot_type, bits_type>;
+        using const_iterator_end_type = const_iterator_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// initializes with no entries.
+        /// ----------------------------------------------------------------------------------------
+        constexpr enum_map()
+            : _bits{}
+            , _slots{}
+        {}
+
+        constexpr enum_map(const this_type& that)
+            : _bits{ that._bits }
+            , _slots{}
+        {
+            for (usize i = _bits.find_next(0); i < _slot_count; i = _bits.find_next(i + 1))
+                std::construct_at(&_slots[i].value, that._slots[i].value);
+        }
+
+        constexpr enum_map& operator=(const this_type& that)
+        {
+            if (this == &that)
+                return *this;
+
+            remove_all();
+            for (usize i = that._bits.find_next(0); i < _slot_count;
+                 i = that._bits.find_next(i + 1))
+            {
+                std::construct_at(&_slots[i].value, that._slots[i].value);
+            }
+
+            _bits = that._bits;
+            return *this;
+        }
+
+        constexpr enum_map(this_type&& that)
+            : _bits{ that._bits }
+            , _slots{}
+        {
+            for (usize i = _bits.find_next(0); i < _slot_count; i = _bits.find_next(i + 1))
+                std::construct_at(&_slots[i].value, move(that._slots[i].value));
+
+            that.remove_all();
+        }
+
+        constexpr enum_map& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            remove_all();
+            for (usize i = that._bits.find_next(0); i < _slot_count;
+                 i = that._bits.find_next(i + 1))
+            {
+                std::construct_at(&_slots[i].value, move(that._slots[i].value));
+            }
+
+            _bits = that._bits;
+            that.remove_all();
+            return *this;
+        }
+
+        constexpr ~enum_map()
+        {
+            remove_all();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if there is an entry with key `key`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto contains(key_type key) const -> bool
+        {
+            const usize index = enums::to_index(key);
+            return index < _slot_count and _bits.test(index);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns reference to value of entry with key `key`.
+        ///
+        /// \pre if debug `contains(key)`: key not found.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_value(key_type key) -> mapped_type&
+        {
+            contract_debug_expects(contains(key), "key not found.");
+
+            return _slots[enums::to_index(key)].value;
+        }
+
+        /// \copydoc get_value
+        constexpr auto get_value(key_type key) const -> const mapped_type&
+        {
+            contract_debug_expects(contains(key), "key not found.");
+
+            return _slots[enums::to_index(key)].value;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts entry with key `key` and value constructed with `args`, if there is no entry
+        /// with key `key`. else does nothing, `args` are not used.
+        ///
+        /// \returns `true` if entry was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        constexpr auto emplace(key_type key, arg_types&&... args) -> bool
+            requires(type_info<mapped_type>::template is_constructible_from<arg_types...>())
+        {
+            const usize index = _get_index(key);
+            if (_bits.test(index))
+                return false;
+
+            std::construct_at(&_slots[index].value, forward<arg_types>(args)...);
+            _bits.set(index);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts entry with key `key` and value `value`, if there is no entry with key `key`.
+        /// else assigns `value` to the entry's value.
+        ///
+        /// \returns `true` if entry was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_arg_type>
+        constexpr auto insert_or_assign(key_type key, value_arg_type&& value) -> bool
+            requires(type_info<mapped_type>::template is_constructible_from<value_arg_type>())
+        {
+            const usize index = _get_index(key);
+            if (_bits.test(index))
+            {
+                _slots[index].value = forward<value_arg_type>(value);
+                return false;
+            }
+
+            std::construct_at(&_slots[index].value, forward<value_arg_type>(value));
+            _bits.set(index);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns reference to value of entry with key `key`. if there is no such entry, inserts
+        /// one with default constructed value.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_or_emplace(key_type key) -> mapped_type&
+            requires(type_info<mapped_type>::is_default_constructible())
+        {
+            const usize index = _get_index(key);
+            if (not _bits.test(index))
+            {
+                std::construct_at(&_slots[index].value);
+                _bits.set(index);
+            }
+
+            return _slots[index].value;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes entry with key `key`.
+        ///
+        /// \returns `true` if an entry was removed.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove(key_type key) -> bool
+        {
+            if (not contains(key))
+                return false;
+
+            const usize index = enums::to_index(key);
+            std::destroy_at(&_slots[index].value);
+            _bits.unset(index);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all entries.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove_all() -> void
+        {
+            if constexpr (not type_info<mapped_type>::is_trivially_destructible())
+            {
+                for (usize i = _bits.find_next(0); i < _slot_count; i = _bits.find_next(i + 1))
+                    std::destroy_at(&_slots[i].value);
+            }
+
+            _bits.unset_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of entries.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_count() const -> usize
+        {
+            return _bits.get_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of enumerators, which is the max count of entries.
+        /// ----------------------------------------------------------------------------------------
+        static consteval auto get_capacity() -> usize
+        {
+            return _slot_count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `get_count() == 0`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto is_empty() const -> bool
+        {
+            return _bits.is_empty();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first entry.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator() -> iterator_type
+        {
+            return iterator_type{ &_bits, _slots, 0 };
+        }
+
+        /// \copydoc get_iterator
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ &_bits, _slots, 0 };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to next of the last entry.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator_end() -> iterator_end_type
+        {
+            return iterator_end_type{};
+        }
+
+        /// \copydoc get_iterator_end
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{};
+        }
+
+    private:
+        constexpr auto _get_index(key_type key) const -> usize
+        {
+            const usize index = enums::to_index(key);
+            contract_debug_expects(index < _slot_count, "key is not an enumerator.");
+
+            return index;
+        }
+
+    private:
+        bits_type _bits;
+        slot_type _slots[_slot_count == 0 ? 1 : _slot_count];
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<enum_map_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+        using iterator_type = typename range_type::iterator_type;
+        using iterator_end_type = typename range_type::iterator_end_type;
+
+    public:
+        static constexpr auto get_iterator(range_type& range) -> iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_iterator_end(range_type& range) -> iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
@@ -0,0 +1,404 @@
+export module atom_core:containers.enum_set;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// fixed count of bits stored inline in words, used by `enum_set` and `enum_map`.
+    /// --------------------------------------------------------------------------------------------
+    template <usize in_bit_count>
+    class _enum_bits
+    {
+        using this_type = _enum_bits;
+
+    public:
+        static constexpr usize bit_count = in_bit_count;
+        static constexpr usize word_count = bit_count == 0 ? 1 : (bit_count + 63) / 64;
+
+    public:
+        constexpr auto set(usize index) -> void
+        {
+            _words[index / 64] |= u64(1) << (index % 64);
+        }
+
+        constexpr auto unset(usize index) -> void
+        {
+            _words[index / 64] &= ~(u64(1) << (index % 64));
+        }
+
+        constexpr auto test(usize index) const -> bool
+        {
+            return (_words[index / 64] >> (index % 64)) & 1;
+        }
+
+        constexpr auto unset_all() -> void
+        {
+            for (usize i = 0; i < word_count; i++)
+                _words[i] = 0;
+        }
+
+        constexpr auto get_count() const -> usize
+        {
+            usize count = 0;
+            for (usize i = 0; i < word_count; i++)
+                count += std::popcount(_words[i]);
+
+            return count;
+        }
+
+        constexpr auto is_empty() const -> bool
+        {
+            for (usize i = 0; i < word_count; i++)
+            {
+                if (_words[i] != 0)
+                    return false;
+            }
+
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns index of the first set bit at or after `index`, or `bit_count` if none.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto find_next(usize index) const -> usize
+        {
+            if (index >= bit_count)
+                return bit_count;
+
+            usize word_index = index / 64;
+            u64 word = _words[word_index] & (~u64(0) << (index % 64));
+
+            while (word == 0)
+            {
+                if (++word_index == word_count)
+                    return bit_count;
+
+                word = _words[word_index];
+            }
+
+            return word_index * 64 + std::countr_zero(word);
+        }
+
+        constexpr auto get_word(usize index) const -> u64
+        {
+            return _words[index];
+        }
+
+        constexpr auto set_word(usize index, u64 word) -> void
+        {
+            _words[index] = word;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool = default;
+
+    private:
+        u64 _words[word_count] = {};
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// maps the values of `enum_type` to bits of `enum_set`.
+    ///
+    /// each enumerator uses the bit at its index, except for flags where the bits are the same
+    /// as the underlying value, so converting from and to flags is a copy.
+    /// --------------------------------------------------------------------------------------------
+    template <typename enum_type>
+    class _enum_set_policy
+    {
+    public:
+        static constexpr bool is_flags = enums::is_flags<enum_type>;
+        using underlying_type = std::make_unsigned_t<enums::get_underlying_type<enum_type>>;
+
+        static constexpr usize bit_count =
+            is_flags ? sizeof(underlying_type) * 8 : enums::get_count<enum_type>();
+
+        using bits_type = _enum_bits<bit_count>;
+
+    public:
+        static constexpr auto to_bits(enum_type value) -> bits_type
+        {
+            bits_type bits;
+            if constexpr (is_flags)
+            {
+                bits.set_word(0, u64(underlying_type(value)));
+            }
+            else
+            {
+                const usize index = enums::to_index(value);
+                contract_debug_expects(index < bit_count, "value is not an enumerator.");
+
+                bits.set(index);
+            }
+
+            return bits;
+        }
+
+        static constexpr auto from_bit(usize index) -> enum_type
+        {
+            if constexpr (is_flags)
+                return enum_type(underlying_type(underlying_type(1) << index));
+            else
+                return enums::from_index_unchecked<enum_type>(index);
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// forward iterator over the values of `enum_set`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename enum_type>
+    class _enum_set_iterator
+    {
+        using this_type = _enum_set_iterator;
+        using policy_type = _enum_set_policy<enum_type>;
+        using bits_type = typename policy_type::bits_type;
+
+    public:
+        using value_type = enum_type;
+        using difference_type = isize;
+        using iterator_category = std::forward_iterator_tag;
+
+    public:
+        constexpr _enum_set_iterator()
+            : _bits{ nullptr }
+            , _index{ policy_type::bit_count }
+            , _value{}
+        {}
+
+        constexpr _enum_set_iterator(const bits_type* bits, usize index)
+            : _bits{ bits }
+            , _index{ bits->find_next(index) }
+            , _value{}
+        {
+            _update_value();
+        }
+
+    public:
+        constexpr auto operator*() const -> const enum_type&
+        {
+            return _value;
+        }
+
+        constexpr auto operator->() const -> const enum_type*
+        {
+            return &_value;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _index = _bits->find_next(_index + 1);
+            _update_value();
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _index == that._index;
+        }
+
+    private:
+        constexpr auto _update_value() -> void
+        {
+            if (_index != policy_type::bit_count)
+                _value = policy_type::from_bit(_index);
+        }
+
+    private:
+        const bits_type* _bits;
+        usize _index;
+        enum_type _value;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export class enum_set_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// set of values of `enum_type`, stored inline as one bit per enumerator.
+    ///
+    /// for flag enums, the bits are the same as the underlying value. inserting a value inserts
+    /// each of its flags, and the set converts from and to a flags value without a loop.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_enum_type>
+        requires enums::is_enum<in_enum_type>
+    class enum_set: public enum_set_tag
+    {
+        using this_type = enum_set;
+        using policy_type = _enum_set_policy<in_enum_type>;
+        using bits_type = typename policy_type::bits_type;
+
+    public:
+        using enum_type = in_enum_type;
+        using value_type = in_enum_type;
+        using const_iterator_type = _enum_set_iterator<enum_type>;
+        using const_iterator_end_type = const_iterator_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// initializes with no values.
+        /// ----------------------------------------------------------------------------------------
+        constexpr enum_set()
+            : _bits{}
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with `values`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr enum_set(std::initializer_list<enum_type> values)
+            : _bits{}
+        {
+            for (enum_type value : values)
+                insert(value);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with each flag set in `flags`.
+        /// ----------------------------------------------------------------------------------------
+        explicit constexpr enum_set(enum_type flags)
+            requires enums::is_flags<enum_type>
+            : _bits{ policy_type::to_bits(flags) }
+        {}
+
+        constexpr enum_set(const this_type& that) = default;
+        constexpr enum_set& operator=(const this_type& that) = default;
+        constexpr ~enum_set() = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `value`, or each flag of `value` for flag enums.
+        ///
+        /// \pre if debug and not flags, `value` is an enumerator.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto insert(enum_type value) -> void
+        {
+            const bits_type bits = policy_type::to_bits(value);
+            for (usize i = 0; i < bits_type::word_count; i++)
+                _bits.set_word(i, _bits.get_word(i) | bits.get_word(i));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes `value`, or each flag of `value` for flag enums.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove(enum_type value) -> void
+        {
+            const bits_type bits = policy_type::to_bits(value);
+            for (usize i = 0; i < bits_type::word_count; i++)
+                _bits.set_word(i, _bits.get_word(i) & ~bits.get_word(i));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `value` is in the set, or all flags of `value` for flag enums.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto contains(enum_type value) const -> bool
+        {
+            const bits_type bits = policy_type::to_bits(value);
+            for (usize i = 0; i < bits_type::word_count; i++)
+            {
+                if ((_bits.get_word(i) & bits.get_word(i)) != bits.get_word(i))
+                    return false;
+            }
+
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all values.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove_all() -> void
+        {
+            _bits.unset_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of values, or of flags for flag enums.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_count() const -> usize
+        {
+            return _bits.get_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `get_count() == 0`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto is_empty() const -> bool
+        {
+            return _bits.is_empty();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns all the flags in the set combined into one value.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto to_flags() const -> enum_type
+            requires enums::is_flags<enum_type>
+        {
+            using underlying_type = typename policy_type::underlying_type;
+            return enum_type(underlying_type(_bits.get_word(0)));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first value, in the order of enumerators or of flag bits.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ &_bits, 0 };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to next of the last value.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{};
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _bits == that._bits;
+        }
+
+    private:
+        bits_type _bits;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<enum_set_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+
+    public:
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
@@ -0,0 +1,382 @@
+export module atom_core:containers.flat_hash_map;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.flat_hash_table;
+
+namespace atom
+{
+    export class flat_hash_map_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// key value pair stored in `flat_hash_map`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_key_type, typename in_value_type>
+    class flat_hash_map_entry
+    {
+    public:
+        using key_type = in_key_type;
+        using value_type = in_value_type;
+
+    public:
+        template <typename key_arg_type, typename... arg_types>
+        constexpr flat_hash_map_entry(key_arg_type&& key, arg_types&&... args)
+            : _key(forward<key_arg_type>(key))
+            , _value(forward<arg_types>(args)...)
+        {}
+
+    public:
+        constexpr auto get_key() const -> const key_type&
+        {
+            return _key;
+        }
+
+        constexpr auto get_value() const -> const value_type&
+        {
+            return _value;
+        }
+
+        constexpr auto get_value() -> value_type&
+        {
+            return _value;
+        }
+
+    private:
+        key_type _key;
+        value_type _value;
+    };
+
+    template <typename key_type, typename value_type>
+    class _flat_hash_map_policy
+    {
+    public:
+        static constexpr auto get_key(const flat_hash_map_entry<key_type, value_type>& entry)
+            -> const key_type&
+        {
+            return entry.get_key();
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// hash map using open addressing, storing entries inline in a single allocation.
+    ///
+    /// lookups accept any key type that `hasher_type` and `key_eq_type` accept, so a map keyed by
+    /// `string` can be queried with a `string_view`.
+    ///
+    /// \note all iterators are invalidated when an entry is inserted.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_key_type, typename in_value_type,
+        typename in_hasher_type = flat_hash_default_hasher,
+        typename in_key_eq_type = flat_hash_default_key_eq,
+        typename in_allocator_type = default_mem_allocator>
+    class flat_hash_map: public flat_hash_map_tag
+    {
+        static_assert(type_info<in_key_type>::is_pure(), "flat_hash_map does not non pure keys.");
+        static_assert(
+            type_info<in_value_type>::is_pure(), "flat_hash_map does not non pure values.");
+
+    private:
+        using this_type = flat_hash_map;
+        using table_type = _flat_hash_table<flat_hash_map_entry<in_key_type, in_value_type>,
+            _flat_hash_map_policy<in_key_type, in_value_type>, in_hasher_type, in_key_eq_type,
+            in_allocator_type>;
+
+    public:
+        using key_type = in_key_type;
+        using value_type = flat_hash_map_entry<in_key_type, in_value_type>;
+        using mapped_type = in_value_type;
+        using hasher_type = in_hasher_type;
+        using key_eq_type = in_key_eq_type;
+        using allocator_type = in_allocator_type;
+        using iterator_type = typename table_type::iterator_type;
+        using iterator_end_type = iterator_type;
+        using const_iterator_type = typename table_type::const_iterator_type;
+        using const_iterator_end_type = const_iterator_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with nothing, without allocating.
+        /// ----------------------------------------------------------------------------------------
+        constexpr flat_hash_map()
+            : _table{}
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with capacity to store `count` entries without growing.
+        /// ----------------------------------------------------------------------------------------
+        constexpr flat_hash_map(create_with_capacity_tag, usize count)
+            : _table{}
+        {
+            _table.reserve(count);
+        }
+
+        constexpr flat_hash_map(const flat_hash_map& that) = default;
+        constexpr flat_hash_map& operator=(const flat_hash_map& that) = default;
+        constexpr flat_hash_map(flat_hash_map&& that) = default;
+        constexpr flat_hash_map& operator=(flat_hash_map&& that) = default;
+        constexpr ~flat_hash_map() = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to entry with key equal to `key`, or `get_iterator_end()` if not
+        /// found.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto find(const other_key_type& key) -> iterator_type
+        {
+            return _table.get_iterator_at(_table.find_index(key));
+        }
+
+        /// \copydoc find
+        template <typename other_key_type>
+        constexpr auto find(const other_key_type& key) const -> const_iterator_type
+        {
+            return _table.get_iterator_at(_table.find_index(key));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if there is an entry with key equal to `key`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto contains(const other_key_type& key) const -> bool
+        {
+            return _table.find_index(key) != _table.get_capacity();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns reference to value of entry with key equal to `key`.
+        ///
+        /// \pre if debug `contains(key)`: key not found.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto get_value(const other_key_type& key) -> mapped_type&
+        {
+            usize index = _table.find_index(key);
+            contract_debug_expects(index != _table.get_capacity(), "key not found.");
+
+            return _table.get_slot_at(index).get_value();
+        }
+
+        /// \copydoc get_value
+        template <typename other_key_type>
+        constexpr auto get_value(const other_key_type& key) const -> const mapped_type&
+        {
+            usize index = _table.find_index(key);
+            contract_debug_expects(index != _table.get_capacity(), "key not found.");
+
+            return _table.get_slot_at(index).get_value();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts entry with key `key` and value constructed with `args`, if there is no entry
+        /// with key equal to `key`. else does nothing, `args` are not used.
+        ///
+        /// \returns `true` if entry was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_arg_type, typename... arg_types>
+        constexpr auto emplace(key_arg_type&& key, arg_types&&... args) -> bool
+            requires(type_info<key_type>::template is_constructible_from<key_arg_type>()
+                     and type_info<mapped_type>::template is_constructible_from<arg_types...>())
+        {
+            auto result = _table.find_or_prepare_insert(key);
+            if (result.is_new)
+            {
+                _table.construct_at(
+                    result, forward<key_arg_type>(key), forward<arg_types>(args)...);
+            }
+
+            return result.is_new;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts entry with key `key` and value `value`, if there is no entry with key equal to
+        /// `key`. else assigns `value` to the entry's value.
+        ///
+        /// \returns `true` if entry was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_arg_type, typename value_arg_type>
+        constexpr auto insert_or_assign(key_arg_type&& key, value_arg_type&& value) -> bool
+            requires(type_info<key_type>::template is_constructible_from<key_arg_type>()
+                     and type_info<mapped_type>::template is_constructible_from<value_arg_type>())
+        {
+            auto result = _table.find_or_prepare_insert(key);
+            if (result.is_new)
+            {
+                _table.construct_at(
+                    result, forward<key_arg_type>(key), forward<value_arg_type>(value));
+            }
+            else
+            {
+                _table.get_slot_at(result.index).get_value() = forward<value_arg_type>(value);
+            }
+
+            return result.is_new;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns reference to value of entry with key equal to `key`. if there is no such entry,
+        /// inserts one with default constructed value.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_arg_type>
+        constexpr auto get_or_emplace(key_arg_type&& key) -> mapped_type&
+            requires(type_info<key_type>::template is_constructible_from<key_arg_type>()
+                     and type_info<mapped_type>::is_default_constructible())
+        {
+            auto result = _table.find_or_prepare_insert(key);
+            if (result.is_new)
+                _table.construct_at(result, forward<key_arg_type>(key));
+
+            return _table.get_slot_at(result.index).get_value();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes entry with key equal to `key`.
+        ///
+        /// \returns `true` if an entry was removed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto remove(const other_key_type& key) -> bool
+        {
+            usize index = _table.find_index(key);
+            if (index == _table.get_capacity())
+                return false;
+
+            _table.remove_at(index);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes entry referenced by `it`.
+        ///
+        /// \returns iterator to the next entry.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove_at(const_iterator_type it) -> iterator_type
+        {
+            contract_debug_expects(it != get_iterator_end(), "iterator is out of range.");
+
+            usize index = _table.get_index_for_iterator(it);
+            _table.remove_at(index);
+            return _table.get_iterator_at(index);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all entries.
+        ///
+        /// \note does not free storage.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove_all() -> void
+        {
+            _table.remove_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reserves memory to store `count` entries without growing.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto reserve(usize count) -> void
+        {
+            _table.reserve(count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of entries.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_count() const -> usize
+        {
+            return _table.get_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of slots, filled or empty.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_capacity() const -> usize
+        {
+            return _table.get_capacity();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `get_count() == 0`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto is_empty() const -> bool
+        {
+            return _table.get_count() == 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first entry.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator() -> iterator_type
+        {
+            return _table.get_iterator();
+        }
+
+        /// \copydoc get_iterator
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return _table.get_iterator();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to next of the last entry.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator_end() -> iterator_end_type
+        {
+            return _table.get_iterator_end();
+        }
+
+        /// \copydoc get_iterator_end
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return _table.get_iterator_end();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns reference to stored allocator.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_allocator() const -> const allocator_type&
+        {
+            return _table.get_allocator();
+        }
+
+    private:
+        table_type _table;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<flat_hash_map_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+        using iterator_type = typename range_type::iterator_type;
+        using iterator_end_type = typename range_type::iterator_end_type;
+
+    public:
+        static constexpr auto get_iterator(range_type& range) -> iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_iterator_end(range_type& range) -> iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
@@ -0,0 +1,233 @@
+export module atom_core:containers.flat_hash_set;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.flat_hash_table;
+
+namespace atom
+{
+    export class flat_hash_set_tag
+    {};
+
+    template <typename key_type>
+    class _flat_hash_set_policy
+    {
+    public:
+        static constexpr auto get_key(const key_type& key) -> const key_type&
+        {
+            return key;
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// hash set using open addressing, storing keys inline in a single allocation.
+    ///
+    /// lookups accept any key type that `hasher_type` and `key_eq_type` accept, so a set of
+    /// `string` can be queried with a `string_view`.
+    ///
+    /// \note all iterators are invalidated when a key is inserted.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_key_type, typename in_hasher_type = flat_hash_default_hasher,
+        typename in_key_eq_type = flat_hash_default_key_eq,
+        typename in_allocator_type = default_mem_allocator>
+    class flat_hash_set: public flat_hash_set_tag
+    {
+        static_assert(type_info<in_key_type>::is_pure(), "flat_hash_set does not non pure keys.");
+
+    private:
+        using this_type = flat_hash_set;
+        using table_type = _flat_hash_table<in_key_type, _flat_hash_set_policy<in_key_type>,
+            in_hasher_type, in_key_eq_type, in_allocator_type>;
+
+    public:
+        using value_type = in_key_type;
+        using hasher_type = in_hasher_type;
+        using key_eq_type = in_key_eq_type;
+        using allocator_type = in_allocator_type;
+        using const_iterator_type = typename table_type::const_iterator_type;
+        using const_iterator_end_type = const_iterator_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with nothing, without allocating.
+        /// ----------------------------------------------------------------------------------------
+        constexpr flat_hash_set()
+            : _table{}
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with capacity to store `count` keys without growing.
+        /// ----------------------------------------------------------------------------------------
+        constexpr flat_hash_set(create_with_capacity_tag, usize count)
+            : _table{}
+        {
+            _table.reserve(count);
+        }
+
+        constexpr flat_hash_set(const flat_hash_set& that) = default;
+        constexpr flat_hash_set& operator=(const flat_hash_set& that) = default;
+        constexpr flat_hash_set(flat_hash_set&& that) = default;
+        constexpr flat_hash_set& operator=(flat_hash_set&& that) = default;
+        constexpr ~flat_hash_set() = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to key equal to `key`, or `get_iterator_end()` if not found.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto find(const other_key_type& key) const -> const_iterator_type
+        {
+            return _table.get_iterator_at(_table.find_index(key));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if there is a key equal to `key`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto contains(const other_key_type& key) const -> bool
+        {
+            return _table.find_index(key) != _table.get_capacity();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `key` if there is no key equal to it.
+        ///
+        /// \returns `true` if key was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_arg_type>
+        constexpr auto insert(key_arg_type&& key) -> bool
+            requires(type_info<value_type>::template is_constructible_from<key_arg_type>())
+        {
+            auto result = _table.find_or_prepare_insert(key);
+            if (result.is_new)
+                _table.construct_at(result, forward<key_arg_type>(key));
+
+            return result.is_new;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes key equal to `key`.
+        ///
+        /// \returns `true` if a key was removed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto remove(const other_key_type& key) -> bool
+        {
+            usize index = _table.find_index(key);
+            if (index == _table.get_capacity())
+                return false;
+
+            _table.remove_at(index);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes key referenced by `it`.
+        ///
+        /// \returns iterator to the next key.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove_at(const_iterator_type it) -> const_iterator_type
+        {
+            contract_debug_expects(it != get_iterator_end(), "iterator is out of range.");
+
+            usize index = _table.get_index_for_iterator(it);
+            _table.remove_at(index);
+            return static_cast<const table_type&>(_table).get_iterator_at(index);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all keys.
+        ///
+        /// \note does not free storage.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove_all() -> void
+        {
+            _table.remove_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reserves memory to store `count` keys without growing.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto reserve(usize count) -> void
+        {
+            _table.reserve(count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of keys.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_count() const -> usize
+        {
+            return _table.get_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of slots, filled or empty.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_capacity() const -> usize
+        {
+            return _table.get_capacity();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `get_count() == 0`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto is_empty() const -> bool
+        {
+            return _table.get_count() == 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first key.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return _table.get_iterator();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to next of the last key.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return _table.get_iterator_end();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns reference to stored allocator.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_allocator() const -> const allocator_type&
+        {
+            return _table.get_allocator();
+        }
+
+    private:
+        table_type _table;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<flat_hash_set_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+
+    public:
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
@@ -0,0 +1,763 @@
+module;
+#include "atom/core/preprocessors.h"
+
+#if defined(ATOM_SIMD_SSE2) || defined(ATOM_SIMD_AVX2)
+#    include <immintrin.h>
+#endif
+
+export module atom_core:containers.flat_hash_table;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :hash.hasher;
+
+/// ------------------------------------------------------------------------------------------------
+/// open addressing hash table used to implement `flat_hash_map` and `flat_hash_set`.
+///
+/// slots are stored inline in one allocation, along with one control byte per slot. a control
+/// byte is either `empty`, `deleted` or holds 7 bits of the slot's hash. lookups load a group of
+/// control bytes at once and compare all of them against the hash, so only slots which are very
+/// likely to match are compared by key.
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    class _flat_hash_ctrl
+    {
+    public:
+        static constexpr i8 empty = -128;
+        static constexpr i8 deleted = -2;
+
+    public:
+        static constexpr auto is_full(i8 ctrl) -> bool
+        {
+            return ctrl >= 0;
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// set of slots in a group, returned by group matches. each slot takes `1 << shift` bits.
+    /// --------------------------------------------------------------------------------------------
+    template <usize shift>
+    class _flat_hash_bitmask
+    {
+    public:
+        constexpr _flat_hash_bitmask(u64 mask)
+            : _mask{ mask }
+        {}
+
+    public:
+        constexpr auto has_any() const -> bool
+        {
+            return _mask != 0;
+        }
+
+        constexpr auto get_lowest() const -> usize
+        {
+            return usize(std::countr_zero(_mask)) >> shift;
+        }
+
+        constexpr auto remove_lowest() -> void
+        {
+            _mask &= _mask - 1;
+        }
+
+    private:
+        u64 _mask;
+    };
+
+#if defined(ATOM_SIMD_AVX2)
+    class _flat_hash_group
+    {
+    public:
+        static constexpr usize width = 32;
+        using bitmask_type = _flat_hash_bitmask<0>;
+
+    public:
+        explicit _flat_hash_group(const i8* ctrl)
+            : _ctrl{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrl)) }
+        {}
+
+    public:
+        auto match(i8 h2) const -> bitmask_type
+        {
+            return u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), _ctrl)));
+        }
+
+        auto match_empty() const -> bitmask_type
+        {
+            return match(_flat_hash_ctrl::empty);
+        }
+
+        auto match_empty_or_deleted() const -> bitmask_type
+        {
+            return u32(_mm256_movemask_epi8(_ctrl));
+        }
+
+    private:
+        __m256i _ctrl;
+    };
+#elif defined(ATOM_SIMD_SSE2)
+    class _flat_hash_group
+    {
+    public:
+        static constexpr usize width = 16;
+        using bitmask_type = _flat_hash_bitmask<0>;
+
+    public:
+        explicit _flat_hash_group(const i8* ctrl)
+            : _ctrl{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)) }
+        {}
+
+    public:
+        auto match(i8 h2) const -> bitmask_type
+        {
+            return u16(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+        }
+
+        auto match_empty() const -> bitmask_type
+        {
+            return match(_flat_hash_ctrl::empty);
+        }
+
+        auto match_empty_or_deleted() const -> bitmask_type
+        {
+            return u16(_mm_movemask_epi8(_ctrl));
+        }
+
+    private:
+        __m128i _ctrl;
+    };
+#else
+    /// --------------------------------------------------------------------------------------------
+    /// portable group, processes 8 control bytes packed in a `u64`.
+    ///
+    /// \todo support big endian targets.
+    /// --------------------------------------------------------------------------------------------
+    class _flat_hash_group
+    {
+        static constexpr u64 _lsbs = 0x0101010101010101;
+        static constexpr u64 _msbs = 0x8080808080808080;
+
+    public:
+        static constexpr usize width = 8;
+        using bitmask_type = _flat_hash_bitmask<3>;
+
+    public:
+        explicit _flat_hash_group(const i8* ctrl)
+        {
+            std::memcpy(&_ctrl, ctrl, sizeof(_ctrl));
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// may report false positives, which are filtered out by comparing keys.
+        /// ----------------------------------------------------------------------------------------
+        auto match(i8 h2) const -> bitmask_type
+        {
+            u64 x = _ctrl ^ (_lsbs * u8(h2));
+            return (x - _lsbs) & ~x & _msbs;
+        }
+
+        auto match_empty() const -> bitmask_type
+        {
+            return (_ctrl & (~_ctrl << 6)) & _msbs;
+        }
+
+        auto match_empty_or_deleted() const -> bitmask_type
+        {
+            return _ctrl & _msbs;
+        }
+
+    private:
+        u64 _ctrl;
+    };
+#endif
+
+    /// --------------------------------------------------------------------------------------------
+    /// default hasher for flat hash containers, uses `hasher` with the process seed if the key is
+    /// hashable, else `std::hash`. keys of different types that compare equal must hash equal, for
+    /// heterogeneous lookup to work.
+    /// --------------------------------------------------------------------------------------------
+    export class flat_hash_default_hasher
+    {
+    public:
+        template <typename key_type>
+        constexpr auto operator()(const key_type& key) const -> usize
+        {
+            if constexpr (hashable_concept<key_type>)
+                return hasher<key_type>::hash(key, hash::get_seed());
+            else
+                return std::hash<key_type>()(key);
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// default key comparer for flat hash containers. uses `operator==` if available, else
+    /// compares keys as ranges.
+    /// --------------------------------------------------------------------------------------------
+    export class flat_hash_default_key_eq
+    {
+    public:
+        template <typename key_type, typename other_key_type>
+        constexpr auto operator()(const key_type& key, const other_key_type& other) const -> bool
+        {
+            if constexpr (requires { key == other; })
+                return key == other;
+            else
+                return ranges::compare(key, other) == 0;
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// forward iterator over full slots of a flat hash table.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_value_type>
+    class _flat_hash_iterator
+    {
+        using this_type = _flat_hash_iterator;
+
+        template <typename>
+        friend class _flat_hash_iterator;
+
+    public:
+        using value_type = std::remove_cv_t<in_value_type>;
+        using difference_type = isize;
+        using iterator_category = std::forward_iterator_tag;
+
+    public:
+        constexpr _flat_hash_iterator()
+            : _ctrl{ nullptr }
+            , _ctrl_end{ nullptr }
+            , _slot{ nullptr }
+        {}
+
+        constexpr _flat_hash_iterator(const i8* ctrl, const i8* ctrl_end, in_value_type* slot)
+            : _ctrl{ ctrl }
+            , _ctrl_end{ ctrl_end }
+            , _slot{ slot }
+        {
+            _skip_non_full();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// converts mutable iterator to const iterator.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_value_type>
+        constexpr _flat_hash_iterator(const _flat_hash_iterator<other_value_type>& that)
+            requires(type_info<const other_value_type>::template is_same_as<in_value_type>())
+            : _ctrl{ that._ctrl }
+            , _ctrl_end{ that._ctrl_end }
+            , _slot{ that._slot }
+        {}
+
+    public:
+        constexpr auto operator*() const -> in_value_type&
+        {
+            return *_slot;
+        }
+
+        constexpr auto operator->() const -> in_value_type*
+        {
+            return _slot;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            ++_ctrl;
+            ++_slot;
+            _skip_non_full();
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _ctrl == that._ctrl;
+        }
+
+        constexpr auto get_slot() const -> in_value_type*
+        {
+            return _slot;
+        }
+
+    private:
+        constexpr auto _skip_non_full() -> void
+        {
+            while (_ctrl != _ctrl_end and not _flat_hash_ctrl::is_full(*_ctrl))
+            {
+                ++_ctrl;
+                ++_slot;
+            }
+        }
+
+    private:
+        const i8* _ctrl;
+        const i8* _ctrl_end;
+        in_value_type* _slot;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// result of `_flat_hash_table::find_or_prepare_insert()`.
+    /// --------------------------------------------------------------------------------------------
+    class _flat_hash_insert_result
+    {
+    public:
+        usize index;
+        bool is_new;
+
+        // control byte to set once the slot is constructed, if `is_new`.
+        i8 ctrl;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// storage engine for `flat_hash_map` and `flat_hash_set`.
+    ///
+    /// `in_policy_type::get_key(slot)` returns key of a slot. capacity is always `0` or a power of
+    /// two, not less than group width. control bytes are followed by a copy of the first group,
+    /// so a group can be loaded from any slot without wrapping.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_slot_type, typename in_policy_type, typename in_hasher_type,
+        typename in_key_eq_type, typename in_allocator_type>
+    class _flat_hash_table
+    {
+        using this_type = _flat_hash_table;
+        using group_type = _flat_hash_group;
+        using slot_type_info = type_info<in_slot_type>;
+
+    public:
+        using slot_type = in_slot_type;
+        using policy_type = in_policy_type;
+        using hasher_type = in_hasher_type;
+        using key_eq_type = in_key_eq_type;
+        using allocator_type = in_allocator_type;
+        using iterator_type = _flat_hash_iterator<slot_type>;
+        using const_iterator_type = _flat_hash_iterator<const slot_type>;
+
+    public:
+        constexpr _flat_hash_table()
+            : _slots{ nullptr }
+            , _ctrl{ nullptr }
+            , _capacity{ 0 }
+            , _count{ 0 }
+            , _growth_left{ 0 }
+            , _hasher{}
+            , _key_eq{}
+            , _allocator{}
+        {}
+
+        constexpr _flat_hash_table(const this_type& that)
+            : _flat_hash_table{}
+        {
+            _copy_from(that);
+        }
+
+        constexpr _flat_hash_table(this_type&& that)
+            : _flat_hash_table{}
+        {
+            _take_from(that);
+        }
+
+        constexpr auto operator=(const this_type& that) -> this_type&
+        {
+            if (this != &that)
+            {
+                _destroy();
+                _copy_from(that);
+            }
+
+            return *this;
+        }
+
+        constexpr auto operator=(this_type&& that) -> this_type&
+        {
+            if (this != &that)
+            {
+                _destroy();
+                _take_from(that);
+            }
+
+            return *this;
+        }
+
+        constexpr ~_flat_hash_table()
+        {
+            _destroy();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns index of slot with key equal to `key`, or `get_capacity()` if not found.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_type>
+        constexpr auto find_index(const key_type& key) const -> usize
+        {
+            if (_count == 0)
+                return _capacity;
+
+            return _find_index(key, _hash(key));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// finds slot with key equal to `key`. if not found, finds a free slot for it, growing if
+        /// needed. the caller must then call `construct_at()` with a key equal to `key`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_type>
+        constexpr auto find_or_prepare_insert(const key_type& key) -> _flat_hash_insert_result
+        {
+            const u64 hash = _hash(key);
+
+            if (_count != 0)
+            {
+                usize index = _find_index(key, hash);
+                if (index != _capacity)
+                    return { index, false, _ctrl[index] };
+            }
+
+            if (_growth_left == 0)
+                _grow();
+
+            return { _find_first_non_full(hash), true, _get_h2(hash) };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs slot found by `find_or_prepare_insert()` and marks it full. if construction
+        /// throws, the slot is left free.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        constexpr auto construct_at(
+            const _flat_hash_insert_result& result, arg_types&&... args) -> slot_type&
+        {
+            slot_type* slot = std::construct_at(_slots + result.index, forward<arg_types>(args)...);
+
+            if (_ctrl[result.index] == _flat_hash_ctrl::empty)
+                _growth_left--;
+
+            _set_ctrl(result.index, result.ctrl);
+            _count++;
+            return *slot;
+        }
+
+        constexpr auto remove_at(usize index) -> void
+        {
+            std::destroy_at(_slots + index);
+            _set_ctrl(index, _flat_hash_ctrl::deleted);
+            _count--;
+        }
+
+        constexpr auto remove_all() -> void
+        {
+            if (_capacity == 0)
+                return;
+
+            _destruct_all();
+            std::memset(_ctrl, _flat_hash_ctrl::empty, _capacity + group_type::width);
+            _count = 0;
+            _growth_left = _get_max_load(_capacity);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reserves memory to store `count` slots, without growing.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto reserve(usize count) -> void
+        {
+            if (count <= _count + _growth_left)
+                return;
+
+            usize capacity = std::bit_ceil(count + count / 7 + 1);
+            _resize(std::max(capacity, group_type::width));
+        }
+
+        constexpr auto get_slot_at(usize index) -> slot_type&
+        {
+            return _slots[index];
+        }
+
+        constexpr auto get_slot_at(usize index) const -> const slot_type&
+        {
+            return _slots[index];
+        }
+
+        constexpr auto get_index_for_iterator(const_iterator_type it) const -> usize
+        {
+            return it.get_slot() - _slots;
+        }
+
+        constexpr auto get_iterator() -> iterator_type
+        {
+            return iterator_type{ _ctrl, _ctrl + _capacity, _slots };
+        }
+
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ _ctrl, _ctrl + _capacity, _slots };
+        }
+
+        constexpr auto get_iterator_at(usize index) -> iterator_type
+        {
+            return iterator_type{ _ctrl + index, _ctrl + _capacity, _slots + index };
+        }
+
+        constexpr auto get_iterator_at(usize index) const -> const_iterator_type
+        {
+            return const_iterator_type{ _ctrl + index, _ctrl + _capacity, _slots + index };
+        }
+
+        constexpr auto get_iterator_end() -> iterator_type
+        {
+            return get_iterator_at(_capacity);
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_type
+        {
+            return get_iterator_at(_capacity);
+        }
+
+        constexpr auto get_count() const -> usize
+        {
+            return _count;
+        }
+
+        constexpr auto get_capacity() const -> usize
+        {
+            return _capacity;
+        }
+
+        constexpr auto get_allocator() const -> const allocator_type&
+        {
+            return _allocator;
+        }
+
+    private:
+        template <typename key_type>
+        constexpr auto _hash(const key_type& key) const -> u64
+        {
+            // `std::hash` for integers is usually identity, mix the bits so that both parts of
+            // the hash are well distributed.
+            u64 hash = _hasher(key);
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccd;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        static constexpr auto _get_h1(u64 hash) -> usize
+        {
+            return usize(hash >> 7);
+        }
+
+        static constexpr auto _get_h2(u64 hash) -> i8
+        {
+            return i8(hash & 0x7f);
+        }
+
+        static constexpr auto _get_max_load(usize capacity) -> usize
+        {
+            return capacity - capacity / 8;
+        }
+
+        template <typename key_type>
+        constexpr auto _find_index(const key_type& key, u64 hash) const -> usize
+        {
+            const i8 h2 = _get_h2(hash);
+            const usize mask = _capacity - 1;
+            usize pos = _get_h1(hash) & mask;
+            usize step = 0;
+
+            while (true)
+            {
+                group_type group{ _ctrl + pos };
+                for (auto matches = group.match(h2); matches.has_any(); matches.remove_lowest())
+                {
+                    usize index = (pos + matches.get_lowest()) & mask;
+                    if (_key_eq(policy_type::get_key(_slots[index]), key))
+                        return index;
+                }
+
+                if (group.match_empty().has_any())
+                    return _capacity;
+
+                step += group_type::width;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        constexpr auto _find_first_non_full(u64 hash) const -> usize
+        {
+            const usize mask = _capacity - 1;
+            usize pos = _get_h1(hash) & mask;
+            usize step = 0;
+
+            while (true)
+            {
+                group_type group{ _ctrl + pos };
+                auto matches = group.match_empty_or_deleted();
+                if (matches.has_any())
+                    return (pos + matches.get_lowest()) & mask;
+
+                step += group_type::width;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        constexpr auto _set_ctrl(usize index, i8 ctrl) -> void
+        {
+            _ctrl[index] = ctrl;
+
+            if (index < group_type::width)
+                _ctrl[_capacity + index] = ctrl;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// makes space for at least one more slot. if more than half of the slots not in use are
+        /// deleted, rehashes in a table of same capacity to drop them.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _grow() -> void
+        {
+            if (_capacity == 0)
+                _resize(group_type::width);
+            else if (_count * 16 <= _capacity * 7)
+                _resize(_capacity);
+            else
+                _resize(_capacity * 2);
+        }
+
+        constexpr auto _resize(usize new_capacity) -> void
+        {
+            slot_type* old_slots = _slots;
+            i8* old_ctrl = _ctrl;
+            usize old_capacity = _capacity;
+
+            _alloc_table(new_capacity);
+            _growth_left = _get_max_load(new_capacity) - _count;
+
+            for (usize i = 0; i < old_capacity; i++)
+            {
+                if (not _flat_hash_ctrl::is_full(old_ctrl[i]))
+                    continue;
+
+                const u64 hash = _hash(policy_type::get_key(old_slots[i]));
+                usize index = _find_first_non_full(hash);
+                _set_ctrl(index, _get_h2(hash));
+
+                if constexpr (slot_type_info::is_trivially_relocatable())
+                {
+                    std::memcpy(_slots + index, old_slots + i, sizeof(slot_type));
+                }
+                else
+                {
+                    std::construct_at(_slots + index, move(old_slots[i]));
+                    std::destroy_at(old_slots + i);
+                }
+            }
+
+            if (old_capacity != 0)
+                _allocator.dealloc(old_slots);
+        }
+
+        constexpr auto _alloc_table(usize capacity) -> void
+        {
+            static_assert(alignof(slot_type) <= alignof(std::max_align_t),
+                "over aligned slots are not supported.");
+
+            const usize slots_size = capacity * sizeof(slot_type);
+            const usize ctrl_size = capacity + group_type::width;
+            byte* mem = static_cast<byte*>(_allocator.alloc(slots_size + ctrl_size));
+
+            _slots = reinterpret_cast<slot_type*>(mem);
+            _ctrl = reinterpret_cast<i8*>(mem + slots_size);
+            _capacity = capacity;
+            std::memset(_ctrl, _flat_hash_ctrl::empty, ctrl_size);
+        }
+
+        constexpr auto _destruct_all() -> void
+        {
+            if constexpr (not slot_type_info::is_trivially_destructible())
+            {
+                for (usize i = 0; i < _capacity; i++)
+                {
+                    if (_flat_hash_ctrl::is_full(_ctrl[i]))
+                        std::destroy_at(_slots + i);
+                }
+            }
+        }
+
+        constexpr auto _destroy() -> void
+        {
+            if (_capacity == 0)
+                return;
+
+            _destruct_all();
+            _allocator.dealloc(_slots);
+
+            _slots = nullptr;
+            _ctrl = nullptr;
+            _capacity = 0;
+            _count = 0;
+            _growth_left = 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// copies slots of `that` to the same indices. `this` must be empty and own no memory.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _copy_from(const this_type& that) -> void
+        {
+            _hasher = that._hasher;
+            _key_eq = that._key_eq;
+
+            if (that._count == 0)
+                return;
+
+            _alloc_table(that._capacity);
+            std::memcpy(_ctrl, that._ctrl, _capacity + group_type::width);
+
+            for (usize i = 0; i < _capacity; i++)
+            {
+                if (_flat_hash_ctrl::is_full(_ctrl[i]))
+                    std::construct_at(_slots + i, that._slots[i]);
+            }
+
+            _count = that._count;
+            _growth_left = that._growth_left;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// steals memory of `that`. `this` must be empty and own no memory.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _take_from(this_type& that) -> void
+        {
+            _slots = that._slots;
+            _ctrl = that._ctrl;
+            _capacity = that._capacity;
+            _count = that._count;
+            _growth_left = that._growth_left;
+            _hasher = move(that._hasher);
+            _key_eq = move(that._key_eq);
+            _allocator = move(that._allocator);
+
+            that._slots = nullptr;
+            that._ctrl = nullptr;
+            that._capacity = 0;
+            that._count = 0;
+            that._growth_left = 0;
+        }
+
+    private:
+        slot_type* _slots;
+        i8* _ctrl;
+        usize _capacity;
+        usize _count;
+        usize _growth_left;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS hasher_type _hasher;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS key_eq_type _key_eq;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS allocator_type _allocator;
+    };
+}
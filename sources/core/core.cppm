@@ -34,6 +34,9 @@ export namespace atom
     struct create_from_null_tag
     {};
 
+    struct create_with_allocator_tag
+    {};
+
     template <typename value_type>
     struct create_by_emplace_tag
     {};
@@ -48,6 +51,7 @@ export namespace atom
     constexpr auto create_from_result = create_from_result_tag{};
     constexpr auto create_from_void = create_from_void_tag{};
     constexpr auto create_from_null = create_from_null_tag{};
+    constexpr auto create_with_allocator = create_with_allocator_tag{};
 
     template <typename value_type>
     constexpr auto create_by_emplace = create_by_emplace_tag<value_type>{};
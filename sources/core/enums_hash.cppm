@@ -0,0 +1,215 @@
+export module atom_core:core.enums_hash;
+
+import std;
+import magic_enum;
+import :core.int_wrapper;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// fnv-1a hash of the chars, used to bucket and place enum names.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto _enum_hash_str(const char* data, usize count) -> u64
+    {
+        u64 hash = 0xcbf29ce484222325;
+        for (usize i = 0; i < count; i++)
+        {
+            hash ^= u8(data[i]);
+            hash *= 0x100000001b3;
+        }
+
+        return hash;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// mixes a name's hash with its bucket's displacement, to choose its slot.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto _enum_hash_displace(u64 hash, u64 displacement) -> u64
+    {
+        hash ^= displacement * 0x9e3779b97f4a7c15;
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccd;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// perfect hash over the names of `enum_type`, built at compile time using hash and displace.
+    ///
+    /// names are grouped into buckets by their hash. starting with the biggest bucket, each bucket
+    /// gets the first displacement which moves all its names into free slots. a lookup hashes the
+    /// string once, reads its bucket's displacement and then compares against the only name in
+    /// its slot.
+    /// --------------------------------------------------------------------------------------------
+    template <typename enum_type>
+    class _enum_perfect_hash
+    {
+        static constexpr usize _count = magic_enum::enum_count<enum_type>();
+        static constexpr auto _names = magic_enum::enum_names<enum_type>();
+
+    public:
+        static constexpr usize bucket_count = _count == 0 ? 1 : _count;
+        static constexpr usize slot_count = std::bit_ceil(bucket_count * 2);
+
+        /// value of an empty slot and of `find()` if the name is not found.
+        static constexpr usize not_found = _count;
+
+        /// displacements tried for each bucket, before falling back to linear search.
+        static constexpr u32 max_displacement = 1 << 16;
+
+    private:
+        class _table
+        {
+        public:
+            bool is_perfect;
+            std::array<u32, bucket_count> displacements;
+            std::array<usize, slot_count> slots;
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns index of the name equal to `count` chars at `data`, or `not_found`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto find(const char* data, usize count) -> usize
+        {
+            if constexpr (_count == 0)
+            {
+                return not_found;
+            }
+            else
+            {
+                if (not _table_value.is_perfect)
+                {
+                    for (usize i = 0; i < _count; i++)
+                    {
+                        if (_is_name_eq(i, data, count))
+                            return i;
+                    }
+
+                    return not_found;
+                }
+
+                const u64 hash = _enum_hash_str(data, count);
+                const u32 displacement = _table_value.displacements[hash % bucket_count];
+                const usize slot = _enum_hash_displace(hash, displacement) & (slot_count - 1);
+                const usize index = _table_value.slots[slot];
+
+                if (index == not_found or not _is_name_eq(index, data, count))
+                    return not_found;
+
+                return index;
+            }
+        }
+
+        static consteval auto is_perfect() -> bool
+        {
+            return _table_value.is_perfect;
+        }
+
+    private:
+        static constexpr auto _is_name_eq(usize index, const char* data, usize count) -> bool
+        {
+            const auto& name = _names[index];
+            if (name.size() != count)
+                return false;
+
+            if consteval
+            {
+                for (usize i = 0; i < count; i++)
+                {
+                    if (name[i] != data[i])
+                        return false;
+                }
+
+                return true;
+            }
+            else
+            {
+                return std::memcmp(name.data(), data, count) == 0;
+            }
+        }
+
+        static consteval auto _build() -> _table
+        {
+            _table table{};
+            table.is_perfect = true;
+            table.slots.fill(not_found);
+
+            std::array<u64, bucket_count> hashes{};
+            std::array<usize, bucket_count> buckets{};
+            std::array<usize, bucket_count> bucket_sizes{};
+
+            for (usize i = 0; i < _count; i++)
+            {
+                hashes[i] = _enum_hash_str(_names[i].data(), _names[i].size());
+                buckets[i] = hashes[i] % bucket_count;
+                bucket_sizes[buckets[i]]++;
+            }
+
+            for (usize size = _count; size > 0; size--)
+            {
+                for (usize bucket = 0; bucket < bucket_count; bucket++)
+                {
+                    if (bucket_sizes[bucket] != size)
+                        continue;
+
+                    if (not _place_bucket(table, hashes, buckets, bucket))
+                    {
+                        table.is_perfect = false;
+                        return table;
+                    }
+                }
+            }
+
+            return table;
+        }
+
+        static consteval auto _place_bucket(_table& table,
+            const std::array<u64, bucket_count>& hashes,
+            const std::array<usize, bucket_count>& buckets, usize bucket) -> bool
+        {
+            for (u32 displacement = 0; displacement < max_displacement; displacement++)
+            {
+                bool is_placed = true;
+                usize placed_count = 0;
+                std::array<usize, bucket_count> placed_slots{};
+
+                for (usize i = 0; i < _count and is_placed; i++)
+                {
+                    if (buckets[i] != bucket)
+                        continue;
+
+                    const usize slot =
+                        _enum_hash_displace(hashes[i], displacement) & (slot_count - 1);
+
+                    if (table.slots[slot] != not_found)
+                    {
+                        is_placed = false;
+                        break;
+                    }
+
+                    table.slots[slot] = i;
+                    placed_slots[placed_count++] = slot;
+                }
+
+                if (is_placed)
+                {
+                    table.displacements[bucket] = displacement;
+                    return true;
+                }
+
+                for (usize i = 0; i < placed_count; i++)
+                    table.slots[placed_slots[i]] = not_found;
+            }
+
+            return false;
+        }
+
+    private:
+        static const _table _table_value;
+    };
+
+    template <typename enum_type>
+    constexpr typename _enum_perfect_hash<enum_type>::_table
+        _enum_perfect_hash<enum_type>::_table_value = _enum_perfect_hash<enum_type>::_build();
+}
@@ -6,6 +6,7 @@ import :core.core;
 import :core.nums;
 import :core.tuple;
 import :core.option;
+import :core.enums_hash;
 import :strings.string_view;
 import :containers.array_view;
 
@@ -15,18 +16,42 @@ namespace atom
     constexpr auto _enums_impl<enum_type, is_flags>::from_string(
         string_view str) -> option<enum_type>
     {
-        magic_optional_type<enum_type> result = [&]
-        {
-            if constexpr (is_flags())
-                return magic_enum::enum_flags_cast<enum_type>(std::string_view{ str });
-            else
-                magic_enum::enum_cast<enum_type>(std::string_view{ str });
-        }();
+        using perfect_hash_type = _enum_perfect_hash<enum_type>;
 
-        if (not result.has_value())
-            return { create_from_null };
+        const char* data = str.get_data();
+        const usize count = str.get_count();
 
-        return result.value();
+        if constexpr (not is_flags())
+        {
+            const usize index = perfect_hash_type::find(data, count);
+            if (index == perfect_hash_type::not_found)
+                return { create_from_null };
+
+            return from_index_unchecked(index);
+        }
+        else
+        {
+            if (count == 0)
+                return { create_from_null };
+
+            // looks up each flag between the `|` separators, and adds them.
+            enum_type result = enum_type(0);
+            usize begin = 0;
+            for (usize i = 0; i <= count; i++)
+            {
+                if (i != count and data[i] != '|')
+                    continue;
+
+                const usize index = perfect_hash_type::find(data + begin, i - begin);
+                if (index == perfect_hash_type::not_found)
+                    return { create_from_null };
+
+                result = add_flags(result, from_index_unchecked(index));
+                begin = i + 1;
+            }
+
+            return result;
+        }
     }
 
     template <typename enum_type, bool is_flags>
@@ -40,7 +65,7 @@ namespace atom
                 return magic_enum::enum_flags_cast<enum_type>(
                     std::string_view{ str }, forward<comparer_type>(comparer));
             else
-                magic_enum::enum_cast<enum_type>(
+                return magic_enum::enum_cast<enum_type>(
                     std::string_view{ str }, forward<comparer_type>(comparer));
         }();
 
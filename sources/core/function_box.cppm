@@ -3,8 +3,8 @@ export module atom_core:function_box;
 import std;
 import :core;
 import :types;
-import :box;
 import :contracts;
+import :default_mem_allocator;
 
 /// ------------------------------------------------------------------------------------------------
 /// implementations
@@ -14,51 +14,142 @@ namespace atom
     class function_box_tag
     {};
 
-    template <typename result_type, typename... arg_types>
-    class _function_box_interface
+    class unique_function_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// operations to manage a stored function. there is one static instance per function type, so
+    /// a stored function costs a single pointer to it.
+    ///
+    /// `copy` is `nullptr` for functions stored in `unique_function`.
+    /// --------------------------------------------------------------------------------------------
+    class _function_vtable
     {
     public:
-        virtual auto invoke(arg_types... args) -> result_type = 0;
+        auto (*copy)(const void* storage, void* dest_storage) -> void;
+        auto (*relocate)(void* storage, void* dest_storage) -> void;
+        auto (*destroy)(void* storage) -> void;
+        auto (*get_type)() -> const std::type_info&;
+        auto (*get_ptr)(void* storage) -> void*;
     };
 
-    template <typename function_type, typename result_type, typename... arg_types>
-    class _function_box_wrapper: public _function_box_interface<result_type, arg_types...>
+    /// --------------------------------------------------------------------------------------------
+    /// stores `function_type` inside a storage of `buf_size` bytes if it fits and can be moved
+    /// without throwing, else on heap allocated using `default_mem_allocator` with the storage
+    /// holding the pointer.
+    /// --------------------------------------------------------------------------------------------
+    template <typename function_type, usize buf_size, bool is_copyable>
+    class _function_storage
     {
     public:
-        _function_box_wrapper(function_type&& function)
-            : _function{ function }
-        {}
+        static constexpr bool is_inline = sizeof(function_type) <= buf_size
+                                          and alignof(function_type) <= alignof(std::max_align_t)
+                                          and std::is_nothrow_move_constructible_v<function_type>;
 
     public:
-        virtual auto invoke(arg_types... args) -> result_type override final
+        template <typename... ctor_arg_types>
+        static auto create(void* storage, ctor_arg_types&&... args) -> void
         {
-            if constexpr (type_info<result_type>::is_void)
+            if constexpr (is_inline)
             {
-                _function(forward<arg_types>(args)...);
+                std::construct_at(
+                    static_cast<function_type*>(storage), forward<ctor_arg_types>(args)...);
             }
             else
             {
-                return _function(forward<arg_types>(args)...);
+                void* mem = default_mem_allocator().alloc(sizeof(function_type));
+                *static_cast<function_type**>(storage) = std::construct_at(
+                    static_cast<function_type*>(mem), forward<ctor_arg_types>(args)...);
             }
         }
 
+        static auto get(void* storage) -> function_type*
+        {
+            if constexpr (is_inline)
+                return static_cast<function_type*>(storage);
+            else
+                return *static_cast<function_type**>(storage);
+        }
+
+        template <typename result_type, typename... arg_types>
+        static auto invoke(void* storage, arg_types&&... args) -> result_type
+        {
+            return std::invoke_r<result_type>(*get(storage), forward<arg_types>(args)...);
+        }
+
+        static auto copy(const void* storage, void* dest_storage) -> void
+        {
+            create(dest_storage, *get(const_cast<void*>(storage)));
+        }
+
+        static auto relocate(void* storage, void* dest_storage) -> void
+        {
+            if constexpr (is_inline)
+            {
+                function_type* function = get(storage);
+                create(dest_storage, move(*function));
+                std::destroy_at(function);
+            }
+            else
+            {
+                *static_cast<function_type**>(dest_storage) = get(storage);
+            }
+        }
+
+        static auto destroy(void* storage) -> void
+        {
+            function_type* function = get(storage);
+            std::destroy_at(function);
+
+            if constexpr (not is_inline)
+                default_mem_allocator().dealloc(function);
+        }
+
+        static auto get_type() -> const std::type_info&
+        {
+            return typeid(function_type);
+        }
+
+        static auto get_ptr(void* storage) -> void*
+        {
+            return get(storage);
+        }
+
+        static consteval auto get_copy() -> void (*)(const void*, void*)
+        {
+            // taking address of `copy` instantiates it, which fails for move only functions.
+            if constexpr (is_copyable)
+                return &copy;
+            else
+                return nullptr;
+        }
+
     public:
-        function_type _function;
+        static constexpr _function_vtable vtable = {
+            .copy = get_copy(),
+            .relocate = &relocate,
+            .destroy = &destroy,
+            .get_type = &get_type,
+            .get_ptr = &get_ptr,
+        };
     };
 
     /// --------------------------------------------------------------------------------------------
-    /// stores an function value_type using boxing.
+    /// type erased storage for functions, shared by `function_box` and `unique_function`.
+    ///
+    /// the pointer to invoke the function is kept inline, so invoking costs a single indirect
+    /// call. other operations go through the static `_function_vtable`.
     /// --------------------------------------------------------------------------------------------
-    template <typename result_type, typename... arg_types>
+    template <bool in_is_copyable, usize in_buf_size, typename result_type, typename... arg_types>
     class _function_box_impl
     {
-        using this_type = _function_box_impl<result_type, arg_types...>;
-        using _box_type = std::function<result_type(arg_types...)>;
-        // using _interface_type = _function_box_interface<result_type, arg_types...>;
-        // using _box_type = copy_move_box<_interface_type, true, 50>;
+        static_assert(in_buf_size >= sizeof(void*), "buf_size must be able to hold a pointer.");
 
-        // template <typename function_type>
-        // using _wrapper_type = _function_box_wrapper<function_type, result_type, arg_types...>;
+        using this_type = _function_box_impl;
+        using invoker_type = result_type (*)(void*, arg_types&&...);
+
+        template <typename function_type>
+        using storage_type = _function_storage<function_type, in_buf_size, in_is_copyable>;
 
     public:
         class copy_tag
@@ -72,43 +163,61 @@ namespace atom
 
     public:
         _function_box_impl()
-            : _box{}
+            : _invoker{ nullptr }
+            , _vtable{ nullptr }
         {}
 
         _function_box_impl(copy_tag, const this_type& that)
-            : _box{ that._box }
-        {}
-
-        auto copy_that(const this_type& that)
+            : _function_box_impl{}
         {
-            _box = that._box;
+            _copy_from(that);
         }
 
         _function_box_impl(move_tag, this_type& that)
-            : _box{ atom::move(that._box) }
-        {}
-
-        auto move_that(this_type& that)
+            : _function_box_impl{}
         {
-            _box = atom::move(that._box);
+            _move_from(that);
         }
 
         template <typename function_type>
         _function_box_impl(value_tag, function_type&& function)
-            : _box{ forward<function_type>(function) }
-        {}
+            : _function_box_impl{}
+        {
+            _set(forward<function_type>(function));
+        }
 
-        ~_function_box_impl() {}
+        ~_function_box_impl()
+        {
+            destroy_function();
+        }
 
     public:
+        auto copy_that(const this_type& that) -> void
+        {
+            if (this == &that)
+                return;
+
+            destroy_function();
+            _copy_from(that);
+        }
+
+        auto move_that(this_type& that) -> void
+        {
+            if (this == &that)
+                return;
+
+            destroy_function();
+            _move_from(that);
+        }
+
         /// ----------------------------------------------------------------------------------------
         /// stores function.
         /// ----------------------------------------------------------------------------------------
         template <typename function_type>
-        auto set_function(function_type&& function)
+        auto set_function(function_type&& function) -> void
         {
-            // _box.set_val(_wrapper_type<function_type>(forward<function_type>(function)));
-            _box = forward<function_type>(function);
+            destroy_function();
+            _set(forward<function_type>(function));
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -117,20 +226,18 @@ namespace atom
         template <typename function_type>
         auto get_function_as() -> function_type*
         {
-            // if (typeid(function_type) != get_function_type())
-            //     return nullptr;
+            if (_vtable == nullptr or _vtable->get_type() != typeid(function_type))
+                return nullptr;
 
-            // return _box.template mut_mem_as<function_type>();
-            return _box.template get_type<function_type>();
+            return static_cast<function_type*>(_vtable->get_ptr(_storage));
         }
 
         /// ----------------------------------------------------------------------------------------
-        ///
+        /// \returns type of the stored function, or `void` if there is none.
         /// ----------------------------------------------------------------------------------------
         auto get_function_type() const -> const std::type_info&
         {
-            // return _box.val_type();
-            return _box.target_type();
+            return _vtable == nullptr ? typeid(void) : _vtable->get_type();
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -138,30 +245,75 @@ namespace atom
         /// ----------------------------------------------------------------------------------------
         auto has_function() const -> bool
         {
-            // return _box.has_val();
-            return (bool)_box;
+            return _invoker != nullptr;
         }
 
         /// ----------------------------------------------------------------------------------------
         /// invokes stored function.
         /// ----------------------------------------------------------------------------------------
-        auto invoke_function(arg_types&&... args) -> result_type
+        template <typename... invoke_arg_types>
+        auto invoke_function(invoke_arg_types&&... args) -> result_type
         {
-            // return _box.get().invoke(forward<arg_types>(args)...);
-            return _box(forward<arg_types>(args)...);
+            return _invoker(_storage, forward<invoke_arg_types>(args)...);
         }
 
         /// ----------------------------------------------------------------------------------------
         /// destroys stored function if any.
         /// ----------------------------------------------------------------------------------------
-        auto destroy_function()
+        auto destroy_function() -> void
+        {
+            if (_vtable == nullptr)
+                return;
+
+            _vtable->destroy(_storage);
+            _invoker = nullptr;
+            _vtable = nullptr;
+        }
+
+    private:
+        template <typename function_type>
+        auto _set(function_type&& function) -> void
+        {
+            using stored_type = std::decay_t<function_type>;
+
+            if constexpr (std::is_pointer_v<stored_type>)
+            {
+                if (function == nullptr)
+                    return;
+            }
+
+            storage_type<stored_type>::create(_storage, forward<function_type>(function));
+            _invoker = &storage_type<stored_type>::template invoke<result_type, arg_types...>;
+            _vtable = &storage_type<stored_type>::vtable;
+        }
+
+        auto _copy_from(const this_type& that) -> void
+        {
+            if (that._vtable == nullptr)
+                return;
+
+            that._vtable->copy(that._storage, _storage);
+            _invoker = that._invoker;
+            _vtable = that._vtable;
+        }
+
+        auto _move_from(this_type& that) -> void
         {
-            // _box.destroy();
-            _box = nullptr;
+            if (that._vtable == nullptr)
+                return;
+
+            that._vtable->relocate(that._storage, _storage);
+            _invoker = that._invoker;
+            _vtable = that._vtable;
+
+            that._invoker = nullptr;
+            that._vtable = nullptr;
         }
 
     private:
-        _box_type _box;
+        invoker_type _invoker;
+        const _function_vtable* _vtable;
+        alignas(std::max_align_t) byte _storage[in_buf_size];
     };
 }
 
@@ -173,22 +325,22 @@ namespace atom
     /// --------------------------------------------------------------------------------------------
     /// [`function_box`] declaration.
     /// --------------------------------------------------------------------------------------------
-    export template <typename signature>
+    export template <typename signature, usize buf_size = 48>
     class function_box;
 
     /// --------------------------------------------------------------------------------------------
-    /// stores an function value_type using boxing.
+    /// stores a copyable function, inline if it fits in `buf_size` bytes, else on the heap.
     /// --------------------------------------------------------------------------------------------
-    export template <typename result_type, typename... arg_types>
-    class function_box<result_type(arg_types...)>: public function_box_tag
+    export template <typename result_type, typename... arg_types, usize buf_size>
+    class function_box<result_type(arg_types...), buf_size>: public function_box_tag
     {
-        using _impl_type = _function_box_impl<result_type, arg_types...>;
+        using _impl_type = _function_box_impl<true, buf_size, result_type, arg_types...>;
 
     public:
         /// ----------------------------------------------------------------------------------------
         /// # default constructor.
         /// ----------------------------------------------------------------------------------------
-        constexpr function_box()
+        function_box()
             : _impl{}
         {}
 
@@ -246,7 +398,9 @@ namespace atom
         template <typename function_type>
         function_box(function_type&& function)
             requires(type_info<function_type>::template is_function<result_type(arg_types...)>())
-                    and (not type_info<function_type>::template is_derived_from<function_box_tag>())
+                    and (not type_info<std::decay_t<function_type>>::template is_derived_from<
+                         function_box_tag>())
+                    and (type_info<std::decay_t<function_type>>::is_copy_constructible())
             : _impl{ typename _impl_type::value_tag(), forward<function_type>(function) }
         {}
 
@@ -255,9 +409,10 @@ namespace atom
         /// ----------------------------------------------------------------------------------------
         template <typename function_type>
         function_box& operator=(function_type&& function)
-            requires type_info<function_type>::template
-        is_function<result_type(arg_types...)>
-            and (not type_info<function_type>::template is_derived_from<function_box_tag>())
+            requires(type_info<function_type>::template is_function<result_type(arg_types...)>())
+                    and (not type_info<std::decay_t<function_type>>::template is_derived_from<
+                         function_box_tag>())
+                    and (type_info<std::decay_t<function_type>>::is_copy_constructible())
         {
             _impl.set_function(forward<function_type>(function));
             return *this;
@@ -274,12 +429,14 @@ namespace atom
         /// ----------------------------------------------------------------------------------------
         template <typename function_type>
         auto set(function_type&& function)
+            requires(type_info<function_type>::template is_function<result_type(arg_types...)>())
+                    and (type_info<std::decay_t<function_type>>::is_copy_constructible())
         {
             _impl.set_function(forward<function_type>(function));
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// returns stored function as a `mut_ptr` to `value_type`.
+        /// returns pointer to stored function if it's of type `value_type`, else `nullptr`.
         /// ----------------------------------------------------------------------------------------
         template <typename value_type>
         auto get_as() -> value_type*
@@ -298,7 +455,7 @@ namespace atom
         /// ----------------------------------------------------------------------------------------
         /// invokes the stored function.
         /// ----------------------------------------------------------------------------------------
-        auto invoke(arg_types&&... args) -> result_type
+        auto invoke(arg_types... args) -> result_type
         {
             contract_expects(has(), "no function is present.");
 
@@ -306,27 +463,188 @@ namespace atom
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// invokes the stored function if any.
+        /// invokes the stored function if any, writing the result to `out`.
+        ///
+        /// \returns `true` if a function was invoked.
         /// ----------------------------------------------------------------------------------------
-        auto invoke_typery(result_type* out, arg_types&&... args) -> result_type
+        auto try_invoke(result_type* out, arg_types... args) -> bool
+            requires(not type_info<result_type>::is_void())
         {
             if (not _impl.has_function())
-                return;
+                return false;
 
             *out = _impl.invoke_function(forward<arg_types>(args)...);
+            return true;
         }
 
         /// ----------------------------------------------------------------------------------------
         /// returns `invoke(args...)`.
         /// ----------------------------------------------------------------------------------------
-        auto operator()(arg_types&&... args) -> result_type
+        auto operator()(arg_types... args) -> result_type
         {
             return invoke(forward<arg_types>(args)...);
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if this contains a function.
+        /// ----------------------------------------------------------------------------------------
+        auto has() const -> bool
+        {
+            return _impl.has_function();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// destroys stored function if any.
+        /// ----------------------------------------------------------------------------------------
+        auto destroy()
+        {
+            return _impl.destroy_function();
+        }
+
         /// ----------------------------------------------------------------------------------------
         /// returns `true` if this doesn't contain an function.
         /// ----------------------------------------------------------------------------------------
+        auto operator==(nullptr_t null) const -> bool
+        {
+            return not _impl.has_function();
+        }
+
+    private:
+        _impl_type _impl;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// [`unique_function`] declaration.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename signature, usize buf_size = 48>
+    class unique_function;
+
+    /// --------------------------------------------------------------------------------------------
+    /// move only version of `function_box`, which can store functions which can't be copied.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename result_type, typename... arg_types, usize buf_size>
+    class unique_function<result_type(arg_types...), buf_size>: public unique_function_tag
+    {
+        using _impl_type = _function_box_impl<false, buf_size, result_type, arg_types...>;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor.
+        /// ----------------------------------------------------------------------------------------
+        unique_function()
+            : _impl{}
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        unique_function(const unique_function& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(const unique_function& that) -> unique_function& = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move constructor
+        /// ----------------------------------------------------------------------------------------
+        unique_function(unique_function&& that)
+            : _impl{ typename _impl_type::move_tag(), that._impl }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(unique_function&& that) -> unique_function&
+        {
+            _impl.move_that(that._impl);
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # null constructor.
+        /// ----------------------------------------------------------------------------------------
+        unique_function(nullptr_t null)
+            : _impl{}
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # null operator.
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(nullptr_t null) -> unique_function&
+        {
+            _impl.destroy_function();
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # value constructor
+        /// ----------------------------------------------------------------------------------------
+        template <typename function_type>
+        unique_function(function_type&& function)
+            requires(type_info<function_type>::template is_function<result_type(arg_types...)>())
+                    and (not type_info<std::decay_t<function_type>>::template is_derived_from<
+                         unique_function_tag>())
+            : _impl{ typename _impl_type::value_tag(), forward<function_type>(function) }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # value operator
+        /// ----------------------------------------------------------------------------------------
+        template <typename function_type>
+        unique_function& operator=(function_type&& function)
+            requires(type_info<function_type>::template is_function<result_type(arg_types...)>())
+                    and (not type_info<std::decay_t<function_type>>::template is_derived_from<
+                         unique_function_tag>())
+        {
+            _impl.set_function(forward<function_type>(function));
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        /// ----------------------------------------------------------------------------------------
+        ~unique_function() {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns pointer to stored function if it's of type `value_type`, else `nullptr`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type>
+        auto get_as() -> value_type*
+        {
+            return _impl.template get_function_as<value_type>();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the typeid for the stored function.
+        /// ----------------------------------------------------------------------------------------
+        auto get_type() const -> const std::type_info&
+        {
+            return _impl.get_function_type();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// invokes the stored function.
+        /// ----------------------------------------------------------------------------------------
+        auto invoke(arg_types... args) -> result_type
+        {
+            contract_expects(has(), "no function is present.");
+
+            return _impl.invoke_function(forward<arg_types>(args)...);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `invoke(args...)`.
+        /// ----------------------------------------------------------------------------------------
+        auto operator()(arg_types... args) -> result_type
+        {
+            return invoke(forward<arg_types>(args)...);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if this contains a function.
+        /// ----------------------------------------------------------------------------------------
         auto has() const -> bool
         {
             return _impl.has_function();
@@ -351,4 +669,108 @@ namespace atom
     private:
         _impl_type _impl;
     };
+
+    /// --------------------------------------------------------------------------------------------
+    /// [`function_ref`] declaration.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename signature>
+    class function_ref;
+
+    /// --------------------------------------------------------------------------------------------
+    /// non owning reference to a function, for passing callbacks as parameters without
+    /// allocating or copying them. it's two pointers wide and cheap to copy.
+    ///
+    /// \note the referenced function must outlive the `function_ref`, don't store it.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename result_type, typename... arg_types>
+    class function_ref<result_type(arg_types...)>
+    {
+        union _target_type
+        {
+            void* object;
+            void (*function)();
+        };
+
+        using invoker_type = result_type (*)(_target_type, arg_types&&...);
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr function_ref(const function_ref& that) = default;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto operator=(const function_ref& that) -> function_ref& = default;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # value constructor
+        ///
+        /// refers to `function`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename function_type>
+        constexpr function_ref(function_type&& function)
+            requires(type_info<function_type>::template is_function<result_type(arg_types...)>())
+                    and (not type_info<std::remove_cvref_t<function_type>>::template is_same_as<
+                         function_ref>())
+        {
+            using pure_type = std::remove_reference_t<function_type>;
+
+            if constexpr (std::is_function_v<pure_type>)
+            {
+                _set_function(&function);
+            }
+            else if constexpr (std::is_pointer_v<std::remove_cv_t<pure_type>>
+                               and std::is_function_v<std::remove_pointer_t<pure_type>>)
+            {
+                contract_expects(function != nullptr, "function is null.");
+
+                // store the function pointer itself, as `function` may be a temporary.
+                _set_function(function);
+            }
+            else
+            {
+                _target.object = const_cast<void*>(static_cast<const void*>(&function));
+                _invoker = [](_target_type target, arg_types&&... args) -> result_type
+                {
+                    return std::invoke_r<result_type>(
+                        *static_cast<pure_type*>(target.object), forward<arg_types>(args)...);
+                };
+            }
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// invokes the referenced function.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto invoke(arg_types... args) const -> result_type
+        {
+            return _invoker(_target, forward<arg_types>(args)...);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `invoke(args...)`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto operator()(arg_types... args) const -> result_type
+        {
+            return _invoker(_target, forward<arg_types>(args)...);
+        }
+
+    private:
+        template <typename function_type>
+        constexpr auto _set_function(function_type* function) -> void
+        {
+            _target.function = reinterpret_cast<void (*)()>(function);
+            _invoker = [](_target_type target, arg_types&&... args) -> result_type
+            {
+                return std::invoke_r<result_type>(
+                    reinterpret_cast<function_type*>(target.function), forward<arg_types>(args)...);
+            };
+        }
+
+    private:
+        _target_type _target;
+        invoker_type _invoker;
+    };
 }
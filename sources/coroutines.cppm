@@ -0,0 +1,4 @@
+export module atom_core:coroutines;
+
+export import :coroutines.task;
+export import :coroutines.generator;
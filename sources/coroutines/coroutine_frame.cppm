@@ -0,0 +1,58 @@
+export module atom_core:coroutines.coroutine_frame;
+
+import std;
+import :core;
+import :types;
+import :default_mem_allocator;
+import :arena_allocator;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// stored before each coroutine frame, to free it with the allocator it came from.
+    /// --------------------------------------------------------------------------------------------
+    class alignas(std::max_align_t) _coroutine_frame_header
+    {
+    public:
+        arena* source;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// allocates frames of `task` and `generator` coroutines.
+    ///
+    /// frames are allocated from the arena of the current `arena_scope` if there is one, else
+    /// using `default_mem_allocator`. this way short lived coroutines can be allocated from an
+    /// arena just by creating them inside an `arena_scope`.
+    ///
+    /// compilers may still elide the allocation, when the frame doesn't outlive its caller.
+    /// --------------------------------------------------------------------------------------------
+    class _coroutine_frame
+    {
+    public:
+        static auto alloc(usize size) -> void*
+        {
+            arena* source = arena_scope::get_current();
+            const usize total_size = sizeof(_coroutine_frame_header) + size;
+
+            void* mem = source != nullptr ? source->alloc(total_size)
+                                          : default_mem_allocator().alloc(total_size);
+
+            _coroutine_frame_header* header =
+                std::construct_at(static_cast<_coroutine_frame_header*>(mem), source);
+
+            return header + 1;
+        }
+
+        static auto dealloc(void* frame) -> void
+        {
+            _coroutine_frame_header* header = static_cast<_coroutine_frame_header*>(frame) - 1;
+
+            // arenas free all their memory at once.
+            if (header->source == nullptr)
+                default_mem_allocator().dealloc(header);
+        }
+    };
+}
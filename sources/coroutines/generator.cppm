@@ -0,0 +1,346 @@
+export module atom_core:coroutines.generator;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :ranges;
+import :coroutines.coroutine_frame;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export template <typename value_type>
+    class generator;
+
+    /// --------------------------------------------------------------------------------------------
+    /// promise of `generator`, which keeps a pointer to the value last yielded.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_value_type>
+    class _generator_promise
+    {
+    public:
+        using value_type = in_value_type;
+
+    public:
+        _generator_promise()
+            : _value{ nullptr }
+        {}
+
+    public:
+        static auto operator new(usize size) -> void*
+        {
+            return _coroutine_frame::alloc(size);
+        }
+
+        static auto operator delete(void* frame) -> void
+        {
+            _coroutine_frame::dealloc(frame);
+        }
+
+    public:
+        auto get_return_object() -> generator<value_type>
+        {
+            return generator<value_type>{
+                std::coroutine_handle<_generator_promise>::from_promise(*this)
+            };
+        }
+
+        auto initial_suspend() noexcept -> std::suspend_always
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept -> std::suspend_always
+        {
+            return {};
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// yields `value` without copying it. it lives in the coroutine until it's resumed.
+        /// ----------------------------------------------------------------------------------------
+        auto yield_value(value_type&& value) noexcept -> std::suspend_always
+        {
+            _value = &value;
+            return {};
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// yields a copy of `value`, so that consumers can't modify the original.
+        /// ----------------------------------------------------------------------------------------
+        auto yield_value(const value_type& value) -> std::suspend_always
+        {
+            _copy.emplace(value);
+            _value = &_copy.get();
+            return {};
+        }
+
+        auto return_void() -> void {}
+
+        auto unhandled_exception() -> void
+        {
+            _exception = std::current_exception();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// generators produce values synchronously, they can't await.
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type>
+        auto await_transform(that_type&& awaitable) -> std::suspend_never = delete;
+
+    public:
+        auto get_value() const -> value_type&
+        {
+            return *_value;
+        }
+
+        auto rethrow_if_exception() -> void
+        {
+            if (_exception)
+                std::rethrow_exception(_exception);
+        }
+
+    private:
+        value_type* _value;
+        option<value_type> _copy;
+        std::exception_ptr _exception;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// end iterator for `generator`.
+    /// --------------------------------------------------------------------------------------------
+    class _generator_iterator_end
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// input iterator over a `generator`, resuming the coroutine when advanced.
+    ///
+    /// all iterators of a generator share its coroutine, so only the current value is valid.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_value_type>
+    class _generator_iterator
+    {
+        using this_type = _generator_iterator;
+        using handle_type = std::coroutine_handle<_generator_promise<in_value_type>>;
+
+    public:
+        using value_type = in_value_type;
+        using difference_type = isize;
+        using iterator_category = std::input_iterator_tag;
+
+    public:
+        constexpr _generator_iterator()
+            : _handle{}
+        {}
+
+        explicit _generator_iterator(handle_type handle)
+            : _handle{ handle }
+        {}
+
+    public:
+        auto operator*() const -> value_type&
+        {
+            contract_debug_expects(not _handle.done(), "generator is done.");
+
+            return _handle.promise().get_value();
+        }
+
+        auto operator->() const -> value_type*
+        {
+            return &**this;
+        }
+
+        auto operator++() -> this_type&
+        {
+            contract_debug_expects(not _handle.done(), "generator is done.");
+
+            _handle.resume();
+            _handle.promise().rethrow_if_exception();
+            return *this;
+        }
+
+        auto operator++(int) -> void
+        {
+            ++*this;
+        }
+
+        auto operator==(const this_type& that) const -> bool
+        {
+            return _handle == that._handle;
+        }
+
+        auto operator==(const _generator_iterator_end& that) const -> bool
+        {
+            return not _handle or _handle.done();
+        }
+
+    private:
+        handle_type _handle;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export class generator_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// coroutine yielding a sequence of `value_type` lazily, which is an input range.
+    ///
+    /// the coroutine runs only while the range is iterated, until the next `co_yield`. values
+    /// yielded as rvalues aren't copied, so producers like file readers or parsers can stream
+    /// values to consumers without intermediate buffers.
+    ///
+    /// ```
+    /// auto iota(i32 count) -> generator<i32>
+    /// {
+    ///     for (i32 i = 0; i < count; i++)
+    ///         co_yield i;
+    /// }
+    /// ```
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type>
+    class generator: public generator_tag
+    {
+        using this_type = generator;
+
+    public:
+        using value_type = in_value_type;
+        using promise_type = _generator_promise<value_type>;
+        using iterator_type = _generator_iterator<value_type>;
+        using iterator_end_type = _generator_iterator_end;
+
+    private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        friend promise_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        generator(const this_type& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(const this_type& that) -> this_type& = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move constructor
+        /// ----------------------------------------------------------------------------------------
+        generator(this_type&& that)
+            : _handle{ std::exchange(that._handle, nullptr) }
+            , _is_started{ that._is_started }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(this_type&& that) -> this_type&
+        {
+            _destroy();
+            _handle = std::exchange(that._handle, nullptr);
+            _is_started = that._is_started;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// destroys the coroutine, along with the values it holds.
+        /// ----------------------------------------------------------------------------------------
+        ~generator()
+        {
+            _destroy();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// runs the coroutine upto the first `co_yield` if it wasn't started yet.
+        ///
+        /// \returns iterator to the current value.
+        /// ----------------------------------------------------------------------------------------
+        auto get_iterator() const -> iterator_type
+        {
+            contract_debug_expects(_handle, "generator is moved.");
+
+            if (not _is_started)
+            {
+                _is_started = true;
+                _handle.resume();
+                _handle.promise().rethrow_if_exception();
+            }
+
+            return iterator_type{ _handle };
+        }
+
+        auto get_iterator_end() const -> iterator_end_type
+        {
+            return iterator_end_type{};
+        }
+
+    private:
+        explicit generator(handle_type handle)
+            : _handle{ handle }
+            , _is_started{ false }
+        {}
+
+        auto _destroy() -> void
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+
+    private:
+        handle_type _handle;
+
+        /// starting the coroutine doesn't change the values it will yield.
+        mutable bool _is_started;
+    };
+}
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// generators are single pass, so iterating a const generator advances it too. this lets them
+    /// be used with views, which take ranges as const.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<generator_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using iterator_type = typename range_type::iterator_type;
+        using iterator_end_type = typename range_type::iterator_end_type;
+        using const_iterator_type = typename range_type::iterator_type;
+        using const_iterator_end_type = typename range_type::iterator_end_type;
+
+    public:
+        static auto get_iterator(range_type& range) -> iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static auto get_iterator_end(range_type& range) -> iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+
+        static auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static auto get_const_iterator_end(const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
@@ -0,0 +1,540 @@
+export module atom_core:coroutines.task;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :parallel.task_scheduler;
+import :coroutines.coroutine_frame;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export template <typename value_type>
+    class task;
+
+    export template <typename value_type>
+    auto sync_wait(task<value_type> target) -> value_type;
+
+    template <typename value_type>
+    class _task_promise;
+
+    template <typename value_type>
+    constexpr bool _is_option = false;
+
+    template <typename value_type>
+    constexpr bool _is_option<option<value_type>> = true;
+
+    /// --------------------------------------------------------------------------------------------
+    /// parts of `task` promises which don't depend on the value type.
+    ///
+    /// when a task is done, it resumes the coroutine awaiting it directly from `final_suspend()`,
+    /// so long chains of tasks don't grow the stack.
+    /// --------------------------------------------------------------------------------------------
+    class _task_promise_base
+    {
+    public:
+        using on_done_type = auto (*)(void* context) -> void;
+
+        class final_awaiter
+        {
+        public:
+            auto await_ready() const noexcept -> bool
+            {
+                return false;
+            }
+
+            template <typename promise_type>
+            auto await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+                -> std::coroutine_handle<>
+            {
+                return handle.promise().complete();
+            }
+
+            auto await_resume() const noexcept -> void {}
+        };
+
+    public:
+        _task_promise_base()
+            : _continuation{}
+            , _on_done{ nullptr }
+            , _on_done_context{ nullptr }
+            , _is_done{ false }
+        {}
+
+    public:
+        static auto operator new(usize size) -> void*
+        {
+            return _coroutine_frame::alloc(size);
+        }
+
+        static auto operator delete(void* frame) -> void
+        {
+            _coroutine_frame::dealloc(frame);
+        }
+
+    public:
+        auto initial_suspend() noexcept -> std::suspend_always
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept -> final_awaiter
+        {
+            return {};
+        }
+
+        auto unhandled_exception() -> void
+        {
+            _exception = std::current_exception();
+        }
+
+    public:
+        auto set_continuation(std::coroutine_handle<> continuation) -> void
+        {
+            _continuation = continuation;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// sets `on_done` to be invoked with `context` when the task is done, if no coroutine
+        /// awaits it. the task may be destroyed from inside `on_done`.
+        /// ----------------------------------------------------------------------------------------
+        auto set_on_done(on_done_type on_done, void* context) -> void
+        {
+            _on_done = on_done;
+            _on_done_context = context;
+        }
+
+        auto is_done() const -> bool
+        {
+            return _is_done;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// marks the task done, either by returning or by awaiting an error.
+        ///
+        /// \returns the coroutine to resume next.
+        /// ----------------------------------------------------------------------------------------
+        auto complete() -> std::coroutine_handle<>
+        {
+            _is_done = true;
+
+            if (_continuation)
+                return _continuation;
+
+            if (_on_done != nullptr)
+                _on_done(_on_done_context);
+
+            return std::noop_coroutine();
+        }
+
+    protected:
+        auto _rethrow_if_exception() -> void
+        {
+            if (_exception)
+                std::rethrow_exception(_exception);
+        }
+
+    private:
+        std::coroutine_handle<> _continuation;
+        on_done_type _on_done;
+        void* _on_done_context;
+        std::exception_ptr _exception;
+        bool _is_done;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// awaits a `result` inside a task returning a `result`. if it holds an error, the task
+    /// returns that error without resuming.
+    /// --------------------------------------------------------------------------------------------
+    template <typename result_ref_type>
+    class _result_awaiter
+    {
+        using result_type = std::remove_reference_t<result_ref_type>;
+
+    public:
+        auto await_ready() const -> bool
+        {
+            return awaited.is_value();
+        }
+
+        template <typename promise_type>
+        auto await_suspend(std::coroutine_handle<promise_type> handle) -> std::coroutine_handle<>
+        {
+            handle.promise().return_error(static_cast<result_ref_type>(awaited));
+            return handle.promise().complete();
+        }
+
+        auto await_resume() -> decltype(auto)
+        {
+            if constexpr (type_info<typename result_type::value_type>::is_void())
+                return;
+            else
+                return static_cast<result_ref_type>(awaited).get_value();
+        }
+
+    public:
+        result_ref_type awaited;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// awaits an `option` inside a task returning an `option`. if it's null, the task returns a
+    /// null option without resuming.
+    /// --------------------------------------------------------------------------------------------
+    template <typename option_ref_type>
+    class _option_awaiter
+    {
+    public:
+        auto await_ready() const -> bool
+        {
+            return awaited.is_value();
+        }
+
+        template <typename promise_type>
+        auto await_suspend(std::coroutine_handle<promise_type> handle) -> std::coroutine_handle<>
+        {
+            handle.promise().return_value(typename promise_type::value_type{});
+            return handle.promise().complete();
+        }
+
+        auto await_resume() -> decltype(auto)
+        {
+            return static_cast<option_ref_type>(awaited).get();
+        }
+
+    public:
+        option_ref_type awaited;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// promise of tasks returning a value.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_value_type>
+    class _task_promise: public _task_promise_base
+    {
+    public:
+        using value_type = in_value_type;
+
+    public:
+        auto get_return_object() -> task<value_type>
+        {
+            return task<value_type>{ std::coroutine_handle<_task_promise>::from_promise(*this) };
+        }
+
+        template <typename that_type>
+        auto return_value(that_type&& value) -> void
+            requires(type_info<value_type>::template is_constructible_from<that_type>())
+        {
+            _value.emplace(forward<that_type>(value));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// sets the error stored in `result` as the returned value.
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_result_type>
+        auto return_error(that_result_type&& result) -> void
+        {
+            _return_error(forward<that_result_type>(result),
+                typename std::remove_cvref_t<that_result_type>::error_types_list{});
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// awaiting a `result` short circuits on error, if this task returns a `result` which can
+        /// hold all of its errors.
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type>
+        auto await_transform(that_type&& awaitable) -> decltype(auto)
+        {
+            using that_pure_type = std::remove_cvref_t<that_type>;
+
+            if constexpr (type_info<that_pure_type>::template is_derived_from<result_tag>())
+            {
+                static_assert(type_info<value_type>::template is_derived_from<result_tag>(),
+                    "awaiting a result needs the task to return a result.");
+
+                static_assert(value_type::error_types_list::has_all(
+                                  typename that_pure_type::error_types_list{}),
+                    "the task's result can't hold all errors of the awaited result.");
+
+                return _result_awaiter<that_type&&>{ forward<that_type>(awaitable) };
+            }
+            else if constexpr (_is_option<that_pure_type>)
+            {
+                static_assert(_is_option<value_type>,
+                    "awaiting an option needs the task to return an option.");
+
+                return _option_awaiter<that_type&&>{ forward<that_type>(awaitable) };
+            }
+            else
+            {
+                return forward<that_type>(awaitable);
+            }
+        }
+
+        auto take_value() -> value_type
+        {
+            _rethrow_if_exception();
+
+            contract_debug_expects(_value.is_value(), "task didn't return a value.");
+
+            return move(_value.get());
+        }
+
+    private:
+        template <typename that_result_type, typename... error_types>
+        auto _return_error(that_result_type&& result, type_list<error_types...>) -> void
+        {
+            ((result.template is_error<error_types>()
+                 and (_value.emplace(
+                          forward<that_result_type>(result).template get_error<error_types>()),
+                     true))
+                or ...);
+        }
+
+    private:
+        option<value_type> _value;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// promise of tasks returning nothing.
+    /// --------------------------------------------------------------------------------------------
+    template <>
+    class _task_promise<void>: public _task_promise_base
+    {
+    public:
+        using value_type = void;
+
+    public:
+        auto get_return_object() -> task<void>;
+
+        auto return_void() -> void {}
+
+        auto take_value() -> void
+        {
+            _rethrow_if_exception();
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lets a thread which isn't running coroutines block until a task is done.
+    /// --------------------------------------------------------------------------------------------
+    class _sync_wait_event
+    {
+    public:
+        _sync_wait_event()
+            : _is_set{ false }
+        {}
+
+    public:
+        static auto set(void* context) -> void
+        {
+            _sync_wait_event& event = *static_cast<_sync_wait_event*>(context);
+
+            std::unique_lock lock{ event._mutex };
+            event._is_set = true;
+            event._cond.notify_all();
+        }
+
+        auto wait() -> void
+        {
+            std::unique_lock lock{ _mutex };
+            _cond.wait(lock, [&] { return _is_set; });
+        }
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _cond;
+        bool _is_set;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// awaitable returned by `schedule_on()`.
+    /// --------------------------------------------------------------------------------------------
+    class _schedule_awaiter
+    {
+    public:
+        auto await_ready() const -> bool
+        {
+            return false;
+        }
+
+        auto await_suspend(std::coroutine_handle<> handle) -> void
+        {
+            scheduler.spawn([handle] { handle.resume(); });
+        }
+
+        auto await_resume() const -> void {}
+
+    public:
+        task_scheduler& scheduler;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// lazy coroutine producing a `value_type`.
+    ///
+    /// the coroutine starts when the task is awaited, and resumes the awaiting coroutine when
+    /// done. inside a task returning a `result` or `option`, awaiting a `result` or `option`
+    /// returns the error or null right away, else gives its value.
+    ///
+    /// ```
+    /// auto parse_file(string_view path) -> task<result<config, parse_error, noentry_error>>
+    /// {
+    ///     string text = co_await read_text(path);
+    ///     co_return co_await parse(text);
+    /// }
+    /// ```
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type = void>
+    class task
+    {
+        using this_type = task;
+
+    public:
+        using value_type = in_value_type;
+        using promise_type = _task_promise<value_type>;
+
+    private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        class awaiter
+        {
+        public:
+            auto await_ready() const -> bool
+            {
+                return false;
+            }
+
+            auto await_suspend(std::coroutine_handle<> continuation) -> std::coroutine_handle<>
+            {
+                handle.promise().set_continuation(continuation);
+                return handle;
+            }
+
+            auto await_resume() -> value_type
+            {
+                return handle.promise().take_value();
+            }
+
+        public:
+            handle_type handle;
+        };
+
+        friend promise_type;
+
+        template <typename that_value_type>
+        friend auto sync_wait(task<that_value_type> target) -> that_value_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        task(const this_type& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(const this_type& that) -> this_type& = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move constructor
+        /// ----------------------------------------------------------------------------------------
+        task(this_type&& that)
+            : _handle{ std::exchange(that._handle, nullptr) }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(this_type&& that) -> this_type&
+        {
+            _destroy();
+            _handle = std::exchange(that._handle, nullptr);
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// destroys the coroutine, which must not be running.
+        /// ----------------------------------------------------------------------------------------
+        ~task()
+        {
+            _destroy();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// starts the task and suspends the awaiting coroutine until it's done.
+        ///
+        /// \returns the value returned by the task.
+        /// ----------------------------------------------------------------------------------------
+        auto operator co_await() && -> awaiter
+        {
+            contract_debug_expects(_handle, "task is moved.");
+            contract_debug_expects(not is_done(), "task is already done.");
+
+            return awaiter{ _handle };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if the task returned or short circuited on an error.
+        /// ----------------------------------------------------------------------------------------
+        auto is_done() const -> bool
+        {
+            return _handle and _handle.promise().is_done();
+        }
+
+    private:
+        explicit task(handle_type handle)
+            : _handle{ handle }
+        {}
+
+        auto _destroy() -> void
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+
+    private:
+        handle_type _handle;
+    };
+
+    auto _task_promise<void>::get_return_object() -> task<void>
+    {
+        return task<void>{ std::coroutine_handle<_task_promise>::from_promise(*this) };
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// runs `target` and blocks the calling thread until it's done.
+    ///
+    /// \returns the value returned by the task.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename value_type>
+    auto sync_wait(task<value_type> target) -> value_type
+    {
+        contract_debug_expects(target._handle, "task is moved.");
+
+        _sync_wait_event event;
+        target._handle.promise().set_on_done(&_sync_wait_event::set, &event);
+        target._handle.resume();
+        event.wait();
+
+        return target._handle.promise().take_value();
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns awaitable which resumes the awaiting coroutine on a worker of `scheduler`.
+    /// --------------------------------------------------------------------------------------------
+    export inline auto schedule_on(task_scheduler& scheduler) -> _schedule_awaiter
+    {
+        return _schedule_awaiter{ scheduler };
+    }
+}
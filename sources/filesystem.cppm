@@ -1,3 +1,6 @@
 export module atom_core:filesystem;
 
 export import :filesystem.file;
+export import :filesystem.mapped_file;
+export import :filesystem.fd_file;
+export import :filesystem.file_range;
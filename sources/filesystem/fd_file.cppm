@@ -0,0 +1,707 @@
+module;
+#include "atom/core/preprocessors.h"
+
+#include <cerrno>
+
+#if defined(ATOM_PLATFORM_POSIX)
+#    include <fcntl.h>
+#    include <limits.h>
+#    include <sys/stat.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
+export module atom_core:filesystem.fd_file;
+
+import std;
+import :core;
+import :contracts;
+import :ranges;
+import :strings;
+import :dynamic_buffer;
+import :filesystem.file;
+
+#if defined(ATOM_PLATFORM_POSIX)
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom::filesystem
+{
+    /// --------------------------------------------------------------------------------------------
+    /// writes all `parts` to `fd` using as few `writev` calls as possible, continuing after
+    /// partial writes and interrupts.
+    ///
+    /// \returns `0` on success, else the error number.
+    /// --------------------------------------------------------------------------------------------
+    inline auto _fd_write_parts(int fd, ::iovec* parts, usize count) -> i32
+    {
+        while (count > 0)
+        {
+            const int batch_count = int(std::min<usize>(count, IOV_MAX));
+            const isize written = ::writev(fd, parts, batch_count);
+
+            if (written == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                return errno;
+            }
+
+            // skip the parts written completely, and advance into the one written partially.
+            usize remaining = usize(written);
+            while (count > 0 and remaining >= parts->iov_len)
+            {
+                remaining -= parts->iov_len;
+                parts++;
+                count--;
+            }
+
+            if (count > 0)
+            {
+                parts->iov_base = static_cast<byte*>(parts->iov_base) + remaining;
+                parts->iov_len -= remaining;
+            }
+        }
+
+        return 0;
+    }
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom::filesystem
+{
+    /// --------------------------------------------------------------------------------------------
+    /// file accessed through a raw file descriptor, without stdio and its locking or buffering.
+    ///
+    /// reads and writes go directly to the os, use `fd_reader` and `fd_writer` to batch small
+    /// operations into a buffer owned by the caller. positional operations don't move the file
+    /// position, so they can be used from multiple threads at once.
+    /// --------------------------------------------------------------------------------------------
+    export class fd_file
+    {
+        using this_type = fd_file;
+
+    public:
+        using open_flags = file::open_flags;
+        using open_result = result<fd_file, filesystem_error, noentry_error, invalid_options_error>;
+        using read_result = result<usize, filesystem_error>;
+        using write_result = result<void, filesystem_error>;
+
+        /// ----------------------------------------------------------------------------------------
+        /// hints for the os about how the file will be accessed.
+        /// ----------------------------------------------------------------------------------------
+        enum class access_hint : byte
+        {
+            normal,     // no special treatment.
+            sequential, // read ahead aggressively.
+            random,     // don't read ahead.
+            will_need,  // start loading the data into the page cache now.
+            dont_need,  // the data can be dropped from the page cache.
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// initializes as closed.
+        /// ----------------------------------------------------------------------------------------
+        fd_file()
+            : _fd{ -1 }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// takes ownership of the open file descriptor `fd`.
+        /// ----------------------------------------------------------------------------------------
+        explicit fd_file(int fd)
+            : _fd{ fd }
+        {}
+
+        fd_file(const this_type& that) = delete;
+        fd_file& operator=(const this_type& that) = delete;
+
+        fd_file(this_type&& that)
+            : _fd{ that._fd }
+        {
+            that._fd = -1;
+        }
+
+        fd_file& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            if (not is_closed())
+                close();
+
+            _fd = that._fd;
+            that._fd = -1;
+            return *this;
+        }
+
+        ~fd_file()
+        {
+            if (not is_closed())
+                close();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// opens a file at `path` with access specified by `flags`, same as `file::open()`.
+        /// ----------------------------------------------------------------------------------------
+        static auto open(string_view path, open_flags flags) -> open_result
+        {
+            errno = 0;
+
+            const int os_flags = _get_os_flags(flags);
+            if (os_flags == -1)
+                return invalid_options_error{ "invalid flags combination." };
+
+            const int fd = ::open(path.get_data(), os_flags | O_CLOEXEC, 0666);
+            if (fd == -1)
+            {
+                if (errno == ENOENT)
+                    return noentry_error{ path };
+
+                return filesystem_error{ errno };
+            }
+
+            return fd_file{ fd };
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// closes the file.
+        /// ----------------------------------------------------------------------------------------
+        auto close() -> void
+        {
+            contract_expects(not is_closed(), "the file is closed.");
+
+            ::close(_fd);
+            _fd = -1;
+        }
+
+        auto is_closed() const -> bool
+        {
+            return _fd == -1;
+        }
+
+        auto get_native_handle() const -> int
+        {
+            return _fd;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reads up to `count` bytes into `data`, from the current position.
+        ///
+        /// \returns count of bytes read, `0` at the end of the file.
+        /// ----------------------------------------------------------------------------------------
+        auto read(byte* data, usize count) -> read_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            while (true)
+            {
+                const isize read_count = ::read(_fd, data, count);
+                if (read_count != -1)
+                    return usize(read_count);
+
+                if (errno != EINTR)
+                    return filesystem_error{ errno };
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reads up to `count` bytes into `data`, from `pos` without moving the current position.
+        ///
+        /// \returns count of bytes read, `0` at the end of the file.
+        /// ----------------------------------------------------------------------------------------
+        auto read_at(usize pos, byte* data, usize count) const -> read_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            while (true)
+            {
+                const isize read_count = ::pread(_fd, data, count, ::off_t(pos));
+                if (read_count != -1)
+                    return usize(read_count);
+
+                if (errno != EINTR)
+                    return filesystem_error{ errno };
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes all of `bytes` at the current position.
+        /// ----------------------------------------------------------------------------------------
+        auto write(memory_view bytes) -> write_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            ::iovec part = { const_cast<byte*>(bytes.get_data()), bytes.get_size() };
+            if (i32 error_no = _fd_write_parts(_fd, &part, 1); error_no != 0)
+                return filesystem_error{ error_no };
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes all of `bytes` at `pos` without moving the current position.
+        /// ----------------------------------------------------------------------------------------
+        auto write_at(usize pos, memory_view bytes) -> write_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            const byte* data = bytes.get_data();
+            usize remaining = bytes.get_size();
+            while (remaining > 0)
+            {
+                const isize written = ::pwrite(_fd, data, remaining, ::off_t(pos));
+                if (written == -1)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return filesystem_error{ errno };
+                }
+
+                data += written;
+                pos += usize(written);
+                remaining -= usize(written);
+            }
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes all `parts` one after another at the current position, with one `writev` call
+        /// unless the os writes them partially.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        auto write_parts(const range_type& parts) -> write_result
+            requires(ranges::const_array_range_concept<range_type, memory_view>)
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            static constexpr usize stack_count = 16;
+
+            const memory_view* views = ranges::get_data(parts);
+            const usize count = ranges::get_count(parts);
+
+            ::iovec stack_iovecs[stack_count];
+            dynamic_buffer heap_iovecs;
+            ::iovec* iovecs = stack_iovecs;
+            if (count > stack_count)
+            {
+                heap_iovecs.reserve(sizeof(::iovec) * count);
+                iovecs = reinterpret_cast<::iovec*>(heap_iovecs.get_data());
+            }
+
+            for (usize i = 0; i < count; i++)
+                iovecs[i] = { const_cast<byte*>(views[i].get_data()), views[i].get_size() };
+
+            if (i32 error_no = _fd_write_parts(_fd, iovecs, count); error_no != 0)
+                return filesystem_error{ error_no };
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns size of the file, queried with `fstat` without moving the current position.
+        /// ----------------------------------------------------------------------------------------
+        auto get_size() const -> read_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            struct stat info;
+            if (::fstat(_fd, &info) == -1)
+                return filesystem_error{ errno };
+
+            return usize(info.st_size);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns the current position.
+        /// ----------------------------------------------------------------------------------------
+        auto get_pos() const -> read_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            const ::off_t pos = ::lseek(_fd, 0, SEEK_CUR);
+            if (pos == -1)
+                return filesystem_error{ errno };
+
+            return usize(pos);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// sets the current position.
+        /// ----------------------------------------------------------------------------------------
+        auto set_pos(usize pos) -> write_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            if (::lseek(_fd, ::off_t(pos), SEEK_SET) == -1)
+                return filesystem_error{ errno };
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// hints the os how `count` bytes from `offset` will be accessed, `0` count means till
+        /// the end of the file. does nothing where `posix_fadvise` isn't available.
+        /// ----------------------------------------------------------------------------------------
+        auto advise(access_hint hint, usize offset = 0, usize count = 0) -> void
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+#    if defined(POSIX_FADV_NORMAL)
+            ::posix_fadvise(_fd, ::off_t(offset), ::off_t(count), _get_advice(hint));
+#    endif
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns flags for `::open()`, matching the modes used by `file::open()`. `-1` if the
+        /// combination is invalid.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto _get_os_flags(open_flags flags) -> int
+        {
+            // binary has no meaning on posix.
+            const open_flags access = flags & ~open_flags::binary;
+
+            const bool is_read = (access & open_flags::read) == open_flags::read;
+            const bool is_write = (access & open_flags::write) == open_flags::write;
+            const bool is_append = (access & open_flags::append) == open_flags::append;
+            const bool is_create = (access & open_flags::create) == open_flags::create;
+            const bool is_overwrite = (access & open_flags::overwrite) == open_flags::overwrite;
+
+            if (is_append)
+            {
+                if (is_create or is_overwrite or is_read != is_write)
+                    return -1;
+
+                return is_read ? O_RDWR | O_CREAT | O_APPEND : O_WRONLY | O_CREAT | O_APPEND;
+            }
+
+            if (is_create and is_overwrite)
+                return -1;
+
+            if (is_read and not is_write)
+                return is_create or is_overwrite ? -1 : O_RDONLY;
+
+            if (is_write and not is_read)
+                return O_WRONLY | O_CREAT | O_TRUNC;
+
+            if (is_read and is_write)
+                return is_create or is_overwrite ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR;
+
+            return -1;
+        }
+
+#    if defined(POSIX_FADV_NORMAL)
+        static auto _get_advice(access_hint hint) -> int
+        {
+            switch (hint)
+            {
+                case access_hint::sequential: return POSIX_FADV_SEQUENTIAL;
+                case access_hint::random:     return POSIX_FADV_RANDOM;
+                case access_hint::will_need:  return POSIX_FADV_WILLNEED;
+                case access_hint::dont_need:  return POSIX_FADV_DONTNEED;
+                default:                      return POSIX_FADV_NORMAL;
+            }
+        }
+#    endif
+
+    private:
+        int _fd;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// buffered reader over `fd_file`, using a buffer owned by the caller.
+    ///
+    /// small reads are served from the buffer, which is refilled with one `read` call. reads
+    /// bigger than the buffer go directly into the output.
+    /// --------------------------------------------------------------------------------------------
+    export class fd_reader
+    {
+        using this_type = fd_reader;
+
+    public:
+        using read_result = fd_file::read_result;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// initializes to read from `file` using `buffer`. both must outlive the reader.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        fd_reader(fd_file& file, range_type& buffer)
+            requires(ranges::array_range_concept<range_type, byte>)
+            : _file{ &file }
+            , _buffer{ ranges::get_data(buffer) }
+            , _capacity{ ranges::get_count(buffer) }
+            , _begin{ 0 }
+            , _end{ 0 }
+        {}
+
+        fd_reader(const this_type& that) = delete;
+        fd_reader& operator=(const this_type& that) = delete;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// reads up to `count` bytes into `data`.
+        ///
+        /// \returns count of bytes read, `0` at the end of the file.
+        /// ----------------------------------------------------------------------------------------
+        auto read(byte* data, usize count) -> read_result
+        {
+            if (_begin == _end)
+            {
+                if (count >= _capacity)
+                    return _file->read(data, count);
+
+                read_result result = _fill();
+                if (result.is_error() or result.get_value() == 0)
+                    return result;
+            }
+
+            const usize read_count = std::min(count, _end - _begin);
+            std::memcpy(data, _buffer + _begin, read_count);
+            _begin += read_count;
+            return read_count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns view over the buffered bytes, refilling the buffer if it's empty. the view is
+        /// empty at the end of the file, and is valid until the next read.
+        /// ----------------------------------------------------------------------------------------
+        auto peek() -> result<memory_view, filesystem_error>
+        {
+            if (_begin == _end)
+            {
+                read_result result = _fill();
+                if (result.is_error())
+                    return result.get_error<filesystem_error>();
+            }
+
+            return memory_view{ _buffer + _begin, _end - _begin };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// skips `count` bytes returned by `peek()`.
+        ///
+        /// \pre `count` is not more than bytes returned by `peek()`.
+        /// ----------------------------------------------------------------------------------------
+        auto consume(usize count) -> void
+        {
+            contract_debug_expects(count <= _end - _begin, "count is more than buffered bytes.");
+
+            _begin += count;
+        }
+
+    private:
+        auto _fill() -> read_result
+        {
+            _begin = 0;
+            _end = 0;
+
+            read_result result = _file->read(_buffer, _capacity);
+            if (result.is_value())
+                _end = result.get_value();
+
+            return result;
+        }
+
+    private:
+        fd_file* _file;
+        byte* _buffer;
+        usize _capacity;
+        usize _begin;
+        usize _end;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// buffered writer over `fd_file`, using a buffer owned by the caller.
+    ///
+    /// writes are copied into the buffer, which is written with one syscall when full. a write
+    /// that doesn't fit is written together with the buffered bytes using `writev`, instead of
+    /// flushing first.
+    ///
+    /// to keep formatting cheap, writes don't return errors. the first error stops all later
+    /// writes and is returned by `flush()`.
+    ///
+    /// \note the destructor flushes, but ignores errors. call `flush()` to check them.
+    /// --------------------------------------------------------------------------------------------
+    export class fd_writer
+    {
+        using this_type = fd_writer;
+
+    public:
+        using write_result = fd_file::write_result;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// initializes to write to `file` using `buffer`. both must outlive the writer.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        fd_writer(fd_file& file, range_type& buffer)
+            requires(ranges::array_range_concept<range_type, byte>)
+            : _file{ &file }
+            , _buffer{ ranges::get_data(buffer) }
+            , _capacity{ ranges::get_count(buffer) }
+            , _count{ 0 }
+            , _error_no{ 0 }
+        {}
+
+        fd_writer(const this_type& that) = delete;
+        fd_writer& operator=(const this_type& that) = delete;
+
+        ~fd_writer()
+        {
+            flush();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// writes `bytes`.
+        /// ----------------------------------------------------------------------------------------
+        auto write_bytes(memory_view bytes) -> void
+        {
+            _write(bytes.get_data(), bytes.get_size(), nullptr, 0);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes `str`.
+        /// ----------------------------------------------------------------------------------------
+        auto write_str(string_view str) -> void
+        {
+            _write(str.get_data(), str.get_count(), nullptr, 0);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes `str` followed by a new line character.
+        /// ----------------------------------------------------------------------------------------
+        auto write_line_str(string_view str) -> void
+        {
+            _write(str.get_data(), str.get_count(), "\n", 1);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes a formatted string.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto write_fmt(format_string<arg_types...> fmt, arg_types&&... args) -> void
+        {
+            _format_to(*this, fmt, forward<arg_types>(args)...);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes a formatted string followed by a new line character.
+        ///
+        /// the end of the line stays in the buffer, so it's written with the new line in the same
+        /// syscall. lines which fit in the buffer are written whole with their new line.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto write_line_fmt(format_string<arg_types...> fmt, arg_types&&... args) -> void
+        {
+            _format_to(_buffered_output{ this }, fmt, forward<arg_types>(args)...);
+            _write("\n", 1, nullptr, 0);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes the buffered bytes to the file.
+        ///
+        /// \returns the first error occurred since the writer was created.
+        /// ----------------------------------------------------------------------------------------
+        auto flush() -> write_result
+        {
+            if (_error_no == 0 and _count > 0)
+            {
+                ::iovec part = { _buffer, _count };
+                _error_no = _fd_write_parts(_file->get_native_handle(), &part, 1);
+                _count = 0;
+            }
+
+            if (_error_no != 0)
+                return filesystem_error{ _error_no };
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of bytes written to the buffer but not to the file yet.
+        /// ----------------------------------------------------------------------------------------
+        auto get_buffered_count() const -> usize
+        {
+            return _count;
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// output for formatting, which keeps each formatted chunk in the buffer instead of
+        /// writing it directly when the buffer is full.
+        /// ----------------------------------------------------------------------------------------
+        class _buffered_output
+        {
+        public:
+            auto write_str(string_view str) -> void
+            {
+                writer->_write_buffered(str.get_data(), str.get_count());
+            }
+
+        public:
+            fd_writer* writer;
+        };
+
+        /// ----------------------------------------------------------------------------------------
+        /// copies `count` bytes at `data` into the buffer, writing the buffered bytes first if
+        /// they don't fit. bytes bigger than the buffer are written directly.
+        /// ----------------------------------------------------------------------------------------
+        auto _write_buffered(const void* data, usize count) -> void
+        {
+            if (_count + count > _capacity and count <= _capacity)
+                flush();
+
+            _write(data, count, nullptr, 0);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes `count` bytes at `data` followed by `suffix_count` bytes at `suffix`.
+        /// ----------------------------------------------------------------------------------------
+        auto _write(const void* data, usize count, const void* suffix, usize suffix_count) -> void
+        {
+            if (_error_no != 0)
+                return;
+
+            if (_count + count + suffix_count <= _capacity)
+            {
+                std::memcpy(_buffer + _count, data, count);
+                if (suffix_count > 0)
+                    std::memcpy(_buffer + _count + count, suffix, suffix_count);
+                _count += count + suffix_count;
+                return;
+            }
+
+            ::iovec parts[] = {
+                { _buffer, _count },
+                { const_cast<void*>(data), count },
+                { const_cast<void*>(suffix), suffix_count },
+            };
+
+            _error_no = _fd_write_parts(_file->get_native_handle(), parts, 3);
+            _count = 0;
+        }
+
+    private:
+        fd_file* _file;
+        byte* _buffer;
+        usize _capacity;
+        usize _count;
+        i32 _error_no;
+    };
+}
+
+#endif
@@ -68,6 +68,10 @@ namespace atom::filesystem
         string path;
     };
 
+    export class mapped_file;
+    export class file_chunk_range;
+    export class file_record_range;
+
     /// --------------------------------------------------------------------------------------------
     ///
     /// --------------------------------------------------------------------------------------------
@@ -221,6 +225,36 @@ namespace atom::filesystem
             return content;
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// reads up to `count` bytes into `data` from the current position.
+        ///
+        /// \returns count of bytes read, less than `count` only at the end of the file.
+        /// ----------------------------------------------------------------------------------------
+        auto read_bytes(byte* data, usize count) -> usize
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            usize read_count = std::fread(data, sizeof(byte), count, _file);
+
+            // a short read is either the end of the file or an error, ranges reading in chunks
+            // would otherwise end silently on errors.
+            if (read_count < count)
+                contract_asserts(std::ferror(_file) == 0, "failed to read the file.");
+
+            return read_count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// maps the whole file into memory, for reading and also writing if the file is open for
+        /// both. pipes and other files which can't be mapped are read into a buffer instead.
+        ///
+        /// the mapping stays valid after the file is closed.
+        ///
+        /// \note files open only for writing can't be mapped, as mappings are always readable.
+        ///     fails with `EACCES` for them.
+        /// ----------------------------------------------------------------------------------------
+        auto map() -> result<mapped_file, filesystem_error>;
+
         /// ----------------------------------------------------------------------------------------
         /// writes bytes to the file.
         /// ----------------------------------------------------------------------------------------
@@ -299,8 +333,7 @@ namespace atom::filesystem
         {
             contract_debug_expects(not is_closed(), "the file is closed.");
 
-            fmt::print(_file, _convert_format_string_atom_to_fmt<arg_types...>(fmt),
-                format_arg_wrapper(forward<arg_types>(args))...);
+            _format_to(*this, fmt, forward<arg_types>(args)...);
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -311,8 +344,8 @@ namespace atom::filesystem
         {
             contract_debug_expects(not is_closed(), "the file is closed.");
 
-            fmt::println(_file, _convert_format_string_atom_to_fmt<arg_types...>(fmt),
-                format_arg_wrapper(forward<arg_types>(args))...);
+            _format_to(*this, fmt, forward<arg_types>(args)...);
+            std::fputc('\n', _file);
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -463,12 +496,28 @@ namespace atom::filesystem
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// returns a wrapper to treat file contents as a range.
+        /// returns a range over the contents from the current position, in chunks of up to
+        /// `chunk_size` bytes read into one reusable buffer.
+        ///
+        /// \note the file must outlive the range.
         /// ----------------------------------------------------------------------------------------
-        auto as_range() -> decltype(auto)
-        {
-            contract_debug_expects(not is_closed(), "the file is closed.");
-        }
+        auto as_range(usize chunk_size = 64 * 1024) -> file_chunk_range;
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns a range over the lines from the current position, without the new line
+        /// characters. the buffer only grows to fit the longest line.
+        ///
+        /// \note the file must outlive the range.
+        /// ----------------------------------------------------------------------------------------
+        auto as_lines() -> file_record_range;
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns a range over the records separated by `delim` from the current position,
+        /// without the delimiters. the buffer only grows to fit the longest record.
+        ///
+        /// \note the file must outlive the range.
+        /// ----------------------------------------------------------------------------------------
+        auto as_records(char delim) -> file_record_range;
 
     private:
         /// ----------------------------------------------------------------------------------------
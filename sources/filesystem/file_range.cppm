@@ -0,0 +1,366 @@
+export module atom_core:filesystem.file_range;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :ranges;
+import :ranges.byte_search;
+import :containers;
+import :strings;
+import :dynamic_buffer;
+import :filesystem.file;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom::filesystem
+{
+    /// --------------------------------------------------------------------------------------------
+    /// end iterator for `file_chunk_range` and `file_record_range`.
+    /// --------------------------------------------------------------------------------------------
+    class _file_range_iterator_end
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// input iterator over a file range, reading the next item only when advanced to it.
+    ///
+    /// all iterators of a range share its buffer, so only one item is valid at a time.
+    /// --------------------------------------------------------------------------------------------
+    template <typename range_type, typename in_value_type>
+    class _file_range_iterator
+    {
+        using this_type = _file_range_iterator;
+
+    public:
+        using value_type = in_value_type;
+        using difference_type = isize;
+        using iterator_category = std::input_iterator_tag;
+
+    public:
+        constexpr _file_range_iterator()
+            : _range{ nullptr }
+            , _current{}
+        {}
+
+        _file_range_iterator(range_type* range)
+            : _range{ range }
+            , _current{}
+        {
+            _advance();
+        }
+
+    public:
+        auto operator*() const -> const value_type&
+        {
+            return _current;
+        }
+
+        auto operator->() const -> const value_type*
+        {
+            return &_current;
+        }
+
+        auto operator++() -> this_type&
+        {
+            _advance();
+            return *this;
+        }
+
+        auto operator++(int) -> void
+        {
+            _advance();
+        }
+
+        auto operator==(const this_type& that) const -> bool
+        {
+            return _range == that._range;
+        }
+
+        auto operator==(const _file_range_iterator_end& that) const -> bool
+        {
+            return _range == nullptr;
+        }
+
+    private:
+        auto _advance() -> void
+        {
+            if (not _range->_read_next(_current))
+                _range = nullptr;
+        }
+
+    private:
+        range_type* _range;
+        value_type _current;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom::filesystem
+{
+    export class file_range_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// range over the contents of a `file` in chunks, each read into the same buffer.
+    ///
+    /// every chunk has `get_chunk_size()` bytes, except the last one which can be smaller. the
+    /// memory used stays the same however large the file is.
+    /// --------------------------------------------------------------------------------------------
+    export class file_chunk_range: public file_range_tag
+    {
+        using this_type = file_chunk_range;
+
+        template <typename range_type, typename value_type>
+        friend class _file_range_iterator;
+
+    public:
+        using value_type = array_view<byte>;
+        using iterator_type = _file_range_iterator<this_type, value_type>;
+        using iterator_end_type = _file_range_iterator_end;
+
+    public:
+        file_chunk_range(file& file, usize chunk_size)
+            : _file{ &file }
+            , _buffer{ create_with_size, chunk_size }
+        {
+            contract_expects(chunk_size > 0, "chunk size is zero.");
+        }
+
+        file_chunk_range(const this_type& that) = delete;
+        file_chunk_range& operator=(const this_type& that) = delete;
+
+        file_chunk_range(this_type&& that) = default;
+        file_chunk_range& operator=(this_type&& that) = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// reads the first chunk and returns iterator to it. the range can be iterated only once.
+        /// ----------------------------------------------------------------------------------------
+        auto get_iterator() -> iterator_type
+        {
+            return iterator_type{ this };
+        }
+
+        auto get_iterator_end() -> iterator_end_type
+        {
+            return iterator_end_type{};
+        }
+
+        auto get_chunk_size() const -> usize
+        {
+            return _buffer.get_size();
+        }
+
+    private:
+        auto _read_next(value_type& chunk) -> bool
+        {
+            const usize count = _file->read_bytes(_buffer.get_data(), _buffer.get_size());
+            if (count == 0)
+                return false;
+
+            chunk = value_type{ ranges::from(static_cast<const byte*>(_buffer.get_data()), count) };
+            return true;
+        }
+
+    private:
+        file* _file;
+        dynamic_buffer _buffer;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// range over the records of a `file` separated by a delimiter, like lines separated by `\n`.
+    ///
+    /// the file is read in blocks into one buffer and records are yielded as views into it,
+    /// without copying or allocating each one. the buffer grows only if a record doesn't fit, so
+    /// the memory used is bounded by the longest record and not by the size of the file.
+    ///
+    /// a delimiter at the end of the file doesn't make an empty record after it.
+    /// --------------------------------------------------------------------------------------------
+    export class file_record_range: public file_range_tag
+    {
+        using this_type = file_record_range;
+
+        template <typename range_type, typename value_type>
+        friend class _file_range_iterator;
+
+    public:
+        using value_type = string_view;
+        using iterator_type = _file_range_iterator<this_type, value_type>;
+        using iterator_end_type = _file_range_iterator_end;
+
+        static constexpr usize default_block_size = 64 * 1024;
+
+    public:
+        file_record_range(file& file, char delim, usize block_size = default_block_size)
+            : _file{ &file }
+            , _buffer{ create_with_size, block_size }
+            , _delim{ delim }
+            , _begin{ 0 }
+            , _scanned{ 0 }
+            , _end{ 0 }
+            , _is_eof{ false }
+        {
+            contract_expects(block_size > 0, "block size is zero.");
+        }
+
+        file_record_range(const this_type& that) = delete;
+        file_record_range& operator=(const this_type& that) = delete;
+
+        file_record_range(this_type&& that) = default;
+        file_record_range& operator=(this_type&& that) = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// reads the first record and returns iterator to it. the range can be iterated only once.
+        /// ----------------------------------------------------------------------------------------
+        auto get_iterator() -> iterator_type
+        {
+            return iterator_type{ this };
+        }
+
+        auto get_iterator_end() -> iterator_end_type
+        {
+            return iterator_end_type{};
+        }
+
+        auto get_delim() const -> char
+        {
+            return _delim;
+        }
+
+    private:
+        auto _read_next(value_type& record) -> bool
+        {
+            while (true)
+            {
+                const u8* data = reinterpret_cast<const u8*>(_buffer.get_data());
+                const usize found = _get_byte_search_kernels().find_byte(
+                    data + _scanned, _end - _scanned, u8(_delim));
+
+                if (found != _end - _scanned)
+                {
+                    const usize delim_pos = _scanned + found;
+                    record = _get_view(_begin, delim_pos);
+                    _begin = delim_pos + 1;
+                    _scanned = _begin;
+                    return true;
+                }
+
+                _scanned = _end;
+
+                if (_is_eof)
+                {
+                    if (_begin == _end)
+                        return false;
+
+                    record = _get_view(_begin, _end);
+                    _begin = _end;
+                    return true;
+                }
+
+                _fill();
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves the unfinished record to the front, grows the buffer if the record fills it and
+        /// reads more after it.
+        /// ----------------------------------------------------------------------------------------
+        auto _fill() -> void
+        {
+            byte* data = _buffer.get_data();
+            const usize pending = _end - _begin;
+
+            if (_begin > 0)
+            {
+                std::memmove(data, data + _begin, pending);
+                _scanned -= _begin;
+                _end = pending;
+                _begin = 0;
+            }
+
+            if (_end == _buffer.get_size())
+            {
+                _buffer.reserve(_buffer.get_size() * 2);
+                _buffer.set_size(_buffer.get_capacity());
+                data = _buffer.get_data();
+            }
+
+            const usize count = _file->read_bytes(data + _end, _buffer.get_size() - _end);
+            if (count == 0)
+                _is_eof = true;
+
+            _end += count;
+        }
+
+        auto _get_view(usize begin, usize end) const -> string_view
+        {
+            const char* data = reinterpret_cast<const char*>(_buffer.get_data());
+            return string_view{ ranges::from(data + begin, end - begin) };
+        }
+
+    private:
+        file* _file;
+        dynamic_buffer _buffer;
+        char _delim;
+
+        /// start of the current record.
+        usize _begin;
+
+        /// bytes before this are searched and have no delimiter.
+        usize _scanned;
+
+        /// end of the bytes read.
+        usize _end;
+
+        bool _is_eof;
+    };
+
+    auto file::as_range(usize chunk_size) -> file_chunk_range
+    {
+        contract_debug_expects(not is_closed(), "the file is closed.");
+
+        return file_chunk_range{ *this, chunk_size };
+    }
+
+    auto file::as_lines() -> file_record_range
+    {
+        contract_debug_expects(not is_closed(), "the file is closed.");
+
+        return file_record_range{ *this, '\n' };
+    }
+
+    auto file::as_records(char delim) -> file_record_range
+    {
+        contract_debug_expects(not is_closed(), "the file is closed.");
+
+        return file_record_range{ *this, delim };
+    }
+}
+
+namespace atom
+{
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<filesystem::file_range_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using iterator_type = typename range_type::iterator_type;
+        using iterator_end_type = typename range_type::iterator_end_type;
+
+    public:
+        static auto get_iterator(range_type& range) -> iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static auto get_iterator_end(range_type& range) -> iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
@@ -0,0 +1,443 @@
+module;
+#include "atom/core/preprocessors.h"
+
+#include <cerrno>
+#include <cstdio>
+
+#if defined(ATOM_PLATFORM_POSIX)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+export module atom_core:filesystem.mapped_file;
+
+import std;
+import :core;
+import :contracts;
+import :ranges;
+import :containers;
+import :strings;
+import :dynamic_buffer;
+import :filesystem.file;
+
+namespace atom::filesystem
+{
+    /// --------------------------------------------------------------------------------------------
+    /// view over the contents of a file, mapped into memory instead of being copied.
+    ///
+    /// pages are loaded by the os when first accessed and can be dropped under memory pressure, so
+    /// large files don't need to be read upfront or fit into memory twice.
+    ///
+    /// files which can't be mapped, like pipes and character devices, are read into a buffer
+    /// instead, if opened for reading only. `is_mapped()` tells which one was used.
+    /// --------------------------------------------------------------------------------------------
+    export class mapped_file
+    {
+        friend class file;
+        using this_type = mapped_file;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// access to the mapped memory. writes to memory mapped with `read_write` are written to
+        /// the file.
+        /// ----------------------------------------------------------------------------------------
+        enum class access : byte
+        {
+            read,
+            read_write,
+        };
+
+        /// ----------------------------------------------------------------------------------------
+        /// hints for the os about how the mapped memory will be accessed.
+        /// ----------------------------------------------------------------------------------------
+        enum class access_hint : byte
+        {
+            normal,     // no special treatment.
+            sequential, // read ahead aggressively and drop pages soon after they are accessed.
+            random,     // don't read ahead.
+            will_need,  // start loading the pages now.
+        };
+
+        using open_result = result<mapped_file, filesystem_error, noentry_error>;
+        using map_result = result<mapped_file, filesystem_error>;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// initializes as closed.
+        /// ----------------------------------------------------------------------------------------
+        mapped_file()
+            : _data{ nullptr }
+            , _size{ 0 }
+            , _access{ access::read }
+            , _is_open{ false }
+            , _is_mapped{ false }
+            , _buffer{}
+        {}
+
+        mapped_file(const this_type& that) = delete;
+        mapped_file& operator=(const this_type& that) = delete;
+
+        mapped_file(this_type&& that)
+            : _data{ that._data }
+            , _size{ that._size }
+            , _access{ that._access }
+            , _is_open{ that._is_open }
+            , _is_mapped{ that._is_mapped }
+            , _buffer{ move(that._buffer) }
+        {
+            that._reset();
+        }
+
+        mapped_file& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            if (_is_open)
+                close();
+
+            _data = that._data;
+            _size = that._size;
+            _access = that._access;
+            _is_open = that._is_open;
+            _is_mapped = that._is_mapped;
+            _buffer = move(that._buffer);
+
+            that._reset();
+            return *this;
+        }
+
+        ~mapped_file()
+        {
+            if (_is_open)
+                close();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// maps the whole file at `path` with `map_access`.
+        /// ----------------------------------------------------------------------------------------
+        static auto open(string_view path, access map_access = access::read) -> open_result
+        {
+            errno = 0;
+
+#if defined(ATOM_PLATFORM_POSIX)
+            const int flags = (map_access == access::read ? O_RDONLY : O_RDWR) | O_CLOEXEC;
+            const int fd = ::open(path.get_data(), flags);
+            if (fd == -1)
+            {
+                if (errno == ENOENT)
+                    return noentry_error{ path };
+
+                return filesystem_error{ errno };
+            }
+
+            // the mapping keeps its own reference to the file, so the fd isn't needed after.
+            map_result result = _map_fd(fd, map_access);
+            ::close(fd);
+#else
+            if (map_access != access::read)
+                return filesystem_error{ ENOTSUP };
+
+            file::open_result file_result =
+                file::open(path, file::open_flags::read | file::open_flags::binary);
+
+            if (file_result.is_error<noentry_error>())
+                return file_result.get_error<noentry_error>();
+
+            if (file_result.is_error())
+                return filesystem_error{ EINVAL };
+
+            map_result result = file_result.get_value().map();
+#endif
+
+            if (result.is_error())
+                return result.get_error<filesystem_error>();
+
+            return move(result.get_value());
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns pointer to the first byte.
+        /// ----------------------------------------------------------------------------------------
+        auto get_data() const -> const byte*
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            return _data;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns pointer to the first byte, for writing.
+        ///
+        /// \pre the file was mapped with `access::read_write`.
+        /// ----------------------------------------------------------------------------------------
+        auto get_mut_data() -> byte*
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+            contract_debug_expects(_access == access::read_write, "the file is mapped read only.");
+
+            return _data;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of bytes mapped, which is the size of the file when it was mapped.
+        /// ----------------------------------------------------------------------------------------
+        auto get_size() const -> usize
+        {
+            return _size;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns view over the bytes.
+        /// ----------------------------------------------------------------------------------------
+        auto get_bytes() const -> array_view<byte>
+        {
+            return array_view<byte>{ ranges::from(static_cast<const byte*>(_data), _size) };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns view over the bytes as chars.
+        /// ----------------------------------------------------------------------------------------
+        auto get_str() const -> string_view
+        {
+            return string_view{ ranges::from(reinterpret_cast<const char*>(_data), _size) };
+        }
+
+        auto get_access() const -> access
+        {
+            return _access;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if the contents are mapped, `false` if they were read into a buffer.
+        /// ----------------------------------------------------------------------------------------
+        auto is_mapped() const -> bool
+        {
+            return _is_mapped;
+        }
+
+        auto is_closed() const -> bool
+        {
+            return not _is_open;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// hints the os how the whole mapping will be accessed. does nothing if not mapped.
+        /// ----------------------------------------------------------------------------------------
+        auto advise(access_hint hint) -> void
+        {
+            advise(hint, 0, _size);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// hints the os how `count` bytes from `offset` will be accessed. the range is widened to
+        /// page boundaries. does nothing if not mapped.
+        ///
+        /// \pre `offset + count <= get_size()`.
+        /// ----------------------------------------------------------------------------------------
+        auto advise(access_hint hint, usize offset, usize count) -> void
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+            contract_debug_expects(offset + count <= _size, "range is out of the mapping.");
+
+#if defined(ATOM_PLATFORM_POSIX)
+            if (not _is_mapped or count == 0)
+                return;
+
+            const usize page_size = usize(::sysconf(_SC_PAGESIZE));
+            const usize begin = offset & ~(page_size - 1);
+            ::madvise(_data + begin, offset + count - begin, _get_advice(hint));
+#endif
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes the changes made to the mapped memory to the file, waiting for them to finish.
+        /// does nothing if mapped for reading only.
+        /// ----------------------------------------------------------------------------------------
+        auto flush() -> result<void, filesystem_error>
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+#if defined(ATOM_PLATFORM_POSIX)
+            if (_is_mapped and _access == access::read_write)
+            {
+                if (::msync(_data, _size, MS_SYNC) == -1)
+                    return filesystem_error{ errno };
+            }
+#endif
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// unmaps the memory, or frees the buffer. all views taken from this are invalidated.
+        /// ----------------------------------------------------------------------------------------
+        auto close() -> void
+        {
+            contract_expects(not is_closed(), "the file is closed.");
+
+#if defined(ATOM_PLATFORM_POSIX)
+            if (_is_mapped)
+                ::munmap(_data, _size);
+#endif
+
+            _buffer.release();
+            _reset();
+        }
+
+    private:
+        mapped_file(byte* data, usize size, access map_access, bool is_mapped)
+            : _data{ data }
+            , _size{ size }
+            , _access{ map_access }
+            , _is_open{ true }
+            , _is_mapped{ is_mapped }
+            , _buffer{}
+        {}
+
+        mapped_file(dynamic_buffer buffer)
+            : _data{ nullptr }
+            , _size{ buffer.get_size() }
+            , _access{ access::read }
+            , _is_open{ true }
+            , _is_mapped{ false }
+            , _buffer{ move(buffer) }
+        {
+            _data = _buffer.get_data();
+        }
+
+        auto _reset() -> void
+        {
+            _data = nullptr;
+            _size = 0;
+            _is_open = false;
+            _is_mapped = false;
+        }
+
+#if defined(ATOM_PLATFORM_POSIX)
+        /// ----------------------------------------------------------------------------------------
+        /// maps the file open as `fd`, or reads it if it's not a regular file.
+        /// ----------------------------------------------------------------------------------------
+        static auto _map_fd(int fd, access map_access) -> map_result
+        {
+            struct stat info;
+            if (::fstat(fd, &info) == -1)
+                return filesystem_error{ errno };
+
+            if (not S_ISREG(info.st_mode))
+                return _read_fd(fd, map_access);
+
+            const usize size = usize(info.st_size);
+
+            // mapping zero bytes fails, there is nothing to map anyway.
+            if (size == 0)
+                return mapped_file{ nullptr, 0, map_access, false };
+
+            const int prot = map_access == access::read ? PROT_READ : PROT_READ | PROT_WRITE;
+            void* data = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                // some filesystems don't support mapping.
+                if (errno == ENODEV)
+                    return _read_fd(fd, map_access);
+
+                return filesystem_error{ errno };
+            }
+
+            return mapped_file{ static_cast<byte*>(data), size, map_access, true };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reads from `fd` until its end, for files whose size isn't known upfront.
+        /// ----------------------------------------------------------------------------------------
+        static auto _read_fd(int fd, access map_access) -> map_result
+        {
+            // writes to a buffer would never reach the file.
+            if (map_access != access::read)
+                return filesystem_error{ ENODEV };
+
+            static constexpr usize chunk_size = 64 * 1024;
+
+            dynamic_buffer buffer;
+            usize size = 0;
+            while (true)
+            {
+                buffer.reserve(size + chunk_size);
+
+                const isize read_count =
+                    ::read(fd, buffer.get_data() + size, buffer.get_capacity() - size);
+
+                if (read_count == -1)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return filesystem_error{ errno };
+                }
+
+                if (read_count == 0)
+                    break;
+
+                size += usize(read_count);
+                buffer.set_size(size);
+            }
+
+            return mapped_file{ move(buffer) };
+        }
+
+        static auto _get_advice(access_hint hint) -> int
+        {
+            switch (hint)
+            {
+                case access_hint::sequential: return MADV_SEQUENTIAL;
+                case access_hint::random:     return MADV_RANDOM;
+                case access_hint::will_need:  return MADV_WILLNEED;
+                default:                      return MADV_NORMAL;
+            }
+        }
+#endif
+
+    private:
+        byte* _data;
+        usize _size;
+        access _access;
+        bool _is_open;
+        bool _is_mapped;
+        dynamic_buffer _buffer;
+    };
+
+    auto file::map() -> result<mapped_file, filesystem_error>
+    {
+        contract_expects(not is_closed(), "the file is closed.");
+
+        // `mmap()` needs a readable descriptor, even for write only mappings.
+        if (not can_read())
+            return filesystem_error{ EACCES };
+
+        using access = mapped_file::access;
+        const access map_access =
+            can_read() and can_write() ? access::read_write : access::read;
+
+        // writes still in the stdio buffer would not be seen in the mapping.
+        std::fflush(_file);
+
+#if defined(ATOM_PLATFORM_POSIX)
+        return mapped_file::_map_fd(::fileno(_file), map_access);
+#else
+        if (map_access != access::read)
+            return filesystem_error{ ENOTSUP };
+
+        const usize pos = get_pos();
+        dynamic_buffer buffer = read_bytes_all();
+        set_pos(pos);
+
+        return mapped_file{ move(buffer) };
+#endif
+    }
+}
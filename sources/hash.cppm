@@ -1,25 +1,4 @@
 export module atom_core:hash;
 
-import std;
-import :strings;
-
-namespace std
-{
-    export template <>
-    struct hash<atom::string>
-    {
-        constexpr auto operator()(const atom::string& str) const -> std::size_t
-        {
-            return hash<std::string_view>()(str);
-        }
-    };
-
-    export template <>
-    struct hash<atom::string_view>
-    {
-        constexpr auto operator()(const atom::string_view& str) const -> std::size_t
-        {
-            return hash<std::string_view>()(str);
-        }
-    };
-}
+export import :hash.hasher;
+export import :hash.range_hasher;
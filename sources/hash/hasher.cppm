@@ -0,0 +1,399 @@
+export module atom_core:hash.hasher;
+
+import std;
+import :core;
+import :types;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// wyhash, a fast 64 bit hash passing smhasher. all inputs go through `_wymix`, a 64 x 64 bit
+    /// multiply folding both halves of the 128 bit product.
+    /// --------------------------------------------------------------------------------------------
+    constexpr u64 _wyhash_secret[] = {
+        0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+    };
+
+    constexpr auto _wymum(u64& lhs, u64& rhs) -> void
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 product = lhs;
+        product *= rhs;
+        lhs = u64(product);
+        rhs = u64(product >> 64);
+#else
+        const u64 lhs_hi = lhs >> 32;
+        const u64 lhs_lo = u32(lhs);
+        const u64 rhs_hi = rhs >> 32;
+        const u64 rhs_lo = u32(rhs);
+
+        const u64 hi_hi = lhs_hi * rhs_hi;
+        const u64 hi_lo = lhs_hi * rhs_lo;
+        const u64 lo_hi = lhs_lo * rhs_hi;
+        const u64 lo_lo = lhs_lo * rhs_lo;
+
+        const u64 mid = hi_lo + (lo_lo >> 32) + u32(lo_hi);
+        lhs = (mid << 32) | u32(lo_lo);
+        rhs = hi_hi + (mid >> 32) + (lo_hi >> 32);
+#endif
+    }
+
+    constexpr auto _wymix(u64 lhs, u64 rhs) -> u64
+    {
+        _wymum(lhs, rhs);
+        return lhs ^ rhs;
+    }
+
+    inline auto _wyread8(const u8* data) -> u64
+    {
+        u64 value;
+        std::memcpy(&value, data, 8);
+        return value;
+    }
+
+    inline auto _wyread4(const u8* data) -> u64
+    {
+        u32 value;
+        std::memcpy(&value, data, 4);
+        return value;
+    }
+
+    /// reads 1 to 3 bytes.
+    inline auto _wyread3(const u8* data, usize count) -> u64
+    {
+        return (u64(data[0]) << 16) | (u64(data[count >> 1]) << 8) | u64(data[count - 1]);
+    }
+
+    inline auto _wyhash(const u8* data, usize count, u64 seed) -> u64
+    {
+        seed ^= _wymix(seed ^ _wyhash_secret[0], _wyhash_secret[1]);
+
+        u64 a;
+        u64 b;
+
+        if (count <= 16)
+        {
+            if (count >= 4)
+            {
+                const usize offset = (count >> 3) << 2;
+                a = (_wyread4(data) << 32) | _wyread4(data + offset);
+                b = (_wyread4(data + count - 4) << 32) | _wyread4(data + count - 4 - offset);
+            }
+            else if (count > 0)
+            {
+                a = _wyread3(data, count);
+                b = 0;
+            }
+            else
+            {
+                a = 0;
+                b = 0;
+            }
+        }
+        else
+        {
+            usize remaining = count;
+
+            // long inputs are consumed by 3 independent lanes, so the multiplies of each 48 bytes
+            // run in parallel.
+            if (remaining > 48)
+            {
+                u64 seed1 = seed;
+                u64 seed2 = seed;
+
+                do
+                {
+                    seed = _wymix(_wyread8(data) ^ _wyhash_secret[1], _wyread8(data + 8) ^ seed);
+                    seed1 = _wymix(
+                        _wyread8(data + 16) ^ _wyhash_secret[2], _wyread8(data + 24) ^ seed1);
+                    seed2 = _wymix(
+                        _wyread8(data + 32) ^ _wyhash_secret[3], _wyread8(data + 40) ^ seed2);
+
+                    data += 48;
+                    remaining -= 48;
+                } while (remaining > 48);
+
+                seed ^= seed1 ^ seed2;
+            }
+
+            while (remaining > 16)
+            {
+                seed = _wymix(_wyread8(data) ^ _wyhash_secret[1], _wyread8(data + 8) ^ seed);
+                data += 16;
+                remaining -= 16;
+            }
+
+            a = _wyread8(data + remaining - 16);
+            b = _wyread8(data + remaining - 8);
+        }
+
+        a ^= _wyhash_secret[1];
+        b ^= seed;
+        _wymum(a, b);
+
+        return _wymix(a ^ _wyhash_secret[0] ^ count, b ^ _wyhash_secret[1]);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// creates the process seed from `std::random_device`, mixed with the address of a static and
+    /// the time, in case the device is deterministic.
+    /// --------------------------------------------------------------------------------------------
+    inline auto _create_hash_seed() -> u64
+    {
+        static const int anchor = 0;
+
+        std::random_device device;
+        const u64 random = (u64(device()) << 32) | u64(device());
+        const u64 address = u64(reinterpret_cast<std::uintptr_t>(&anchor));
+        const u64 time = u64(std::chrono::steady_clock::now().time_since_epoch().count());
+
+        return _wymix(random ^ _wyhash_secret[0], _wymix(address, time) ^ _wyhash_secret[1]);
+    }
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// customization point to make `value_type` hashable. specializations provide
+    /// `static auto hash(const value_type& value, u64 seed) -> u64`.
+    ///
+    /// values which compare equal must hash equal, including values of different types used for
+    /// heterogeneous lookups, like `string` and `string_view`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename value_type>
+    class hasher;
+
+    /// --------------------------------------------------------------------------------------------
+    /// `true` if `hasher<value_type>` is specialized.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename value_type>
+    concept hashable_concept = requires(const value_type& value, u64 seed) {
+        { hasher<value_type>::hash(value, seed) } -> std::same_as<u64>;
+    };
+}
+
+export namespace atom::hash
+{
+    /// --------------------------------------------------------------------------------------------
+    /// \returns seed chosen randomly once per process, so hashes can't be predicted from outside
+    /// to flood hash tables with collisions.
+    ///
+    /// \note hashes using this seed differ between runs, don't persist them.
+    /// --------------------------------------------------------------------------------------------
+    inline auto get_seed() -> u64
+    {
+        static const u64 seed = _create_hash_seed();
+        return seed;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns hash of `count` bytes at `data`.
+    /// --------------------------------------------------------------------------------------------
+    inline auto hash_bytes(const void* data, usize count, u64 seed) -> u64
+    {
+        return _wyhash(static_cast<const u8*>(data), count, seed);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns hash of `value` mixed into `hash`. the result depends on the order of combining.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto hash_combine(u64 hash, u64 value) -> u64
+    {
+        return _wymix(hash ^ _wyhash_secret[0], value ^ _wyhash_secret[1]);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns hash of `value` using `seed`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    auto get_hash(const value_type& value, u64 seed) -> u64
+        requires hashable_concept<value_type>
+    {
+        return hasher<value_type>::hash(value, seed);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns hash of `value` using the process seed.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    auto get_hash(const value_type& value) -> u64
+        requires hashable_concept<value_type>
+    {
+        return hasher<value_type>::hash(value, get_seed());
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns hash of each of `values` combined in order.
+    /// --------------------------------------------------------------------------------------------
+    template <typename... value_types>
+    auto get_hash_all(u64 seed, const value_types&... values) -> u64
+        requires(hashable_concept<value_types> and ...)
+    {
+        u64 combined = seed;
+        ((combined = hash_combine(combined, hasher<value_types>::hash(values, seed))), ...);
+        return combined;
+    }
+}
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// integers, chars, bools and pointers. the value is mixed with the seed, so unlike
+    /// `std::hash` the result is not the value itself.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename value_type>
+        requires(std::is_integral_v<value_type> or std::is_pointer_v<value_type>)
+    class hasher<value_type>
+    {
+    public:
+        static auto hash(const value_type& value, u64 seed) -> u64
+        {
+            u64 bits;
+            if constexpr (std::is_pointer_v<value_type>)
+                bits = u64(reinterpret_cast<std::uintptr_t>(value));
+            else
+                bits = u64(value);
+
+            return _wymix(bits ^ _wyhash_secret[0], seed ^ _wyhash_secret[1]);
+        }
+    };
+
+    export template <typename value_type>
+        requires(std::is_floating_point_v<value_type>)
+    class hasher<value_type>
+    {
+    public:
+        static auto hash(const value_type& value, u64 seed) -> u64
+        {
+            // `-0.0 == 0.0`, so they must hash equal.
+            const value_type normalized = value == value_type(0) ? value_type(0) : value;
+            return hash::hash_bytes(&normalized, sizeof(value_type), seed);
+        }
+    };
+
+    export template <typename value_type>
+        requires(std::is_enum_v<value_type>)
+    class hasher<value_type>
+    {
+    public:
+        static auto hash(const value_type& value, u64 seed) -> u64
+        {
+            using underlying_type = std::underlying_type_t<value_type>;
+            return hasher<underlying_type>::hash(underlying_type(value), seed);
+        }
+    };
+
+    export template <typename... value_types>
+        requires(hashable_concept<value_types> and ...)
+    class hasher<std::tuple<value_types...>>
+    {
+    public:
+        static auto hash(const std::tuple<value_types...>& value, u64 seed) -> u64
+        {
+            return std::apply(
+                [&](const value_types&... values) {
+                    return hash::get_hash_all(seed, values...);
+                },
+                value);
+        }
+    };
+
+    export template <typename first_type, typename second_type>
+        requires(hashable_concept<first_type> and hashable_concept<second_type>)
+    class hasher<std::pair<first_type, second_type>>
+    {
+    public:
+        static auto hash(const std::pair<first_type, second_type>& value, u64 seed) -> u64
+        {
+            return hash::get_hash_all(seed, value.first, value.second);
+        }
+    };
+
+    export template <typename value_type>
+        requires hashable_concept<value_type>
+    class hasher<option<value_type>>
+    {
+    public:
+        static auto hash(const option<value_type>& value, u64 seed) -> u64
+        {
+            if (not value.is_value())
+                return hash::hash_combine(seed, 0);
+
+            const u64 combined = hash::hash_combine(seed, 1);
+            return hash::hash_combine(combined, hasher<value_type>::hash(value.get(), seed));
+        }
+    };
+
+    export template <typename... value_types>
+        requires((type_info<value_types>::is_void() or hashable_concept<value_types>) and ...)
+    class hasher<variant<value_types...>>
+    {
+    public:
+        static auto hash(const variant<value_types...>& value, u64 seed) -> u64
+        {
+            u64 combined = hash::hash_combine(seed, value.get_index());
+            (_combine_if<value_types>(value, seed, combined), ...);
+            return combined;
+        }
+
+    private:
+        template <typename value_type>
+        static auto _combine_if(
+            const variant<value_types...>& value, u64 seed, u64& combined) -> void
+        {
+            if constexpr (not type_info<value_type>::is_void())
+            {
+                if (value.template is<value_type>())
+                {
+                    combined = hash::hash_combine(
+                        combined, hasher<value_type>::hash(value.template get<value_type>(), seed));
+                }
+            }
+        }
+    };
+
+    export template <typename value_type, typename... error_types>
+        requires((type_info<value_type>::is_void() or hashable_concept<value_type>)
+                 and (hashable_concept<error_types> and ...))
+    class hasher<result<value_type, error_types...>>
+    {
+    public:
+        static auto hash(const result<value_type, error_types...>& value, u64 seed) -> u64
+        {
+            if (value.is_value())
+            {
+                u64 combined = hash::hash_combine(seed, 0);
+                if constexpr (not type_info<value_type>::is_void())
+                {
+                    combined = hash::hash_combine(
+                        combined, hasher<value_type>::hash(value.get_value(), seed));
+                }
+
+                return combined;
+            }
+
+            u64 combined = seed;
+            usize index = 1;
+            (_combine_if<error_types>(value, seed, index++, combined), ...);
+            return combined;
+        }
+
+    private:
+        template <typename error_type>
+        static auto _combine_if(const result<value_type, error_types...>& value, u64 seed,
+            usize index, u64& combined) -> void
+        {
+            if (value.template is_error<error_type>())
+            {
+                combined = hash::hash_combine(hash::hash_combine(combined, index),
+                    hasher<error_type>::hash(value.template get_error<error_type>(), seed));
+            }
+        }
+    };
+}
@@ -0,0 +1,70 @@
+export module atom_core:hash.range_hasher;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :containers;
+import :strings;
+import :hash.hasher;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// strings, `dynamic_array` and `array_view`. arrays of values without padding are hashed as
+    /// one block of bytes, so every string type hashes equal for the same chars.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<string_tag>()
+                 or type_info<range_type>::template is_derived_from<dynamic_array_tag>()
+                 or type_info<range_type>::template is_derived_from<array_view_tag>())
+    class hasher<range_type>
+    {
+        using value_type = ranges::value_type<range_type>;
+
+    public:
+        static auto hash(const range_type& range, u64 seed) -> u64
+            requires hashable_concept<value_type>
+        {
+            const value_type* data = ranges::get_data(range);
+            const usize count = ranges::get_count(range);
+
+            if constexpr (std::has_unique_object_representations_v<value_type>)
+            {
+                return hash::hash_bytes(data, count * sizeof(value_type), seed);
+            }
+            else
+            {
+                u64 combined = hash::hash_combine(seed, count);
+                for (usize i = 0; i < count; i++)
+                {
+                    const u64 value_hash = hasher<value_type>::hash(data[i], seed);
+                    combined = hash::hash_combine(combined, value_hash);
+                }
+
+                return combined;
+            }
+        }
+    };
+}
+
+namespace std
+{
+    export template <>
+    struct hash<atom::string>
+    {
+        auto operator()(const atom::string& str) const -> std::size_t
+        {
+            return atom::hash::get_hash(str);
+        }
+    };
+
+    export template <>
+    struct hash<atom::string_view>
+    {
+        auto operator()(const atom::string_view& str) const -> std::size_t
+        {
+            return atom::hash::get_hash(str);
+        }
+    };
+}
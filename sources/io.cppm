@@ -4,6 +4,7 @@ import std;
 import :core;
 import :filesystem;
 import :strings;
+export import :io.async_file;
 
 export namespace atom::io
 {
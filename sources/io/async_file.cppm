@@ -0,0 +1,951 @@
+module;
+#include "atom/core/preprocessors.h"
+
+#include <cerrno>
+
+#if defined(ATOM_PLATFORM_POSIX)
+#    include <sys/types.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
+#if defined(__linux__) and __has_include(<linux/io_uring.h>)
+#    include <linux/io_uring.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+
+#    if defined(__NR_io_uring_setup) and defined(__NR_io_uring_enter)
+#        define ATOM_IO_URING
+#    endif
+#endif
+
+export module atom_core:io.async_file;
+
+import std;
+import :core;
+import :contracts;
+import :ranges;
+import :strings;
+import :containers;
+import :filesystem;
+
+#if defined(ATOM_PLATFORM_POSIX)
+
+namespace atom::io
+{
+    export using async_result = result<usize, filesystem::filesystem_error>;
+    export using async_callback = unique_function<void(async_result)>;
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom::io
+{
+    /// --------------------------------------------------------------------------------------------
+    /// a single read or write, from when it's queued until its callback is invoked.
+    /// --------------------------------------------------------------------------------------------
+    class _async_request
+    {
+    public:
+        enum class kind : byte
+        {
+            read,
+            write,
+        };
+
+    public:
+        kind op;
+        int fd;
+        usize pos;
+        ::iovec iov;
+        async_callback callback;
+
+        /// bytes transferred if not negative, else the negated error number.
+        isize res;
+
+        _async_request* next;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// intrusive fifo list of requests, linked through `_async_request::next`.
+    /// --------------------------------------------------------------------------------------------
+    class _async_request_list
+    {
+    public:
+        _async_request_list()
+            : _first{ nullptr }
+            , _last{ nullptr }
+            , _count{ 0 }
+        {}
+
+    public:
+        auto push_last(_async_request* request) -> void
+        {
+            request->next = nullptr;
+
+            if (_last == nullptr)
+                _first = request;
+            else
+                _last->next = request;
+
+            _last = request;
+            _count++;
+        }
+
+        auto pop_first() -> _async_request*
+        {
+            _async_request* request = _first;
+            if (request == nullptr)
+                return nullptr;
+
+            _first = request->next;
+            if (_first == nullptr)
+                _last = nullptr;
+
+            _count--;
+            return request;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves all requests of `that` after the requests of this.
+        /// ----------------------------------------------------------------------------------------
+        auto append(_async_request_list& that) -> void
+        {
+            if (that._first == nullptr)
+                return;
+
+            if (_last == nullptr)
+                _first = that._first;
+            else
+                _last->next = that._first;
+
+            _last = that._last;
+            _count += that._count;
+
+            that._first = nullptr;
+            that._last = nullptr;
+            that._count = 0;
+        }
+
+        auto get_count() const -> usize
+        {
+            return _count;
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _count == 0;
+        }
+
+    private:
+        _async_request* _first;
+        _async_request* _last;
+        usize _count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// performs `request` with a blocking `pread` or `pwrite`, retrying if interrupted.
+    /// --------------------------------------------------------------------------------------------
+    inline auto _async_perform(_async_request* request) -> void
+    {
+        while (true)
+        {
+            const isize res = request->op == _async_request::kind::read
+                                  ? ::pread(request->fd, request->iov.iov_base,
+                                        request->iov.iov_len, ::off_t(request->pos))
+                                  : ::pwrite(request->fd, request->iov.iov_base,
+                                        request->iov.iov_len, ::off_t(request->pos));
+
+            if (res == -1 and errno == EINTR)
+                continue;
+
+            request->res = res == -1 ? -isize(errno) : res;
+            return;
+        }
+    }
+
+#    if defined(ATOM_IO_URING)
+    /// --------------------------------------------------------------------------------------------
+    /// submission and completion rings of an io_uring instance, set up using the raw syscalls so
+    /// that liburing isn't needed.
+    /// --------------------------------------------------------------------------------------------
+    class _io_uring
+    {
+    public:
+        _io_uring()
+            : _fd{ -1 }
+            , _sq_ptr{ nullptr }
+            , _sq_size{ 0 }
+            , _cq_ptr{ nullptr }
+            , _cq_size{ 0 }
+            , _sqes{ nullptr }
+            , _sqes_size{ 0 }
+            , _sq_entries{ 0 }
+        {}
+
+        _io_uring(const _io_uring& that) = delete;
+        _io_uring& operator=(const _io_uring& that) = delete;
+
+        ~_io_uring()
+        {
+            if (_fd == -1)
+                return;
+
+            ::munmap(_sqes, _sqes_size);
+
+            if (_cq_ptr != _sq_ptr)
+                ::munmap(_cq_ptr, _cq_size);
+
+            ::munmap(_sq_ptr, _sq_size);
+            ::close(_fd);
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// creates the instance with `entries` submission entries and maps its rings.
+        ///
+        /// \returns `false` if io_uring is not available, like on old kernels or when blocked by
+        /// seccomp in containers.
+        /// ----------------------------------------------------------------------------------------
+        auto setup(u32 entries) -> bool
+        {
+            ::io_uring_params params{};
+            const int fd = int(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0)
+                return false;
+
+            _fd = fd;
+            _sq_entries = params.sq_entries;
+            _sq_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+            _cq_size = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+
+            // both rings are in one mapping on kernels 5.4 and newer.
+            const bool is_single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (is_single_mmap)
+                _sq_size = _cq_size = std::max(_sq_size, _cq_size);
+
+            _sq_ptr = _map(_sq_size, IORING_OFF_SQ_RING);
+            if (_sq_ptr == nullptr)
+                return _fail();
+
+            _cq_ptr = is_single_mmap ? _sq_ptr : _map(_cq_size, IORING_OFF_CQ_RING);
+            if (_cq_ptr == nullptr)
+                return _fail();
+
+            _sqes_size = params.sq_entries * sizeof(::io_uring_sqe);
+            _sqes = static_cast<::io_uring_sqe*>(_map(_sqes_size, IORING_OFF_SQES));
+            if (_sqes == nullptr)
+                return _fail();
+
+            _sq_head = _get_ring_field(_sq_ptr, params.sq_off.head);
+            _sq_tail = _get_ring_field(_sq_ptr, params.sq_off.tail);
+            _sq_mask = *_get_ring_field(_sq_ptr, params.sq_off.ring_mask);
+            _sq_array = reinterpret_cast<u32*>(static_cast<byte*>(_sq_ptr) + params.sq_off.array);
+            _cq_head = _get_ring_field(_cq_ptr, params.cq_off.head);
+            _cq_tail = _get_ring_field(_cq_ptr, params.cq_off.tail);
+            _cq_mask = *_get_ring_field(_cq_ptr, params.cq_off.ring_mask);
+            _cqes = reinterpret_cast<::io_uring_cqe*>(
+                static_cast<byte*>(_cq_ptr) + params.cq_off.cqes);
+
+            return true;
+        }
+
+        auto get_sq_entries() const -> u32
+        {
+            return _sq_entries;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes an entry for `request` into the submission ring, without submitting it.
+        ///
+        /// \pre the ring has space, at most `get_sq_entries()` requests are prepared and not
+        /// submitted.
+        /// ----------------------------------------------------------------------------------------
+        auto prepare(_async_request* request) -> void
+        {
+            const u32 tail = _sq_tail->load(std::memory_order_relaxed);
+            const u32 index = tail & _sq_mask;
+
+            ::io_uring_sqe* sqe = &_sqes[index];
+            std::memset(sqe, 0, sizeof(::io_uring_sqe));
+            sqe->opcode =
+                request->op == _async_request::kind::read ? IORING_OP_READV : IORING_OP_WRITEV;
+            sqe->fd = request->fd;
+            sqe->addr = u64(reinterpret_cast<std::uintptr_t>(&request->iov));
+            sqe->len = 1;
+            sqe->off = u64(request->pos);
+            sqe->user_data = u64(reinterpret_cast<std::uintptr_t>(request));
+
+            _sq_array[index] = index;
+            _sq_tail->store(tail + 1, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// submits all prepared entries, and waits for `wait_count` completions if not `0`.
+        ///
+        /// retries if interrupted, or if the kernel takes only some of the entries.
+        ///
+        /// \returns `0` on success, else the error number. entries not taken by the kernel stay
+        /// prepared.
+        /// ----------------------------------------------------------------------------------------
+        auto enter(u32 wait_count) -> i32
+        {
+            const u32 flags = wait_count > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+            while (true)
+            {
+                // the kernel moves the head past the entries it takes, even if interrupted.
+                const u32 count = get_unsubmitted_count();
+                const int res =
+                    int(::syscall(__NR_io_uring_enter, _fd, count, wait_count, flags, nullptr, 0));
+
+                if (res < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return errno;
+                }
+
+                if (u32(res) >= count)
+                    return 0;
+
+                // the kernel took no entries, retrying right away would spin.
+                if (res == 0)
+                    return EAGAIN;
+
+                // the kernel doesn't wait after taking only some of the entries, so submit the
+                // rest and wait with them.
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of entries prepared but not taken by the kernel yet.
+        /// ----------------------------------------------------------------------------------------
+        auto get_unsubmitted_count() const -> u32
+        {
+            const u32 tail = _sq_tail->load(std::memory_order_relaxed);
+            return tail - _sq_head->load(std::memory_order_acquire);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// takes back the entries not taken by the kernel, failing their requests with `error`
+        /// and pushing them into `completed`.
+        ///
+        /// \returns count of requests failed.
+        /// ----------------------------------------------------------------------------------------
+        auto cancel_unsubmitted(_async_request_list& completed, i32 error) -> usize
+        {
+            const u32 head = _sq_head->load(std::memory_order_acquire);
+            const u32 tail = _sq_tail->load(std::memory_order_relaxed);
+
+            for (u32 i = head; i != tail; i++)
+            {
+                const ::io_uring_sqe& sqe = _sqes[_sq_array[i & _sq_mask]];
+                _async_request* request =
+                    reinterpret_cast<_async_request*>(std::uintptr_t(sqe.user_data));
+
+                request->res = -isize(error);
+                completed.push_last(request);
+            }
+
+            _sq_tail->store(head, std::memory_order_release);
+            return tail - head;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// takes all entries from the completion ring, storing their results into the requests
+        /// and pushing them into `completed`.
+        ///
+        /// \returns count of requests completed.
+        /// ----------------------------------------------------------------------------------------
+        auto reap(_async_request_list& completed) -> usize
+        {
+            u32 head = _cq_head->load(std::memory_order_relaxed);
+            const u32 tail = _cq_tail->load(std::memory_order_acquire);
+            const usize count = tail - head;
+
+            for (; head != tail; head++)
+            {
+                const ::io_uring_cqe& cqe = _cqes[head & _cq_mask];
+                _async_request* request =
+                    reinterpret_cast<_async_request*>(std::uintptr_t(cqe.user_data));
+
+                request->res = cqe.res;
+                completed.push_last(request);
+            }
+
+            _cq_head->store(head, std::memory_order_release);
+            return count;
+        }
+
+    private:
+        auto _map(usize size, u64 offset) -> void*
+        {
+            void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                _fd, ::off_t(offset));
+
+            return ptr == MAP_FAILED ? nullptr : ptr;
+        }
+
+        static auto _get_ring_field(void* ring, u32 offset) -> std::atomic<u32>*
+        {
+            return reinterpret_cast<std::atomic<u32>*>(static_cast<byte*>(ring) + offset);
+        }
+
+        auto _fail() -> bool
+        {
+            if (_sq_ptr != nullptr)
+                ::munmap(_sq_ptr, _sq_size);
+
+            if (_cq_ptr != nullptr and _cq_ptr != _sq_ptr)
+                ::munmap(_cq_ptr, _cq_size);
+
+            ::close(_fd);
+
+            _fd = -1;
+            _sq_ptr = nullptr;
+            _cq_ptr = nullptr;
+            return false;
+        }
+
+    private:
+        int _fd;
+
+        void* _sq_ptr;
+        usize _sq_size;
+        void* _cq_ptr;
+        usize _cq_size;
+        ::io_uring_sqe* _sqes;
+        usize _sqes_size;
+        u32 _sq_entries;
+
+        std::atomic<u32>* _sq_head;
+        std::atomic<u32>* _sq_tail;
+        u32 _sq_mask;
+        u32* _sq_array;
+
+        std::atomic<u32>* _cq_head;
+        std::atomic<u32>* _cq_tail;
+        u32 _cq_mask;
+        ::io_uring_cqe* _cqes;
+    };
+#    endif
+
+    /// --------------------------------------------------------------------------------------------
+    /// worker threads performing requests with blocking syscalls, used when io_uring is not
+    /// available.
+    /// --------------------------------------------------------------------------------------------
+    class _async_worker_pool
+    {
+    public:
+        _async_worker_pool()
+            : _workers{}
+            , _mutex{}
+            , _submitted_cond{}
+            , _completed_cond{}
+            , _submitted{}
+            , _completed{}
+            , _is_stopping{ false }
+        {}
+
+        _async_worker_pool(const _async_worker_pool& that) = delete;
+        _async_worker_pool& operator=(const _async_worker_pool& that) = delete;
+
+        ~_async_worker_pool()
+        {
+            {
+                std::unique_lock lock{ _mutex };
+                _is_stopping = true;
+            }
+
+            _submitted_cond.notify_all();
+
+            for (usize i = 0; i < _workers.get_count(); i++)
+                _workers.get_at(i).join();
+        }
+
+    public:
+        auto start(usize worker_count) -> void
+        {
+            for (usize i = 0; i < worker_count; i++)
+                _workers.emplace_last([this] { _run(); });
+        }
+
+        auto get_worker_count() const -> usize
+        {
+            return _workers.get_count();
+        }
+
+        auto submit(_async_request_list& requests) -> void
+        {
+            {
+                std::unique_lock lock{ _mutex };
+                _submitted.append(requests);
+            }
+
+            _submitted_cond.notify_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves the completed requests into `completed`, waiting until there are at least
+        /// `wait_count` of them.
+        ///
+        /// \returns count of requests moved.
+        /// ----------------------------------------------------------------------------------------
+        auto reap(_async_request_list& completed, usize wait_count) -> usize
+        {
+            std::unique_lock lock{ _mutex };
+            _completed_cond.wait(lock, [&] { return _completed.get_count() >= wait_count; });
+
+            const usize count = _completed.get_count();
+            completed.append(_completed);
+            return count;
+        }
+
+    private:
+        auto _run() -> void
+        {
+            std::unique_lock lock{ _mutex };
+
+            while (true)
+            {
+                _submitted_cond.wait(
+                    lock, [&] { return _is_stopping or not _submitted.is_empty(); });
+
+                if (_is_stopping)
+                    return;
+
+                _async_request* request = _submitted.pop_first();
+
+                lock.unlock();
+                _async_perform(request);
+                lock.lock();
+
+                _completed.push_last(request);
+                _completed_cond.notify_one();
+            }
+        }
+
+    private:
+        dynamic_array<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _submitted_cond;
+        std::condition_variable _completed_cond;
+        _async_request_list _submitted;
+        _async_request_list _completed;
+        bool _is_stopping;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom::io
+{
+    /// --------------------------------------------------------------------------------------------
+    /// engine performing file reads and writes asynchronously, many at a time.
+    ///
+    /// requests are queued by `read_at()` and `write_at()`, sent together to the os by `submit()`
+    /// and their callbacks are invoked by `poll()` and `wait()`, always on the thread calling
+    /// them. an engine must be used from one thread at a time.
+    ///
+    /// requests go through io_uring when it's available, needing no thread and one syscall for a
+    /// whole batch. else they are performed by a pool of worker threads.
+    ///
+    /// like `pread()` and `pwrite()`, a request can transfer less bytes than asked for. the count
+    /// transferred is passed to its callback.
+    /// --------------------------------------------------------------------------------------------
+    export class async_engine
+    {
+        using this_type = async_engine;
+
+    public:
+        enum class backend : byte
+        {
+            io_uring,
+            thread_pool,
+        };
+
+        class options
+        {
+        public:
+            /// count of requests which can be in flight at once with io_uring.
+            u32 queue_depth = 256;
+
+            /// count of worker threads, if io_uring is not available.
+            usize worker_count = 4;
+
+            /// use worker threads even if io_uring is available.
+            bool force_thread_pool = false;
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// sets up io_uring, or starts worker threads if it's not available.
+        /// ----------------------------------------------------------------------------------------
+        async_engine()
+            : async_engine{ options{} }
+        {}
+
+        explicit async_engine(const options& opts)
+            : _backend{ backend::thread_pool }
+            , _queued{}
+            , _completed{}
+            , _in_flight_count{ 0 }
+#    if defined(ATOM_IO_URING)
+            , _ring{}
+#    endif
+            , _pool{}
+        {
+            contract_expects(opts.queue_depth > 0, "queue depth is zero.");
+            contract_expects(opts.worker_count > 0, "worker count is zero.");
+
+#    if defined(ATOM_IO_URING)
+            if (not opts.force_thread_pool and _ring.setup(opts.queue_depth))
+            {
+                _backend = backend::io_uring;
+                return;
+            }
+#    endif
+
+            _pool.start(opts.worker_count);
+        }
+
+        async_engine(const this_type& that) = delete;
+        async_engine& operator=(const this_type& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// submits the queued requests and waits for all of them to complete, invoking their
+        /// callbacks, since the os could still be using their buffers.
+        /// ----------------------------------------------------------------------------------------
+        ~async_engine()
+        {
+            wait_all();
+        }
+
+    public:
+        auto get_backend() const -> backend
+        {
+            return _backend;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// queues read of up to `count` bytes at `pos` in `fd` into `data`.
+        ///
+        /// \pre `data` stays valid until `callback` is invoked.
+        /// ----------------------------------------------------------------------------------------
+        auto read_at(int fd, usize pos, byte* data, usize count, async_callback callback) -> void
+        {
+            _queue(_async_request::kind::read, fd, pos, data, count, move(callback));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// queues write of `bytes` at `pos` in `fd`.
+        ///
+        /// \pre `bytes` stays valid until `callback` is invoked.
+        /// ----------------------------------------------------------------------------------------
+        auto write_at(int fd, usize pos, memory_view bytes, async_callback callback) -> void
+        {
+            _queue(_async_request::kind::write, fd, pos, const_cast<void*>(bytes.get_data()),
+                bytes.get_size(), move(callback));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// sends the queued requests to the os, with as few syscalls as possible.
+        ///
+        /// with io_uring, requests over the queue depth stay queued until earlier ones complete.
+        /// ----------------------------------------------------------------------------------------
+        auto submit() -> void
+        {
+            _submit(0);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// submits the queued requests and invokes callbacks of those completed, without
+        /// waiting.
+        ///
+        /// \returns count of callbacks invoked.
+        /// ----------------------------------------------------------------------------------------
+        auto poll() -> usize
+        {
+            _submit(0);
+            _reap(0);
+            return _invoke_completed();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// submits the queued requests and waits for at least `count` of the pending ones to
+        /// complete, invoking their callbacks.
+        ///
+        /// \returns count of callbacks invoked.
+        /// ----------------------------------------------------------------------------------------
+        auto wait(usize count = 1) -> usize
+        {
+            usize invoked = 0;
+            while (invoked < count and get_pending_count() > 0)
+            {
+                _submit(0);
+
+                const usize remaining = std::min(count - invoked, _in_flight_count);
+                _reap(remaining);
+                invoked += _invoke_completed();
+            }
+
+            return invoked;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// waits for all pending requests to complete, invoking their callbacks.
+        /// ----------------------------------------------------------------------------------------
+        auto wait_all() -> usize
+        {
+            return wait(get_pending_count());
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of requests whose callbacks are not invoked yet.
+        /// ----------------------------------------------------------------------------------------
+        auto get_pending_count() const -> usize
+        {
+            return _queued.get_count() + _in_flight_count + _completed.get_count();
+        }
+
+    private:
+        auto _queue(_async_request::kind op, int fd, usize pos, void* data, usize count,
+            async_callback callback) -> void
+        {
+            contract_debug_expects(fd != -1, "the file is closed.");
+
+            _async_request* request = new _async_request{ .op = op,
+                .fd = fd,
+                .pos = pos,
+                .iov = ::iovec{ .iov_base = data, .iov_len = count },
+                .callback = move(callback),
+                .res = 0,
+                .next = nullptr };
+
+            _queued.push_last(request);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// submits the queued requests, waiting for `wait_count` completions in the same syscall
+        /// with io_uring.
+        ///
+        /// if the kernel is short of resources, completions are reaped to make room and the
+        /// submission is retried a few times. requests which still can't be submitted complete
+        /// with the error.
+        /// ----------------------------------------------------------------------------------------
+        auto _submit(usize wait_count) -> void
+        {
+#    if defined(ATOM_IO_URING)
+            if (_backend == backend::io_uring)
+            {
+                static constexpr usize max_retry_count = 16;
+
+                while (_in_flight_count < _ring.get_sq_entries() and not _queued.is_empty())
+                {
+                    _ring.prepare(_queued.pop_first());
+                    _in_flight_count++;
+                }
+
+                if (_ring.get_unsubmitted_count() == 0 and wait_count == 0)
+                    return;
+
+                i32 error = _ring.enter(u32(wait_count));
+                for (usize i = 0; i < max_retry_count and (error == EAGAIN or error == EBUSY); i++)
+                {
+                    _in_flight_count -= _ring.reap(_completed);
+                    std::this_thread::yield();
+
+                    // completions may have been reaped above, waiting for more could block.
+                    error = _ring.enter(0);
+                }
+
+                if (error != 0)
+                    _in_flight_count -= _ring.cancel_unsubmitted(_completed, error);
+
+                return;
+            }
+#    endif
+
+            _in_flight_count += _queued.get_count();
+            _pool.submit(_queued);
+        }
+
+        auto _reap(usize wait_count) -> void
+        {
+#    if defined(ATOM_IO_URING)
+            if (_backend == backend::io_uring)
+            {
+                if (wait_count > 0)
+                    _submit(wait_count);
+
+                _in_flight_count -= _ring.reap(_completed);
+                return;
+            }
+#    endif
+
+            _in_flight_count -= _pool.reap(_completed, wait_count);
+        }
+
+        auto _invoke_completed() -> usize
+        {
+            usize count = 0;
+            while (_async_request* request = _completed.pop_first())
+            {
+                if (request->res < 0)
+                    request->callback(filesystem::filesystem_error{ i32(-request->res) });
+                else
+                    request->callback(usize(request->res));
+
+                delete request;
+                count++;
+            }
+
+            return count;
+        }
+
+    private:
+        backend _backend;
+        _async_request_list _queued;
+        _async_request_list _completed;
+        usize _in_flight_count;
+
+#    if defined(ATOM_IO_URING)
+        _io_uring _ring;
+#    endif
+
+        _async_worker_pool _pool;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// file whose reads and writes are performed by an `async_engine`.
+    ///
+    /// reads and writes take an explicit position, so many of them can be in flight at once.
+    /// --------------------------------------------------------------------------------------------
+    export class async_file
+    {
+        using this_type = async_file;
+
+    public:
+        using open_flags = filesystem::file::open_flags;
+        using open_result = result<async_file, filesystem::filesystem_error,
+            filesystem::noentry_error, filesystem::invalid_options_error>;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// initializes as closed.
+        /// ----------------------------------------------------------------------------------------
+        async_file()
+            : _engine{ nullptr }
+            , _file{}
+        {}
+
+        async_file(async_engine& engine, filesystem::fd_file file)
+            : _engine{ &engine }
+            , _file{ move(file) }
+        {}
+
+        async_file(const this_type& that) = delete;
+        async_file& operator=(const this_type& that) = delete;
+
+        async_file(this_type&& that) = default;
+        async_file& operator=(this_type&& that) = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// opens a file at `path` with access specified by `flags`, same as `file::open()`.
+        ///
+        /// \pre the file is closed before `engine` is destroyed.
+        /// ----------------------------------------------------------------------------------------
+        static auto open(async_engine& engine, string_view path, open_flags flags) -> open_result
+        {
+            filesystem::fd_file::open_result result = filesystem::fd_file::open(path, flags);
+
+            if (result.is_error<filesystem::noentry_error>())
+                return result.get_error<filesystem::noentry_error>();
+
+            if (result.is_error<filesystem::invalid_options_error>())
+                return result.get_error<filesystem::invalid_options_error>();
+
+            if (result.is_error())
+                return result.get_error<filesystem::filesystem_error>();
+
+            return async_file{ engine, move(result.get_value()) };
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// queues read of up to `count` bytes at `pos` into `data`. `callback` is invoked with
+        /// the count of bytes read, `0` at the end of the file.
+        ///
+        /// \pre `data` stays valid and the file open until `callback` is invoked.
+        /// ----------------------------------------------------------------------------------------
+        auto read_at(usize pos, byte* data, usize count, async_callback callback) -> void
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            _engine->read_at(_file.get_native_handle(), pos, data, count, move(callback));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// queues write of `bytes` at `pos`. `callback` is invoked with the count of bytes
+        /// written.
+        ///
+        /// \pre `bytes` stays valid and the file open until `callback` is invoked.
+        /// ----------------------------------------------------------------------------------------
+        auto write_at(usize pos, memory_view bytes, async_callback callback) -> void
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            _engine->write_at(_file.get_native_handle(), pos, bytes, move(callback));
+        }
+
+        auto get_size() const -> filesystem::fd_file::read_result
+        {
+            return _file.get_size();
+        }
+
+        auto get_engine() const -> async_engine&
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            return *_engine;
+        }
+
+        auto get_native_handle() const -> int
+        {
+            return _file.get_native_handle();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// closes the file.
+        ///
+        /// \pre no request for the file is pending.
+        /// ----------------------------------------------------------------------------------------
+        auto close() -> void
+        {
+            _file.close();
+            _engine = nullptr;
+        }
+
+        auto is_closed() const -> bool
+        {
+            return _file.is_closed();
+        }
+
+    private:
+        async_engine* _engine;
+        filesystem::fd_file _file;
+    };
+}
+
+#endif
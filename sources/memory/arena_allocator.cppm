@@ -0,0 +1,338 @@
+export module atom_core:arena_allocator;
+
+import std;
+import :core;
+import :contracts;
+import :default_mem_allocator;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// header placed at the start of each block allocated by `arena`.
+    /// --------------------------------------------------------------------------------------------
+    class _arena_block
+    {
+    public:
+        _arena_block* next;
+        usize size;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// header placed before each allocation made from `arena`, used by `realloc` to know how many
+    /// bytes to copy.
+    /// --------------------------------------------------------------------------------------------
+    class alignas(std::max_align_t) _arena_alloc_header
+    {
+    public:
+        usize size;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// monotonic memory resource, which allocates by bumping a pointer through big blocks
+    /// allocated using `default_mem_allocator`.
+    ///
+    /// memory is never given back on `dealloc`, it's reclaimed all at once by `reset()` or when
+    /// the arena is destroyed. blocks are kept on `reset()`, so an arena reused across requests
+    /// stops allocating once it has grown to fit the biggest one.
+    ///
+    /// all allocations are aligned to `alignof(std::max_align_t)`.
+    /// --------------------------------------------------------------------------------------------
+    export class arena
+    {
+        using this_type = arena;
+
+    public:
+        static constexpr usize default_block_size = 64 * 1024;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with no blocks, without allocating.
+        /// ----------------------------------------------------------------------------------------
+        constexpr arena()
+            : arena{ create_with_size, default_block_size }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with no blocks, without allocating. blocks will be allocated with atleast
+        /// `block_size` bytes.
+        /// ----------------------------------------------------------------------------------------
+        constexpr arena(create_with_size_tag, usize block_size)
+            : _first{ nullptr }
+            , _current{ nullptr }
+            , _cursor{ nullptr }
+            , _end{ nullptr }
+            , _last_alloc{ nullptr }
+            , _block_size{ block_size }
+        {}
+
+        arena(const this_type&) = delete;
+        arena& operator=(const this_type&) = delete;
+
+        ~arena()
+        {
+            _release_blocks();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// allocates `size` bytes.
+        /// ----------------------------------------------------------------------------------------
+        auto alloc(usize size) -> void*
+        {
+            usize total_size = sizeof(_arena_alloc_header) + _align_size(size);
+            if (_cursor == nullptr or usize(_end - _cursor) < total_size)
+                _next_block(total_size);
+
+            _arena_alloc_header* header = reinterpret_cast<_arena_alloc_header*>(_cursor);
+            header->size = size;
+
+            _last_alloc = _cursor + sizeof(_arena_alloc_header);
+            _cursor += total_size;
+            return _last_alloc;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// resizes the allocation `mem` to `size` bytes. if `mem` is the last allocation and the
+        /// current block has enough space, `mem` is grown or shrunk in place. else a new
+        /// allocation is made and contents of `mem` are copied to it.
+        /// ----------------------------------------------------------------------------------------
+        auto realloc(void* mem, usize size) -> void*
+        {
+            if (mem == nullptr)
+                return alloc(size);
+
+            _arena_alloc_header* header = _get_header(mem);
+            if (mem == _last_alloc and usize(_end - static_cast<byte*>(mem)) >= _align_size(size))
+            {
+                header->size = size;
+                _cursor = _last_alloc + _align_size(size);
+                return mem;
+            }
+
+            usize old_size = header->size;
+            void* new_mem = alloc(size);
+            std::memcpy(new_mem, mem, old_size < size ? old_size : size);
+            return new_mem;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// does nothing, memory is reclaimed by `reset()`.
+        /// ----------------------------------------------------------------------------------------
+        auto dealloc(void* mem) -> void {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// reclaims all allocations made from this arena, keeping the blocks for reuse.
+        ///
+        /// \note doesn't call any destructor, objects living in the arena must be destroyed
+        ///     before.
+        /// ----------------------------------------------------------------------------------------
+        auto reset() -> void
+        {
+            _current = _first;
+            _last_alloc = nullptr;
+
+            if (_first == nullptr)
+            {
+                _cursor = nullptr;
+                _end = nullptr;
+                return;
+            }
+
+            _cursor = _get_block_data(_first);
+            _end = _cursor + _first->size;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reclaims all allocations and frees all blocks.
+        /// ----------------------------------------------------------------------------------------
+        auto release() -> void
+        {
+            _release_blocks();
+
+            _first = nullptr;
+            _current = nullptr;
+            _cursor = nullptr;
+            _end = nullptr;
+            _last_alloc = nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of bytes allocated from the current block and all the blocks before it.
+        /// ----------------------------------------------------------------------------------------
+        auto get_used_size() const -> usize
+        {
+            usize size = 0;
+            for (_arena_block* block = _first; block != _current; block = block->next)
+                size += block->size;
+
+            if (_current != nullptr)
+                size += _cursor - _get_block_data(_current);
+
+            return size;
+        }
+
+    private:
+        static constexpr auto _align_size(usize size) -> usize
+        {
+            constexpr usize align = alignof(std::max_align_t);
+            return (size + align - 1) & ~(align - 1);
+        }
+
+        static auto _get_header(void* mem) -> _arena_alloc_header*
+        {
+            return reinterpret_cast<_arena_alloc_header*>(
+                static_cast<byte*>(mem) - sizeof(_arena_alloc_header));
+        }
+
+        static auto _get_block_data(_arena_block* block) -> byte*
+        {
+            return reinterpret_cast<byte*>(block) + _align_size(sizeof(_arena_block));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves to the next block with atleast `size` bytes, reusing blocks kept by `reset()`
+        /// when possible.
+        /// ----------------------------------------------------------------------------------------
+        auto _next_block(usize size) -> void
+        {
+            _arena_block* next = _current == nullptr ? _first : _current->next;
+            if (next == nullptr or next->size < size)
+            {
+                usize block_size = size > _block_size ? size : _block_size;
+                void* mem = default_mem_allocator().alloc(
+                    _align_size(sizeof(_arena_block)) + block_size);
+                contract_asserts(mem != nullptr, "failed to allocate arena block.");
+
+                _arena_block* block = static_cast<_arena_block*>(mem);
+                block->size = block_size;
+                block->next = next;
+
+                if (_current == nullptr)
+                    _first = block;
+                else
+                    _current->next = block;
+
+                next = block;
+            }
+
+            _current = next;
+            _cursor = _get_block_data(next);
+            _end = _cursor + next->size;
+            _last_alloc = nullptr;
+        }
+
+        auto _release_blocks() -> void
+        {
+            _arena_block* block = _first;
+            while (block != nullptr)
+            {
+                _arena_block* next = block->next;
+                default_mem_allocator().dealloc(block);
+                block = next;
+            }
+        }
+
+    private:
+        _arena_block* _first;
+        _arena_block* _current;
+        byte* _cursor;
+        byte* _end;
+        byte* _last_alloc;
+        usize _block_size;
+
+        friend class arena_scope;
+        static inline thread_local arena* _scoped = nullptr;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// makes an `arena` the one used by default constructed `arena_allocator`s on this thread,
+    /// until the scope ends.
+    ///
+    /// this lets containers which default construct their allocator, like `box` and `buf_string`,
+    /// allocate from an arena.
+    /// --------------------------------------------------------------------------------------------
+    export class arena_scope
+    {
+    public:
+        arena_scope(arena& scoped)
+            : _prev{ arena::_scoped }
+        {
+            arena::_scoped = &scoped;
+        }
+
+        arena_scope(const arena_scope&) = delete;
+        arena_scope& operator=(const arena_scope&) = delete;
+
+        ~arena_scope()
+        {
+            arena::_scoped = _prev;
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns arena of the innermost `arena_scope` on this thread, or `nullptr`.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_current() -> arena*
+        {
+            return arena::_scoped;
+        }
+
+    private:
+        arena* _prev;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// allocator which allocates from an `arena`. it's a cheap handle, copies allocate from the
+    /// same arena.
+    ///
+    /// a default constructed `arena_allocator` uses the arena of the current `arena_scope`.
+    /// --------------------------------------------------------------------------------------------
+    export class arena_allocator
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// initializes to allocate from the arena of the current `arena_scope`.
+        ///
+        /// \note outside of an `arena_scope` this isn't bound to an arena, and allocating from it
+        ///     is a contract violation.
+        /// ----------------------------------------------------------------------------------------
+        arena_allocator()
+            : _arena{ arena_scope::get_current() }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// initializes to allocate from `source`.
+        /// ----------------------------------------------------------------------------------------
+        arena_allocator(arena& source)
+            : _arena{ &source }
+        {}
+
+    public:
+        auto alloc(usize size) -> void*
+        {
+            contract_expects(_arena != nullptr, "arena_allocator is not bound to an arena.");
+
+            return _arena->alloc(size);
+        }
+
+        auto realloc(void* mem, usize size) -> void*
+        {
+            contract_expects(_arena != nullptr, "arena_allocator is not bound to an arena.");
+
+            return _arena->realloc(mem, size);
+        }
+
+        auto dealloc(void* mem) -> void {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns the arena this allocates from.
+        /// ----------------------------------------------------------------------------------------
+        auto get_arena() const -> arena*
+        {
+            return _arena;
+        }
+
+    private:
+        arena* _arena;
+    };
+}
@@ -1,8 +1,17 @@
 export module atom_core:default_mem_allocator;
 
 import :legacy_mem_allocator;
+import :pool_mem_allocator;
 
 namespace atom
 {
+    /// --------------------------------------------------------------------------------------------
+    /// allocator used by containers when none is specified. set `atom_core_use_pool_allocator` in
+    /// cmake to use `pool_mem_allocator`.
+    /// --------------------------------------------------------------------------------------------
+#if defined(ATOM_USE_POOL_MEM_ALLOCATOR)
+    export using default_mem_allocator = pool_mem_allocator;
+#else
     export using default_mem_allocator = legacy_mem_allocator;
+#endif
 }
@@ -2,26 +2,40 @@ export module atom_core:dynamic_buffer;
 
 import std;
 import :core;
+import :contracts;
 import :default_mem_allocator;
 import :mem_helper;
 import :ranges;
 
 namespace atom
 {
-    export class dynamic_buffer
+    /// --------------------------------------------------------------------------------------------
+    /// owning buffer of bytes, allocated using `allocator_type`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_allocator_type>
+    class basic_dynamic_buffer
     {
-        using this_type = dynamic_buffer;
-        using allocator_type = default_mem_allocator;
+        using this_type = basic_dynamic_buffer;
 
     public:
-        constexpr dynamic_buffer()
+        using allocator_type = in_allocator_type;
+
+    public:
+        constexpr basic_dynamic_buffer()
             : _data{ nullptr }
             , _size{ 0 }
             , _capacity{ 0 }
             , _allocator{}
         {}
 
-        constexpr dynamic_buffer(const this_type& that)
+        constexpr basic_dynamic_buffer(create_with_allocator_tag, allocator_type allocator)
+            : _data{ nullptr }
+            , _size{ 0 }
+            , _capacity{ 0 }
+            , _allocator{ move(allocator) }
+        {}
+
+        constexpr basic_dynamic_buffer(const this_type& that)
             : _data{ nullptr }
             , _size{ that._size }
             , _capacity{ that._size }
@@ -32,13 +46,13 @@ namespace atom
             mem_helper::copy_to(that._data, _size, _data);
         }
 
-        constexpr dynamic_buffer& operator=(const this_type& that)
+        constexpr basic_dynamic_buffer& operator=(const this_type& that)
         {
             _set_data(that._data, that._size);
             return *this;
         }
 
-        constexpr dynamic_buffer(this_type&& that)
+        constexpr basic_dynamic_buffer(this_type&& that)
             : _data{ that._data }
             , _size{ that._size }
             , _capacity{ that._capacity }
@@ -49,7 +63,7 @@ namespace atom
             that._capacity = 0;
         }
 
-        constexpr dynamic_buffer& operator=(this_type&& that)
+        constexpr basic_dynamic_buffer& operator=(this_type&& that)
         {
             if (_data != nullptr)
             {
@@ -58,6 +72,7 @@ namespace atom
 
             _data = that._data;
             _size = that._size;
+            _capacity = that._capacity;
             _allocator = move(that._allocator);
 
             that._data = nullptr;
@@ -67,7 +82,7 @@ namespace atom
             return *this;
         }
 
-        constexpr dynamic_buffer(create_with_size_tag, usize size)
+        constexpr basic_dynamic_buffer(create_with_size_tag, usize size)
             : _data{ nullptr }
             , _size{ size }
             , _capacity{ size }
@@ -77,7 +92,7 @@ namespace atom
         }
 
         template <typename range_type>
-        constexpr dynamic_buffer(create_from_range_tag, const range_type& range)
+        constexpr basic_dynamic_buffer(create_from_range_tag, const range_type& range)
             requires(ranges::const_array_range_concept<range_type>)
             : _data{ nullptr }
             , _size{ ranges::get_count(range) * sizeof(ranges::value_type<range_type>) }
@@ -89,7 +104,7 @@ namespace atom
             mem_helper::copy_to(ranges::get_data(range), _size, _data);
         }
 
-        constexpr ~dynamic_buffer()
+        constexpr ~basic_dynamic_buffer()
         {
             if (_data != nullptr)
             {
@@ -150,10 +165,37 @@ namespace atom
             }
 
             _size = size;
-            _capacity = 0;
+            _capacity = size;
             _data = static_cast<byte*>(_allocator.alloc(_capacity));
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// grows capacity to at least `capacity` bytes, keeping the contents.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto reserve(usize capacity) -> void
+        {
+            if (capacity <= _capacity)
+            {
+                return;
+            }
+
+            _capacity = std::max(capacity, _capacity * 2);
+            _data = static_cast<byte*>(_allocator.realloc(_data, _capacity));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// sets the size without touching the contents, bytes in the grown range must be written
+        /// through `get_data()`.
+        ///
+        /// \pre `size <= get_capacity()`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto set_size(usize size) -> void
+        {
+            contract_debug_expects(size <= _capacity, "size is more than capacity.");
+
+            _size = size;
+        }
+
         template <typename value_type>
         constexpr auto set_to_std_vector(const std::vector<value_type>& vector) -> void
         {
@@ -193,6 +235,8 @@ namespace atom
         allocator_type _allocator;
     };
 
+    export using dynamic_buffer = basic_dynamic_buffer<default_mem_allocator>;
+
     export class memory_view
     {
     public:
@@ -0,0 +1,134 @@
+module;
+#include "atom/core/preprocessors.h"
+
+#if defined(__linux__) and __has_include(<linux/futex.h>)
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+
+#    if defined(SYS_futex)
+#        define ATOM_FUTEX
+#    endif
+#endif
+
+export module atom_core:futex;
+
+import std;
+import :core;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// blocks threads on a 32 bit word, using futex on linux and `std::atomic::wait()` elsewhere.
+    /// --------------------------------------------------------------------------------------------
+    class _futex
+    {
+        static_assert(sizeof(std::atomic<u32>) == sizeof(u32));
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// blocks the calling thread while `word` is `expected`. may return spuriously.
+        /// ----------------------------------------------------------------------------------------
+        static auto wait(std::atomic<u32>& word, u32 expected) -> void
+        {
+#if defined(ATOM_FUTEX)
+            ::syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAIT_PRIVATE, expected,
+                nullptr, nullptr, 0);
+#else
+            word.wait(expected, std::memory_order_acquire);
+#endif
+        }
+
+        static auto wake_one(std::atomic<u32>& word) -> void
+        {
+#if defined(ATOM_FUTEX)
+            ::syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr,
+                nullptr, 0);
+#else
+            word.notify_one();
+#endif
+        }
+
+        static auto wake_all(std::atomic<u32>& word) -> void
+        {
+#if defined(ATOM_FUTEX)
+            ::syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAKE_PRIVATE,
+                std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+#else
+            word.notify_all();
+#endif
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lets threads sleep until some condition they check themselves changes, without a mutex.
+    ///
+    /// a thread calls `prepare_wait()`, checks the condition again and then calls `commit_wait()`
+    /// or `cancel_wait()`. notifications after `prepare_wait()` make `commit_wait()` return.
+    /// --------------------------------------------------------------------------------------------
+    class _event_count
+    {
+    public:
+        _event_count()
+            : _epoch{ 0 }
+            , _waiter_count{ 0 }
+        {}
+
+    public:
+        auto prepare_wait() -> u32
+        {
+            _waiter_count.fetch_add(1, std::memory_order_seq_cst);
+            return _epoch.load(std::memory_order_seq_cst);
+        }
+
+        auto commit_wait(u32 key) -> void
+        {
+            _futex::wait(_epoch, key);
+            _waiter_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        auto cancel_wait() -> void
+        {
+            _waiter_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// wakes one waiting thread. changes made before the call are visible to the threads
+        /// checking their condition after `prepare_wait()`.
+        /// ----------------------------------------------------------------------------------------
+        auto notify_one() -> void
+        {
+            if (not _begin_notify())
+                return;
+
+            _futex::wake_one(_epoch);
+        }
+
+        auto notify_all() -> void
+        {
+            if (not _begin_notify())
+                return;
+
+            _futex::wake_all(_epoch);
+        }
+
+    private:
+        auto _begin_notify() -> bool
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (_waiter_count.load(std::memory_order_relaxed) == 0)
+                return false;
+
+            _epoch.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::atomic<u32> _epoch;
+        std::atomic<u32> _waiter_count;
+    };
+}
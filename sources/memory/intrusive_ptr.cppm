@@ -0,0 +1,316 @@
+module;
+#include "atom/core/preprocessors.h"
+
+export module atom_core:intrusive_ptr;
+
+import std;
+import :core;
+import :types;
+import :default_mem_allocator;
+import :shared_ptr;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// base class for values managed by `intrusive_ptr`, which keeps the reference count inside
+    /// the value.
+    ///
+    /// if `in_is_atomic` is `true`, the count is updated atomically and the value can be shared
+    /// across threads.
+    ///
+    /// \note copying a value doesn't copy its count, the copy is a new value with no references.
+    /// --------------------------------------------------------------------------------------------
+    export template <bool in_is_atomic = true>
+    class intrusive_ref_counted
+    {
+    public:
+        constexpr intrusive_ref_counted()
+            : _ref_count{ 0 }
+        {}
+
+        constexpr intrusive_ref_counted(const intrusive_ref_counted& that)
+            : _ref_count{ 0 }
+        {}
+
+        constexpr intrusive_ref_counted& operator=(const intrusive_ref_counted& that)
+        {
+            return *this;
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of `intrusive_ptr`s referring to this value.
+        /// ----------------------------------------------------------------------------------------
+        auto get_ref_count() const -> usize
+        {
+            return _ref_count.get();
+        }
+
+        auto increase_ref_count() const -> void
+        {
+            _ref_count.increase();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if count reached `0`.
+        /// ----------------------------------------------------------------------------------------
+        auto decrease_ref_count() const -> bool
+        {
+            return _ref_count.decrease();
+        }
+
+    private:
+        mutable _shared_ptr_count<in_is_atomic> _ref_count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// pointer sharing ownership of a value which keeps its own reference count, usually by
+    /// deriving from `intrusive_ref_counted`.
+    ///
+    /// unlike `shared_ptr` there is no separate state, the pointer is a single pointer and reaching
+    /// the count doesn't touch another cache line. the value is destroyed using `destroyer_type`
+    /// when the count reaches `0`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type,
+        typename in_destroyer_type = shared_ptr_default_destroyer<in_value_type>>
+    class intrusive_ptr
+    {
+        static_assert(
+            type_info<in_value_type>::is_pure(), "intrusive_ptr only supports pure types.");
+        static_assert(
+            not type_info<in_value_type>::is_void(), "intrusive_ptr does not support void.");
+
+    private:
+        using this_type = intrusive_ptr;
+
+        template <typename that_value_type, typename that_destroyer_type>
+        friend class intrusive_ptr;
+
+    public:
+        using value_type = in_value_type;
+        using destroyer_type = in_destroyer_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr intrusive_ptr(destroyer_type destroyer = destroyer_type())
+            : _ptr(nullptr)
+            , _destroyer(move(destroyer))
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # null constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr intrusive_ptr(nullptr_t)
+            : this_type()
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # value constructor
+        ///
+        /// adds a reference to `ptr`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr explicit intrusive_ptr(
+            value_type* ptr, destroyer_type destroyer = destroyer_type())
+            : _ptr(ptr)
+            , _destroyer(move(destroyer))
+        {
+            _check_and_increase_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr intrusive_ptr(const intrusive_ptr& that)
+            : _ptr(that._ptr)
+            , _destroyer(that._destroyer)
+        {
+            _check_and_increase_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # template copy constructor
+        ///
+        /// the destroyer of `that` must convert to `destroyer_type`. the default destroyer of a
+        /// derived type converts to the default destroyer of its base, if the base has a virtual
+        /// destructor.
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type, typename that_destroyer_type>
+        constexpr intrusive_ptr(const intrusive_ptr<that_type, that_destroyer_type>& that)
+            requires(type_info<that_type>::template is_same_or_derived_from<value_type>()
+                     and std::is_constructible_v<destroyer_type, const that_destroyer_type&>)
+            : _ptr(that._ptr)
+            , _destroyer(that._destroyer)
+        {
+            _check_and_increase_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        constexpr intrusive_ptr& operator=(const intrusive_ptr& that)
+        {
+            _assign(that._ptr, that._destroyer);
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # template copy operator
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type, typename that_destroyer_type>
+        constexpr intrusive_ptr& operator=(
+            const intrusive_ptr<that_type, that_destroyer_type>& that)
+            requires(type_info<that_type>::template is_same_or_derived_from<value_type>()
+                     and std::is_constructible_v<destroyer_type, const that_destroyer_type&>)
+        {
+            _assign(that._ptr, destroyer_type(that._destroyer));
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr intrusive_ptr(intrusive_ptr&& that)
+            : _ptr(that._ptr)
+            , _destroyer(move(that._destroyer))
+        {
+            that._ptr = nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # template move constructor
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type, typename that_destroyer_type>
+        constexpr intrusive_ptr(intrusive_ptr<that_type, that_destroyer_type>&& that)
+            requires(type_info<that_type>::template is_same_or_derived_from<value_type>()
+                     and std::is_constructible_v<destroyer_type, that_destroyer_type&&>)
+            : _ptr(that._ptr)
+            , _destroyer(move(that._destroyer))
+        {
+            that._ptr = nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move operator
+        /// ----------------------------------------------------------------------------------------
+        constexpr intrusive_ptr& operator=(intrusive_ptr&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            _check_and_release();
+
+            _ptr = that._ptr;
+            _destroyer = move(that._destroyer);
+            that._ptr = nullptr;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # null operator
+        /// ----------------------------------------------------------------------------------------
+        constexpr intrusive_ptr& operator=(nullptr_t)
+        {
+            set(nullptr);
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr ~intrusive_ptr()
+        {
+            _check_and_release();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// releases the current value and adds a reference to `ptr`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto set(value_type* ptr) -> void
+        {
+            if (ptr != nullptr)
+                ptr->increase_ref_count();
+
+            _check_and_release();
+            _ptr = ptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// releases the current value.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto set(nullptr_t) -> void
+        {
+            _check_and_release();
+            _ptr = nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of references to the value.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_count() const -> usize
+        {
+            return _ptr == nullptr ? 0 : _ptr->get_ref_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the underlying ptr.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto to_unwrapped() const -> const value_type*
+        {
+            return _ptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the underlying ptr.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto to_unwrapped() -> value_type*
+        {
+            return _ptr;
+        }
+
+    private:
+        template <typename that_value_type>
+        constexpr auto _assign(that_value_type* ptr, const destroyer_type& destroyer) -> void
+        {
+            // increase first, `ptr` may be the value we hold the last reference to.
+            if (ptr != nullptr)
+                ptr->increase_ref_count();
+
+            _check_and_release();
+
+            _ptr = ptr;
+            _destroyer = destroyer;
+        }
+
+        constexpr auto _check_and_increase_count() -> void
+        {
+            if (_ptr != nullptr)
+                _ptr->increase_ref_count();
+        }
+
+        constexpr auto _check_and_release() -> void
+        {
+            if (_ptr != nullptr and _ptr->decrease_ref_count())
+                _destroyer(_ptr);
+        }
+
+    private:
+        value_type* _ptr;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS destroyer_type _destroyer;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// creates value with `args` using `default_mem_allocator`, and returns `intrusive_ptr` to it.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename value_type, typename... arg_types>
+    auto make_intrusive(arg_types&&... args) -> intrusive_ptr<value_type>
+    {
+        value_type* ptr =
+            static_cast<value_type*>(default_mem_allocator().alloc(sizeof(value_type)));
+        type_utils::construct_as<value_type>(ptr, forward<arg_types>(args)...);
+
+        return intrusive_ptr<value_type>(ptr);
+    }
+}
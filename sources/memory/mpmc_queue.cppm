@@ -0,0 +1,335 @@
+export module atom_core:mpmc_queue;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :futex;
+import :default_mem_allocator;
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// bounded lock free queue, for any count of threads pushing and popping.
+    ///
+    /// each slot has a sequence number telling which lap of the ring it's on and whether it holds
+    /// a value, as in dmitry vyukov's bounded mpmc queue. a push or pop claims a position with a
+    /// single compare and swap, then waits on nothing but the slot it claimed.
+    ///
+    /// `push()` and `pop()` block while the queue is full or empty, sleeping on a futex. batches
+    /// push or pop values one by one, but check for sleeping threads once.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type>
+    class mpmc_queue
+    {
+        using this_type = mpmc_queue;
+
+    public:
+        using value_type = in_value_type;
+
+    private:
+        static_assert(type_info<value_type>::is_pure(), "value type must be pure.");
+        static_assert(alignof(value_type) <= alignof(std::max_align_t),
+            "over aligned value types are not supported.");
+
+        static constexpr usize _cache_line_size = 64;
+
+        class _slot
+        {
+        public:
+            std::atomic<usize> sequence;
+            alignas(value_type) byte storage[sizeof(value_type)];
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # constructor
+        ///
+        /// creates a queue which can hold `capacity` values, rounded up to a power of two.
+        ///
+        /// \pre `capacity > 1`.
+        /// ----------------------------------------------------------------------------------------
+        explicit mpmc_queue(usize capacity)
+            : _push_pos{ 0 }
+            , _pop_pos{ 0 }
+            , _mask{ std::bit_ceil(capacity) - 1 }
+        {
+            contract_expects(capacity > 1, "capacity must be atleast 2.");
+
+            void* mem = default_mem_allocator().alloc(sizeof(_slot) * (_mask + 1));
+            _slots = static_cast<_slot*>(mem);
+
+            for (usize i = 0; i <= _mask; i++)
+                std::construct_at(&_slots[i].sequence, i);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        mpmc_queue(const this_type& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(const this_type& that) -> this_type& = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// destroys values left in the queue.
+        /// ----------------------------------------------------------------------------------------
+        ~mpmc_queue()
+        {
+            while (_try_pop_one<value_type>(nullptr))
+            {}
+
+            default_mem_allocator().dealloc(_slots);
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// pushes `value` if the queue isn't full.
+        ///
+        /// \returns `true` if pushed, else `value` is left as it was.
+        /// ----------------------------------------------------------------------------------------
+        auto try_push(const value_type& value) -> bool
+        {
+            if (not _try_push_one(value))
+                return false;
+
+            _not_empty.notify_one();
+            return true;
+        }
+
+        auto try_push(value_type&& value) -> bool
+        {
+            if (not _try_push_one(move(value)))
+                return false;
+
+            _not_empty.notify_one();
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops a value if the queue isn't empty.
+        /// ----------------------------------------------------------------------------------------
+        auto try_pop() -> option<value_type>
+        {
+            option<value_type> value;
+            if (not _try_pop_one(&value))
+                return value;
+
+            _not_full.notify_one();
+            return value;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves values from `values` to the queue, until it's full.
+        ///
+        /// \returns count of values pushed, the first ones of `values`.
+        /// ----------------------------------------------------------------------------------------
+        auto try_push_batch(value_type* values, usize count) -> usize
+        {
+            usize pushed = 0;
+            while (pushed < count and _try_push_one(move(values[pushed])))
+                pushed++;
+
+            if (pushed > 0)
+                _not_empty.notify_all();
+
+            return pushed;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops upto `count` values, constructing them in `out` which must have space for them.
+        ///
+        /// \returns count of values popped.
+        /// ----------------------------------------------------------------------------------------
+        auto try_pop_batch(value_type* out, usize count) -> usize
+        {
+            usize popped = 0;
+            while (popped < count and _try_pop_one(out + popped))
+                popped++;
+
+            if (popped > 0)
+                _not_full.notify_all();
+
+            return popped;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pushes `value`, blocking while the queue is full.
+        /// ----------------------------------------------------------------------------------------
+        auto push(value_type value) -> void
+        {
+            while (not try_push(move(value)))
+            {
+                u32 key = _not_full.prepare_wait();
+
+                if (not _is_full())
+                {
+                    _not_full.cancel_wait();
+                    continue;
+                }
+
+                _not_full.commit_wait(key);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops a value, blocking while the queue is empty.
+        /// ----------------------------------------------------------------------------------------
+        auto pop() -> value_type
+        {
+            while (true)
+            {
+                if (option<value_type> value = try_pop(); value.is_value())
+                    return move(value.get());
+
+                u32 key = _not_empty.prepare_wait();
+
+                if (not _is_empty())
+                {
+                    _not_empty.cancel_wait();
+                    continue;
+                }
+
+                _not_empty.commit_wait(key);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of values in the queue, which may have changed by the time it's used.
+        /// ----------------------------------------------------------------------------------------
+        auto get_count() const -> usize
+        {
+            usize pop_pos = _pop_pos.load(std::memory_order_acquire);
+            usize push_pos = _push_pos.load(std::memory_order_acquire);
+            return push_pos > pop_pos ? push_pos - pop_pos : 0;
+        }
+
+        auto get_capacity() const -> usize
+        {
+            return _mask + 1;
+        }
+
+    private:
+        template <typename that_value_type>
+        auto _try_push_one(that_value_type&& value) -> bool
+        {
+            usize pos = _push_pos.load(std::memory_order_relaxed);
+            _slot* slot;
+
+            while (true)
+            {
+                slot = &_slots[pos & _mask];
+                usize sequence = slot->sequence.load(std::memory_order_acquire);
+                isize diff = isize(sequence) - isize(pos);
+
+                if (diff == 0)
+                {
+                    if (_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    // the slot still holds the value from the previous lap.
+                    return false;
+                }
+                else
+                {
+                    pos = _push_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::construct_at(_get_value(slot), forward<that_value_type>(value));
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops a value into `out`, or destroys it if `out` is `nullptr`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename out_type>
+        auto _try_pop_one(out_type* out) -> bool
+        {
+            usize pos = _pop_pos.load(std::memory_order_relaxed);
+            _slot* slot;
+
+            while (true)
+            {
+                slot = &_slots[pos & _mask];
+                usize sequence = slot->sequence.load(std::memory_order_acquire);
+                isize diff = isize(sequence) - isize(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    // no value was pushed to the slot in this lap yet.
+                    return false;
+                }
+                else
+                {
+                    pos = _pop_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            value_type* value = _get_value(slot);
+            if (out != nullptr)
+                _construct_out(out, move(*value));
+
+            std::destroy_at(value);
+            slot->sequence.store(pos + _mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        static auto _construct_out(value_type* out, value_type&& value) -> void
+        {
+            std::construct_at(out, move(value));
+        }
+
+        static auto _construct_out(option<value_type>* out, value_type&& value) -> void
+        {
+            out->emplace(move(value));
+        }
+
+        auto _is_full() const -> bool
+        {
+            usize pos = _push_pos.load(std::memory_order_relaxed);
+            usize sequence = _slots[pos & _mask].sequence.load(std::memory_order_acquire);
+            return isize(sequence) - isize(pos) < 0;
+        }
+
+        auto _is_empty() const -> bool
+        {
+            usize pos = _pop_pos.load(std::memory_order_relaxed);
+            usize sequence = _slots[pos & _mask].sequence.load(std::memory_order_acquire);
+            return isize(sequence) - isize(pos + 1) < 0;
+        }
+
+        static auto _get_value(_slot* slot) -> value_type*
+        {
+            return reinterpret_cast<value_type*>(slot->storage);
+        }
+
+    private:
+        std::atomic<usize> _push_pos;
+        byte _push_padding[_cache_line_size];
+
+        std::atomic<usize> _pop_pos;
+        byte _pop_padding[_cache_line_size];
+
+        // shared, read only.
+        usize _mask;
+        _slot* _slots;
+        _event_count _not_empty;
+        _event_count _not_full;
+    };
+}
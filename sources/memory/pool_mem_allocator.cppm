@@ -0,0 +1,538 @@
+export module atom_core:pool_mem_allocator;
+
+import std;
+import :core;
+import :contracts;
+import :mutex;
+import :lock_guard;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    class _pool_heap;
+
+    /// --------------------------------------------------------------------------------------------
+    /// sizes and size classes used by `pool_mem_allocator`.
+    ///
+    /// sizes upto 128 bytes are rounded to multiples of 16 bytes. bigger sizes upto
+    /// `max_small_size` get 4 classes per power of two, so no more than 25% is wasted.
+    /// --------------------------------------------------------------------------------------------
+    class _pool_size_classes
+    {
+    public:
+        static constexpr usize span_size = 64 * 1024;
+        static constexpr usize spans_per_chunk = 16;
+        static constexpr usize max_small_size = 8 * 1024;
+        static constexpr usize class_count = 8 + 6 * 4;
+
+    public:
+        static constexpr auto get_class(usize size) -> usize
+        {
+            if (size <= 128)
+                return size == 0 ? 0 : (size + 15) / 16 - 1;
+
+            // `size` is in `(2^(pow - 1), 2^pow]`, divided in 4 steps of `2^(pow - 3)`.
+            usize pow = std::bit_width(size - 1);
+            usize step = usize(1) << (pow - 3);
+            usize base = usize(1) << (pow - 1);
+            return 8 + (pow - 8) * 4 + (size - base + step - 1) / step - 1;
+        }
+
+        static constexpr auto get_block_size(usize size_class) -> usize
+        {
+            if (size_class < 8)
+                return (size_class + 1) * 16;
+
+            usize pow = 8 + (size_class - 8) / 4;
+            usize steps = (size_class - 8) % 4 + 1;
+            return (usize(1) << (pow - 1)) + steps * (usize(1) << (pow - 3));
+        }
+    };
+
+    static_assert(_pool_size_classes::get_class(1) == 0);
+    static_assert(_pool_size_classes::get_class(16) == 0);
+    static_assert(_pool_size_classes::get_class(17) == 1);
+    static_assert(_pool_size_classes::get_class(129) == 8);
+    static_assert(_pool_size_classes::get_block_size(8) == 160);
+    static_assert(
+        _pool_size_classes::get_class(_pool_size_classes::max_small_size)
+        == _pool_size_classes::class_count - 1);
+    static_assert(_pool_size_classes::get_block_size(_pool_size_classes::class_count - 1)
+                  == _pool_size_classes::max_small_size);
+
+    /// --------------------------------------------------------------------------------------------
+    /// `span_size` aligned block of memory, carved into blocks of a single size class. the header
+    /// lives at the start of the span, so the span of any block is found by masking its address.
+    ///
+    /// all fields except `remote_free` and `is_remote_queued` are only touched by the thread
+    /// owning `owner`.
+    /// --------------------------------------------------------------------------------------------
+    class alignas(64) _pool_span
+    {
+    public:
+        _pool_span(_pool_heap* owner, usize size_class)
+            : owner{ owner }
+            , size_class{ size_class }
+            , block_size{ _pool_size_classes::get_block_size(size_class) }
+            , local_free{ nullptr }
+            , bump{ reinterpret_cast<byte*>(this) + sizeof(_pool_span) }
+            , end{ bump + _get_blocks_size(block_size) }
+            , next_available{ nullptr }
+            , is_available{ false }
+            , next_remote{ nullptr }
+            , remote_free{ nullptr }
+            , is_remote_queued{ false }
+        {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns size of all the blocks fitting in a span after its header.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto _get_blocks_size(usize block_size) -> usize
+        {
+            return (_pool_size_classes::span_size - sizeof(_pool_span)) / block_size * block_size;
+        }
+
+        static auto get_from_block(void* mem) -> _pool_span*
+        {
+            return reinterpret_cast<_pool_span*>(
+                reinterpret_cast<usize>(mem) & ~(_pool_size_classes::span_size - 1));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns a free block or `nullptr`.
+        /// ----------------------------------------------------------------------------------------
+        auto pop() -> void*
+        {
+            if (local_free != nullptr)
+            {
+                void* mem = local_free;
+                local_free = *static_cast<void**>(mem);
+                return mem;
+            }
+
+            if (bump != end)
+            {
+                void* mem = bump;
+                bump += block_size;
+                return mem;
+            }
+
+            return nullptr;
+        }
+
+        auto push_local(void* mem) -> void
+        {
+            *static_cast<void**>(mem) = local_free;
+            local_free = mem;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves blocks freed by other threads to `local_free`.
+        /// ----------------------------------------------------------------------------------------
+        auto collect_remote() -> void
+        {
+            void* list = remote_free.exchange(nullptr, std::memory_order_acquire);
+            while (list != nullptr)
+            {
+                void* next = *static_cast<void**>(list);
+                push_local(list);
+                list = next;
+            }
+        }
+
+    public:
+        _pool_heap* owner;
+        usize size_class;
+        usize block_size;
+        void* local_free;
+        byte* bump;
+        byte* end;
+        _pool_span* next_available;
+        bool is_available;
+        _pool_span* next_remote;
+
+        // written by other threads, kept away from the fields above.
+        alignas(64) std::atomic<void*> remote_free;
+        std::atomic<bool> is_remote_queued;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// tracks which `span_size` aligned addresses are spans, so `dealloc` can tell pool blocks from
+    /// memory allocated by `std::malloc`.
+    ///
+    /// two level bitmap covering 48 bit addresses. the top level is zero initialized static
+    /// storage, leaves are allocated on first use and never freed.
+    /// --------------------------------------------------------------------------------------------
+    class _pool_span_map
+    {
+        static constexpr usize _span_shift = 16;
+        static constexpr usize _leaf_shift = 32;
+        static constexpr usize _leaf_count = usize(1) << (48 - _leaf_shift);
+        static constexpr usize _words_per_leaf = (usize(1) << (_leaf_shift - _span_shift)) / 64;
+
+        static_assert(usize(1) << _span_shift == _pool_size_classes::span_size);
+
+        class _leaf
+        {
+        public:
+            std::atomic<u64> words[_words_per_leaf];
+        };
+
+    public:
+        static auto insert(void* span) -> void
+        {
+            usize addr = reinterpret_cast<usize>(span);
+            contract_asserts((addr >> 48) == 0, "pool span address is out of range.");
+
+            _leaf* leaf = _leaves[addr >> _leaf_shift].load(std::memory_order_acquire);
+            if (leaf == nullptr)
+            {
+                _leaf* new_leaf = static_cast<_leaf*>(std::calloc(1, sizeof(_leaf)));
+                contract_asserts(new_leaf != nullptr, "failed to allocate pool span map.");
+
+                if (_leaves[addr >> _leaf_shift].compare_exchange_strong(
+                        leaf, new_leaf, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    leaf = new_leaf;
+                }
+                else
+                {
+                    std::free(new_leaf);
+                }
+            }
+
+            usize bit = (addr >> _span_shift) & (_words_per_leaf * 64 - 1);
+            leaf->words[bit / 64].fetch_or(u64(1) << (bit % 64), std::memory_order_release);
+        }
+
+        static auto contains(const void* mem) -> bool
+        {
+            usize addr = reinterpret_cast<usize>(mem);
+            if ((addr >> 48) != 0)
+                return false;
+
+            _leaf* leaf = _leaves[addr >> _leaf_shift].load(std::memory_order_acquire);
+            if (leaf == nullptr)
+                return false;
+
+            usize bit = (addr >> _span_shift) & (_words_per_leaf * 64 - 1);
+            return (leaf->words[bit / 64].load(std::memory_order_acquire) >> (bit % 64)) & 1;
+        }
+
+    private:
+        static inline std::atomic<_leaf*> _leaves[_leaf_count];
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// per thread cache of spans, one current span and a stack of spans with free blocks for each
+    /// size class.
+    ///
+    /// heaps are never destroyed. when a thread exits its heap is abandoned and adopted by the
+    /// next thread which needs one, blocks freed into it meanwhile are kept as remote frees.
+    /// --------------------------------------------------------------------------------------------
+    class _pool_heap
+    {
+    public:
+        _pool_heap()
+            : _current{}
+            , _available{}
+            , _chunk_cursor{ nullptr }
+            , _chunk_end{ nullptr }
+            , _remote_spans{ nullptr }
+            , _next_abandoned{ nullptr }
+        {}
+
+    public:
+        auto alloc(usize size_class) -> void*
+        {
+            _pool_span* span = _current[size_class];
+            if (span != nullptr)
+            {
+                if (void* mem = span->pop())
+                    return mem;
+            }
+
+            return _alloc_slow(size_class);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// frees `mem` which belongs to `span` owned by this heap.
+        /// ----------------------------------------------------------------------------------------
+        auto dealloc_local(_pool_span* span, void* mem) -> void
+        {
+            span->push_local(mem);
+
+            if (not span->is_available and span != _current[span->size_class])
+                _push_available(span);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// frees `mem` which belongs to `span` owned by some other thread's heap. lock free.
+        /// ----------------------------------------------------------------------------------------
+        static auto dealloc_remote(_pool_span* span, void* mem) -> void
+        {
+            void* head = span->remote_free.load(std::memory_order_relaxed);
+            do
+            {
+                *static_cast<void**>(mem) = head;
+            } while (not span->remote_free.compare_exchange_weak(
+                head, mem, std::memory_order_release, std::memory_order_relaxed));
+
+            // let the owner know this span has remote frees, once until it collects them.
+            if (not span->is_remote_queued.exchange(true, std::memory_order_acq_rel))
+            {
+                _pool_heap* owner = span->owner;
+                _pool_span* spans = owner->_remote_spans.load(std::memory_order_relaxed);
+                do
+                {
+                    span->next_remote = spans;
+                } while (not owner->_remote_spans.compare_exchange_weak(
+                    spans, span, std::memory_order_release, std::memory_order_relaxed));
+            }
+        }
+
+        static auto acquire() -> _pool_heap*
+        {
+            {
+                lock_guard guard{ _abandoned_lock };
+                if (_pool_heap* heap = _abandoned)
+                {
+                    _abandoned = heap->_next_abandoned;
+                    heap->_next_abandoned = nullptr;
+                    return heap;
+                }
+            }
+
+            void* mem = std::malloc(sizeof(_pool_heap));
+            contract_asserts(mem != nullptr, "failed to allocate pool heap.");
+
+            return std::construct_at(static_cast<_pool_heap*>(mem));
+        }
+
+        static auto abandon(_pool_heap* heap) -> void
+        {
+            lock_guard guard{ _abandoned_lock };
+            heap->_next_abandoned = _abandoned;
+            _abandoned = heap;
+        }
+
+    private:
+        auto _alloc_slow(usize size_class) -> void*
+        {
+            if (void* mem = _alloc_from_available(size_class))
+                return mem;
+
+            _collect_remote_spans();
+            if (void* mem = _alloc_from_available(size_class))
+                return mem;
+
+            // the current span isn't made available when its blocks are collected.
+            if (_pool_span* span = _current[size_class])
+            {
+                if (void* mem = span->pop())
+                    return mem;
+            }
+
+            _pool_span* span = _create_span(size_class);
+            _current[size_class] = span;
+            return span->pop();
+        }
+
+        auto _alloc_from_available(usize size_class) -> void*
+        {
+            while (_pool_span* span = _available[size_class])
+            {
+                _available[size_class] = span->next_available;
+                span->is_available = false;
+
+                if (void* mem = span->pop())
+                {
+                    _current[size_class] = span;
+                    return mem;
+                }
+            }
+
+            return nullptr;
+        }
+
+        auto _push_available(_pool_span* span) -> void
+        {
+            span->next_available = _available[span->size_class];
+            span->is_available = true;
+            _available[span->size_class] = span;
+        }
+
+        auto _collect_remote_spans() -> void
+        {
+            _pool_span* span = _remote_spans.exchange(nullptr, std::memory_order_acquire);
+            while (span != nullptr)
+            {
+                // read the link before clearing the flag, after which the span may be queued
+                // again by another thread.
+                _pool_span* next = span->next_remote;
+                span->is_remote_queued.store(false, std::memory_order_release);
+                span->collect_remote();
+
+                if (not span->is_available and span != _current[span->size_class])
+                    _push_available(span);
+
+                span = next;
+            }
+        }
+
+        auto _create_span(usize size_class) -> _pool_span*
+        {
+            if (_chunk_cursor == _chunk_end)
+            {
+                constexpr usize chunk_size =
+                    _pool_size_classes::span_size * _pool_size_classes::spans_per_chunk;
+
+                void* chunk = std::aligned_alloc(_pool_size_classes::span_size, chunk_size);
+                contract_asserts(chunk != nullptr, "failed to allocate pool chunk.");
+
+                _chunk_cursor = static_cast<byte*>(chunk);
+                _chunk_end = _chunk_cursor + chunk_size;
+            }
+
+            void* mem = _chunk_cursor;
+            _chunk_cursor += _pool_size_classes::span_size;
+
+            _pool_span* span = std::construct_at(static_cast<_pool_span*>(mem), this, size_class);
+            _pool_span_map::insert(span);
+            return span;
+        }
+
+    private:
+        _pool_span* _current[_pool_size_classes::class_count];
+        _pool_span* _available[_pool_size_classes::class_count];
+        byte* _chunk_cursor;
+        byte* _chunk_end;
+        std::atomic<_pool_span*> _remote_spans;
+        _pool_heap* _next_abandoned;
+
+        static inline simple_mutex _abandoned_lock;
+        static inline _pool_heap* _abandoned = nullptr;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// owns the heap of the current thread, abandoning it on thread exit.
+    /// --------------------------------------------------------------------------------------------
+    class _pool_thread_heap
+    {
+    public:
+        constexpr _pool_thread_heap()
+            : _heap{ nullptr }
+        {}
+
+        ~_pool_thread_heap()
+        {
+            if (_heap != nullptr)
+            {
+                _pool_heap::abandon(_heap);
+                _heap = nullptr;
+            }
+        }
+
+    public:
+        auto get() -> _pool_heap*
+        {
+            if (_heap == nullptr)
+                _heap = _pool_heap::acquire();
+
+            return _heap;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns the heap without acquiring one, may be `nullptr`.
+        /// ----------------------------------------------------------------------------------------
+        auto peek() const -> _pool_heap*
+        {
+            return _heap;
+        }
+
+    private:
+        _pool_heap* _heap;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// size class slab allocator with per thread caches.
+    ///
+    /// sizes upto 8 KiB are served from 64 KiB spans, each holding blocks of a single size class
+    /// and owned by one thread. allocation and freeing on the owning thread take no lock and no
+    /// atomic operation. blocks freed by other threads are pushed on a lock free list in their
+    /// span and collected by the owner when it runs out of blocks.
+    ///
+    /// bigger sizes are forwarded to `std::malloc`.
+    ///
+    /// \note spans are kept for reuse and not returned to the system.
+    /// --------------------------------------------------------------------------------------------
+    export class pool_mem_allocator
+    {
+    public:
+        auto alloc(usize size) -> void*
+        {
+            if (size > _pool_size_classes::max_small_size)
+                return std::malloc(size);
+
+            return _thread_heap.get()->alloc(_pool_size_classes::get_class(size));
+        }
+
+        auto realloc(void* mem, usize size) -> void*
+        {
+            if (mem == nullptr)
+                return alloc(size);
+
+            if (not _pool_span_map::contains(mem))
+            {
+                if (size > _pool_size_classes::max_small_size)
+                    return std::realloc(mem, size);
+
+                // shrinking a big allocation into a small one, we don't know its size but it's
+                // bigger than `size`.
+                void* new_mem = alloc(size);
+                std::memcpy(new_mem, mem, size);
+                std::free(mem);
+                return new_mem;
+            }
+
+            usize block_size = _pool_span::get_from_block(mem)->block_size;
+            if (size <= block_size and size > block_size / 2)
+                return mem;
+
+            void* new_mem = alloc(size);
+            std::memcpy(new_mem, mem, size < block_size ? size : block_size);
+            dealloc(mem);
+            return new_mem;
+        }
+
+        auto dealloc(void* mem) -> void
+        {
+            if (mem == nullptr)
+                return;
+
+            if (not _pool_span_map::contains(mem))
+            {
+                std::free(mem);
+                return;
+            }
+
+            _pool_span* span = _pool_span::get_from_block(mem);
+            if (span->owner == _thread_heap.peek())
+                span->owner->dealloc_local(span, mem);
+            else
+                _pool_heap::dealloc_remote(span, mem);
+        }
+
+    private:
+        static inline thread_local _pool_thread_heap _thread_heap;
+    };
+}
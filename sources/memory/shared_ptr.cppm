@@ -1,5 +1,6 @@
 export module atom_core:shared_ptr;
 
+import std;
 import :core;
 import :types;
 import :unique_ptr;
@@ -54,24 +55,97 @@ namespace atom
         }
     };
 
-    class _shared_ptr_state
+    /// --------------------------------------------------------------------------------------------
+    /// reference count shared by `basic_shared_ptr`s.
+    ///
+    /// the atomic count follows the usual scheme: increments are relaxed as a new reference can
+    /// only be made from an existing one, the last decrement is acquire release so all writes to
+    /// the value through other references happen before it's destroyed.
+    /// --------------------------------------------------------------------------------------------
+    template <bool is_atomic>
+    class _shared_ptr_count
     {
     public:
-        virtual auto destroy(void* ptr) -> void = 0;
+        constexpr _shared_ptr_count(usize count)
+            : _count{ count }
+        {}
 
-        virtual auto dealloc_self() -> void = 0;
+    public:
+        auto increase() -> void
+        {
+            _count.fetch_add(1, std::memory_order_relaxed);
+        }
 
-        constexpr auto increase_count()
+        /// ----------------------------------------------------------------------------------------
+        /// increases the count if it's not `0`.
+        ///
+        /// \returns `true` if the count was increased.
+        /// ----------------------------------------------------------------------------------------
+        auto try_increase() -> bool
+        {
+            usize count = _count.load(std::memory_order_relaxed);
+            while (count != 0)
+            {
+                if (_count.compare_exchange_weak(
+                        count, count + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if this was the last reference.
+        /// ----------------------------------------------------------------------------------------
+        auto decrease() -> bool
+        {
+            if (_count.fetch_sub(1, std::memory_order_release) != 1)
+                return false;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return true;
+        }
+
+        auto get() const -> usize
+        {
+            return _count.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<usize> _count;
+    };
+
+    template <>
+    class _shared_ptr_count<false>
+    {
+    public:
+        constexpr _shared_ptr_count(usize count)
+            : _count{ count }
+        {}
+
+    public:
+        constexpr auto increase() -> void
         {
             _count++;
         }
 
-        constexpr auto decrease_count()
+        constexpr auto try_increase() -> bool
         {
-            _count--;
+            if (_count == 0)
+                return false;
+
+            _count++;
+            return true;
         }
 
-        constexpr auto get_count() const -> usize
+        constexpr auto decrease() -> bool
+        {
+            return --_count == 0;
+        }
+
+        constexpr auto get() const -> usize
         {
             return _count;
         }
@@ -80,9 +154,82 @@ namespace atom
         usize _count;
     };
 
-    template <typename value_type, typename destroyer_type, typename allocator_type>
+    /// --------------------------------------------------------------------------------------------
+    /// state shared by `basic_shared_ptr`s and `basic_weak_ptr`s of a value.
+    ///
+    /// the weak count is the count of weak pointers, plus one held by all the shared pointers
+    /// together. the value is destroyed when the count reaches `0` and the state is freed when
+    /// the weak count reaches `0`.
+    /// --------------------------------------------------------------------------------------------
+    template <bool is_atomic>
+    class _shared_ptr_state
+    {
+    public:
+        constexpr _shared_ptr_state()
+            : _count{ 1 }
+            , _weak_count{ 1 }
+        {}
+
+    public:
+        virtual auto destroy(void* ptr) -> void = 0;
+
+        virtual auto dealloc_self() -> void = 0;
+
+        auto increase_count() -> void
+        {
+            _count.increase();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// increases count if the value is still alive.
+        ///
+        /// \returns `true` if count was increased.
+        /// ----------------------------------------------------------------------------------------
+        auto try_increase_count() -> bool
+        {
+            return _count.try_increase();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// decreases count, destroying the value pointed by `ptr` if it reaches `0` and freeing
+        /// the state if there are no weak pointers left.
+        /// ----------------------------------------------------------------------------------------
+        auto release(void* ptr) -> void
+        {
+            if (_count.decrease())
+            {
+                destroy(ptr);
+                release_weak();
+            }
+        }
+
+        auto get_count() const -> usize
+        {
+            return _count.get();
+        }
+
+        auto increase_weak_count() -> void
+        {
+            _weak_count.increase();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// decreases weak count, freeing the state if it reaches `0`.
+        /// ----------------------------------------------------------------------------------------
+        auto release_weak() -> void
+        {
+            if (_weak_count.decrease())
+                dealloc_self();
+        }
+
+    private:
+        _shared_ptr_count<is_atomic> _count;
+        _shared_ptr_count<is_atomic> _weak_count;
+    };
+
+    template <typename value_type, bool is_atomic, typename destroyer_type, typename allocator_type>
     class _default_shared_ptr_state
-        : public _shared_ptr_state
+        : public _shared_ptr_state<is_atomic>
         , private ebo_helper<destroyer_type>
         , private ebo_helper<allocator_type>
     {
@@ -104,7 +251,24 @@ namespace atom
 
         virtual auto dealloc_self() -> void override final
         {
-            allocator_helper_type::get().dealloc(this);
+            // the allocator lives inside the memory being freed.
+            allocator_type allocator = move(allocator_helper_type::get());
+            this->~_default_shared_ptr_state();
+            allocator.dealloc(this);
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// destroyer for values created by `make_shared_with_alloc()`, which live in the same
+    /// allocation as their state. only destructs the value, the memory is freed with the state.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    class _shared_ptr_emplace_destroyer
+    {
+    public:
+        constexpr auto operator()(value_type* val)
+        {
+            type_utils::destruct_as<value_type>(val);
         }
     };
 }
@@ -128,22 +292,58 @@ export namespace atom
         static_assert(not type_info<value_type>::is_void(),
             "shared_ptr_default_destroyer does not support void.");
 
+    public:
+        constexpr shared_ptr_default_destroyer() = default;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # converting constructor
+        ///
+        /// destroyers of derived types convert to destroyers of their bases, if the base has a
+        /// virtual destructor.
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type>
+        constexpr shared_ptr_default_destroyer(const shared_ptr_default_destroyer<that_type>& that)
+            requires(std::is_base_of_v<value_type, that_type>
+                     and std::has_virtual_destructor_v<value_type>)
+        {}
+
     public:
         constexpr auto operator()(value_type* val)
         {
+            // the base may not be at the start of the value's memory.
+            void* mem = val;
+            if constexpr (std::is_polymorphic_v<value_type>)
+                mem = dynamic_cast<void*>(val);
+
             type_utils::destruct_as<value_type>(val);
-            default_mem_allocator().dealloc(val);
+            default_mem_allocator().dealloc(mem);
         }
     };
 
-    template <typename in_value_type>
-    class shared_ptr
+    template <typename value_type, bool is_atomic>
+    class basic_weak_ptr;
+
+    /// --------------------------------------------------------------------------------------------
+    /// pointer sharing ownership of a value through a reference count.
+    ///
+    /// if `in_is_atomic` is `true`, the count is updated atomically and copies of the same pointer
+    /// can be made and destroyed from different threads. else the count is a plain integer, which
+    /// is cheaper but must only be touched from one thread at a time.
+    ///
+    /// use `shared_ptr` and `local_shared_ptr` instead of naming this directly.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_value_type, bool in_is_atomic>
+    class basic_shared_ptr
     {
         static_assert(type_info<in_value_type>::is_pure(), "shared_ptr only supports pure types.");
         static_assert(not type_info<in_value_type>::is_void(), "shared_ptr does not support void.");
 
     private:
-        using this_type = shared_ptr;
+        using this_type = basic_shared_ptr;
+        using state_type = _shared_ptr_state<in_is_atomic>;
+
+        template <typename that_value_type>
+        using same_ptr_type = basic_shared_ptr<that_value_type, in_is_atomic>;
 
     public:
         /// ----------------------------------------------------------------------------------------
@@ -152,18 +352,17 @@ export namespace atom
         using value_type = in_value_type;
 
     private:
-        template <typename value_type>
-        friend class shared_ptr;
+        template <typename that_value_type, bool that_is_atomic>
+        friend class basic_shared_ptr;
 
-        template <typename value_type, typename allocator_type, typename... arg_types>
-        friend auto make_shared_with_alloc(
-            allocator_type alloc, arg_types&&... args) -> shared_ptr<value_type>;
+        template <typename that_value_type, bool that_is_atomic>
+        friend class basic_weak_ptr;
 
     public:
         /// ----------------------------------------------------------------------------------------
         /// # default constructor
         /// ----------------------------------------------------------------------------------------
-        constexpr shared_ptr()
+        constexpr basic_shared_ptr()
             : _ptr(nullptr)
             , _state(nullptr)
         {}
@@ -171,13 +370,18 @@ export namespace atom
         /// ----------------------------------------------------------------------------------------
         /// # copy constructor
         /// ----------------------------------------------------------------------------------------
-        constexpr shared_ptr(const shared_ptr& that) = default;
+        constexpr basic_shared_ptr(const basic_shared_ptr& that)
+            : _ptr(that._ptr)
+            , _state(that._state)
+        {
+            _check_and_increase_shared_count();
+        }
 
         /// ----------------------------------------------------------------------------------------
         /// # template copy constructor
         /// ----------------------------------------------------------------------------------------
         template <typename that_type>
-        constexpr shared_ptr(const shared_ptr<that_type>& that)
+        constexpr basic_shared_ptr(const same_ptr_type<that_type>& that)
             requires(type_info<that_type>::template is_same_or_derived_from<value_type>())
             : _ptr(that._ptr)
             , _state(that._state)
@@ -188,40 +392,45 @@ export namespace atom
         /// ----------------------------------------------------------------------------------------
         /// # copy operator
         /// ----------------------------------------------------------------------------------------
-        constexpr shared_ptr& operator=(const shared_ptr& that) = default;
+        constexpr basic_shared_ptr& operator=(const basic_shared_ptr& that)
+        {
+            return operator= <value_type>(that);
+        }
 
         /// ----------------------------------------------------------------------------------------
         /// # template copy operator
         /// ----------------------------------------------------------------------------------------
-        template <typename other_value_type>
-        constexpr shared_ptr& operator=(const shared_ptr<other_value_type>& that)
-            requires(type_info<other_value_type>::template is_same_or_derived_from<value_type>())
+        template <typename that_type>
+        constexpr basic_shared_ptr& operator=(const same_ptr_type<that_type>& that)
+            requires(type_info<that_type>::template is_same_or_derived_from<value_type>())
         {
+            // increase first, `that` may be the last reference to our state.
+            if (that._state != nullptr)
+                that._state->increase_count();
+
             _check_and_release();
 
             _ptr = that._ptr;
             _state = that._state;
-
-            _check_and_increase_shared_count();
-
             return *this;
         }
 
         /// ----------------------------------------------------------------------------------------
         /// # move constructor
         /// ----------------------------------------------------------------------------------------
-        constexpr shared_ptr(shared_ptr&& that) = default;
-
-        /// ----------------------------------------------------------------------------------------
-        /// # move operator
-        /// ----------------------------------------------------------------------------------------
-        constexpr shared_ptr& operator=(shared_ptr&& that) = default;
+        constexpr basic_shared_ptr(basic_shared_ptr&& that)
+            : _ptr(that._ptr)
+            , _state(that._state)
+        {
+            that._ptr = nullptr;
+            that._state = nullptr;
+        }
 
         /// ----------------------------------------------------------------------------------------
         /// # template move constructor
         /// ----------------------------------------------------------------------------------------
         template <typename that_type>
-        constexpr shared_ptr(shared_ptr<that_type>&& that)
+        constexpr basic_shared_ptr(same_ptr_type<that_type>&& that)
             requires(type_info<that_type>::template is_same_or_derived_from<value_type>())
             : _ptr(that._ptr)
             , _state(that._state)
@@ -230,13 +439,24 @@ export namespace atom
             that._state = nullptr;
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// # move operator
+        /// ----------------------------------------------------------------------------------------
+        constexpr basic_shared_ptr& operator=(basic_shared_ptr&& that)
+        {
+            return operator= <value_type>(move(that));
+        }
+
         /// ----------------------------------------------------------------------------------------
         /// # template move operator
         /// ----------------------------------------------------------------------------------------
         template <typename that_type>
-        constexpr shared_ptr& operator=(shared_ptr<that_type>&& that)
+        constexpr basic_shared_ptr& operator=(same_ptr_type<that_type>&& that)
             requires(type_info<that_type>::template is_same_or_derived_from<value_type>())
         {
+            if (static_cast<void*>(this) == static_cast<void*>(&that))
+                return *this;
+
             _check_and_release();
 
             _ptr = that._ptr;
@@ -244,24 +464,22 @@ export namespace atom
 
             that._ptr = nullptr;
             that._state = nullptr;
+            return *this;
         }
 
         /// ----------------------------------------------------------------------------------------
         /// # null constructor
         /// ----------------------------------------------------------------------------------------
-        constexpr shared_ptr(nullptr_t)
+        constexpr basic_shared_ptr(nullptr_t)
             : this_type()
         {}
 
         /// ----------------------------------------------------------------------------------------
         /// # null operator
         /// ----------------------------------------------------------------------------------------
-        constexpr shared_ptr& operator=(nullptr_t)
+        constexpr basic_shared_ptr& operator=(nullptr_t)
         {
-            _check_and_release();
-
-            _ptr = nullptr;
-            _state = nullptr;
+            set(nullptr);
             return *this;
         }
 
@@ -270,79 +488,65 @@ export namespace atom
         /// ----------------------------------------------------------------------------------------
         template <typename destroyer_type = shared_ptr_default_destroyer<value_type>,
             typename allocator_type = shared_ptr_default_allocator>
-        constexpr explicit shared_ptr(value_type* ptr, destroyer_type destroyer = destroyer_type(),
+        constexpr explicit basic_shared_ptr(value_type* ptr,
+            destroyer_type destroyer = destroyer_type(),
             allocator_type allocator = allocator_type())
             : _ptr(ptr)
+            , _state(nullptr)
         {
             if (ptr != nullptr)
-            {
-                _state =
-                    _create_state<destroyer_type, allocator_type>(move(destroyer), move(allocator));
-            }
+                _state = _create_state(move(destroyer), move(allocator));
         }
 
         /// ----------------------------------------------------------------------------------------
         /// # value operator
         /// ----------------------------------------------------------------------------------------
-        constexpr shared_ptr& operator=(value_type* ptr)
+        constexpr basic_shared_ptr& operator=(value_type* ptr)
         {
             set(ptr);
+            return *this;
         }
 
         /// ----------------------------------------------------------------------------------------
         /// # destructor
         /// ----------------------------------------------------------------------------------------
-        constexpr ~shared_ptr()
+        constexpr ~basic_shared_ptr()
         {
             _check_and_release();
         }
 
-    private:
-        constexpr shared_ptr(_shared_ptr_private_ctor, _shared_ptr_state* state, value_type* ptr)
+        /// ----------------------------------------------------------------------------------------
+        /// takes ownership of the count `state` already holds for `ptr`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr basic_shared_ptr(_shared_ptr_private_ctor, state_type* state, value_type* ptr)
             : _ptr(ptr)
             , _state(state)
         {}
 
     public:
         /// ----------------------------------------------------------------------------------------
-        ///
+        /// releases the current value and starts owning `ptr`.
         /// ----------------------------------------------------------------------------------------
-        template <typename value_type,
-            typename destroyer_type = shared_ptr_default_destroyer<value_type>,
+        template <typename other_value_type,
+            typename destroyer_type = shared_ptr_default_destroyer<other_value_type>,
             typename allocator_type = shared_ptr_default_allocator>
-        constexpr auto set(value_type* ptr, destroyer_type destroyer = destroyer_type(),
-            allocator_type allocator = allocator_type())
-            requires(type_info<value_type>::template is_same_or_derived_from<value_type>())
+        constexpr auto set(other_value_type* ptr, destroyer_type destroyer = destroyer_type(),
+            allocator_type allocator = allocator_type()) -> void
+            requires(type_info<other_value_type>::template is_same_or_derived_from<value_type>())
         {
-            if (_ptr != nullptr)
-            {
-                _release();
+            _check_and_release();
 
-                if (ptr != nullptr)
-                {
-                    _ptr = ptr;
-                    _create_state(move(destroyer), move(allocator));
-                }
-                else
-                {
-                    _ptr = nullptr;
-                    _state = nullptr;
-                }
-            }
-            else
-            {
-                if (ptr != nullptr)
-                {
-                    _ptr = ptr;
-                    _create_state(move(destroyer), move(allocator));
-                }
-            }
+            _ptr = ptr;
+            _state = nullptr;
+
+            if (ptr != nullptr)
+                _state = _create_state<other_value_type>(move(destroyer), move(allocator));
         }
 
         /// ----------------------------------------------------------------------------------------
-        ///
+        /// releases the current value.
         /// ----------------------------------------------------------------------------------------
-        constexpr auto set(nullptr_t)
+        constexpr auto set(nullptr_t) -> void
         {
             _check_and_release();
 
@@ -351,21 +555,20 @@ export namespace atom
         }
 
         /// ----------------------------------------------------------------------------------------
+        /// releases the current value.
         ///
+        /// \returns the pointer held before, which is dangling if this was the last reference.
         /// ----------------------------------------------------------------------------------------
         constexpr auto release() -> value_type*
         {
-            _check_and_release();
-
             value_type* ptr = _ptr;
-            _ptr = nullptr;
-            _state = nullptr;
+            set(nullptr);
 
             return ptr;
         }
 
         /// ----------------------------------------------------------------------------------------
-        ///
+        /// \returns count of `basic_shared_ptr`s sharing the value.
         /// ----------------------------------------------------------------------------------------
         constexpr auto get_count() const -> usize
         {
@@ -389,52 +592,317 @@ export namespace atom
         }
 
     private:
-        constexpr auto _release()
-        {
-            _state->decrease_count();
-
-            if (_state->get_count() == 0)
-            {
-                _state->destroy(_ptr);
-                _state->dealloc_self();
-            }
-        }
-
-        constexpr auto _check_and_release()
+        constexpr auto _check_and_release() -> void
         {
-            if (_ptr != nullptr)
-            {
-                _release();
-            }
+            if (_state != nullptr)
+                _state->release(_ptr);
         }
 
-        template <typename destroyer_type, typename allocator_type>
+        template <typename other_value_type = value_type, typename destroyer_type,
+            typename allocator_type>
         constexpr auto _create_state(
-            destroyer_type destroyer, allocator_type allocator) -> _shared_ptr_state*
+            destroyer_type destroyer, allocator_type allocator) -> state_type*
         {
-            using state_type =
-                _default_shared_ptr_state<value_type, destroyer_type, allocator_type>;
+            using default_state_type = _default_shared_ptr_state<other_value_type, in_is_atomic,
+                destroyer_type, allocator_type>;
 
-            state_type* state = static_cast<state_type*>(allocator.alloc(sizeof(state_type)));
-            type_utils::construct_as<state_type>(state, move(destroyer), move(allocator));
+            default_state_type* state =
+                static_cast<default_state_type*>(allocator.alloc(sizeof(default_state_type)));
+            type_utils::construct_as<default_state_type>(state, move(destroyer), move(allocator));
             return state;
         }
 
-        constexpr auto _check_and_increase_shared_count()
+        constexpr auto _check_and_increase_shared_count() -> void
         {
             if (_state != nullptr)
-            {
                 _state->increase_count();
-            }
         }
 
     private:
         value_type* _ptr;
-        _shared_ptr_state* _state;
+        state_type* _state;
     };
 
     /// --------------------------------------------------------------------------------------------
+    /// non owning reference to a value owned by `basic_shared_ptr`s, which doesn't keep the value
+    /// alive. use `lock()` to get a `basic_shared_ptr` to the value, if it's still alive.
     ///
+    /// use `weak_ptr` and `local_weak_ptr` instead of naming this directly.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_value_type, bool in_is_atomic>
+    class basic_weak_ptr
+    {
+    private:
+        using this_type = basic_weak_ptr;
+        using state_type = _shared_ptr_state<in_is_atomic>;
+
+        template <typename that_value_type>
+        using shared_ptr_type = basic_shared_ptr<that_value_type, in_is_atomic>;
+
+        template <typename that_value_type>
+        using same_ptr_type = basic_weak_ptr<that_value_type, in_is_atomic>;
+
+        template <typename that_value_type, bool that_is_atomic>
+        friend class basic_weak_ptr;
+
+    public:
+        using value_type = in_value_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr basic_weak_ptr()
+            : _ptr(nullptr)
+            , _state(nullptr)
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr basic_weak_ptr(const basic_weak_ptr& that)
+            : _ptr(that._ptr)
+            , _state(that._state)
+        {
+            _check_and_increase_weak_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # template copy constructor
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type>
+        constexpr basic_weak_ptr(const same_ptr_type<that_type>& that)
+            requires(type_info<that_type>::template is_same_or_derived_from<value_type>())
+            : _ptr(that._ptr)
+            , _state(that._state)
+        {
+            _check_and_increase_weak_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # shared_ptr constructor
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type>
+        constexpr basic_weak_ptr(const shared_ptr_type<that_type>& that)
+            requires(type_info<that_type>::template is_same_or_derived_from<value_type>())
+            : _ptr(that._ptr)
+            , _state(that._state)
+        {
+            _check_and_increase_weak_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        constexpr basic_weak_ptr& operator=(const basic_weak_ptr& that)
+        {
+            _assign(that._ptr, that._state);
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # template copy operator
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type>
+        constexpr basic_weak_ptr& operator=(const same_ptr_type<that_type>& that)
+            requires(type_info<that_type>::template is_same_or_derived_from<value_type>())
+        {
+            _assign(that._ptr, that._state);
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # shared_ptr operator
+        /// ----------------------------------------------------------------------------------------
+        template <typename that_type>
+        constexpr basic_weak_ptr& operator=(const shared_ptr_type<that_type>& that)
+            requires(type_info<that_type>::template is_same_or_derived_from<value_type>())
+        {
+            _assign(that._ptr, that._state);
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr basic_weak_ptr(basic_weak_ptr&& that)
+            : _ptr(that._ptr)
+            , _state(that._state)
+        {
+            that._ptr = nullptr;
+            that._state = nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move operator
+        /// ----------------------------------------------------------------------------------------
+        constexpr basic_weak_ptr& operator=(basic_weak_ptr&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            _check_and_release();
+
+            _ptr = that._ptr;
+            _state = that._state;
+
+            that._ptr = nullptr;
+            that._state = nullptr;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr ~basic_weak_ptr()
+        {
+            _check_and_release();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `basic_shared_ptr` to the value if it's still alive, else null. lock free.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto lock() const -> shared_ptr_type<value_type>
+        {
+            if (_state == nullptr or not _state->try_increase_count())
+                return shared_ptr_type<value_type>();
+
+            return shared_ptr_type<value_type>(_shared_ptr_private_ctor(), _state, _ptr);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of `basic_shared_ptr`s sharing the value.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_count() const -> usize
+        {
+            return _state == nullptr ? 0 : _state->get_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if the value has been destroyed or this doesn't refer to any.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto is_expired() const -> bool
+        {
+            return get_count() == 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// stops referring to the value.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto reset() -> void
+        {
+            _check_and_release();
+
+            _ptr = nullptr;
+            _state = nullptr;
+        }
+
+    private:
+        constexpr auto _assign(value_type* ptr, state_type* state) -> void
+        {
+            // increase first, our state may be the same as `state`.
+            if (state != nullptr)
+                state->increase_weak_count();
+
+            _check_and_release();
+
+            _ptr = ptr;
+            _state = state;
+        }
+
+        constexpr auto _check_and_increase_weak_count() -> void
+        {
+            if (_state != nullptr)
+                _state->increase_weak_count();
+        }
+
+        constexpr auto _check_and_release() -> void
+        {
+            if (_state != nullptr)
+                _state->release_weak();
+        }
+
+    private:
+        value_type* _ptr;
+        state_type* _state;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// `basic_shared_ptr` with atomic reference count, safe to share across threads.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    using shared_ptr = basic_shared_ptr<value_type, true>;
+
+    /// --------------------------------------------------------------------------------------------
+    /// `basic_shared_ptr` with non atomic reference count, for values which never leave a thread.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    using local_shared_ptr = basic_shared_ptr<value_type, false>;
+
+    /// --------------------------------------------------------------------------------------------
+    /// `basic_weak_ptr` referring to a `shared_ptr`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    using weak_ptr = basic_weak_ptr<value_type, true>;
+
+    /// --------------------------------------------------------------------------------------------
+    /// `basic_weak_ptr` referring to a `local_shared_ptr`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    using local_weak_ptr = basic_weak_ptr<value_type, false>;
+
+    /// --------------------------------------------------------------------------------------------
+    /// creates value with `args` and its state in a single allocation, using `allocator`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type, bool is_atomic, typename allocator_type, typename... arg_types>
+    auto make_basic_shared_with_alloc(
+        allocator_type allocator, arg_types&&... args) -> basic_shared_ptr<value_type, is_atomic>
+    {
+        using state_type = _default_shared_ptr_state<value_type, is_atomic,
+            _shared_ptr_emplace_destroyer<value_type>, allocator_type>;
+
+        // the value is placed right after the state, so both are freed by `dealloc_self()`.
+        constexpr usize value_offset =
+            (sizeof(state_type) + alignof(value_type) - 1) / alignof(value_type)
+            * alignof(value_type);
+
+        void* mem = allocator.alloc(value_offset + sizeof(value_type));
+        value_type* value_ptr =
+            reinterpret_cast<value_type*>(static_cast<byte*>(mem) + value_offset);
+
+        try
+        {
+            type_utils::construct_as<value_type>(value_ptr, forward<arg_types>(args)...);
+        }
+        catch (...)
+        {
+            allocator.dealloc(mem);
+            throw;
+        }
+
+        state_type* state = static_cast<state_type*>(mem);
+        type_utils::construct_as<state_type>(
+            state, _shared_ptr_emplace_destroyer<value_type>(), move(allocator));
+
+        return basic_shared_ptr<value_type, is_atomic>(
+            _shared_ptr_private_ctor(), state, value_ptr);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// creates `shared_ptr` with value constructed with `args`, the value and the reference
+    /// count are allocated together using `allocator`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type, typename allocator_type, typename... arg_types>
+    auto make_shared_with_alloc(
+        allocator_type allocator, arg_types&&... args) -> shared_ptr<value_type>
+    {
+        return make_basic_shared_with_alloc<value_type, true>(
+            move(allocator), forward<arg_types>(args)...);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// creates `shared_ptr` with value constructed with `args` in a single allocation.
     /// --------------------------------------------------------------------------------------------
     template <typename value_type, typename... arg_types>
     auto make_shared(arg_types&&... args) -> shared_ptr<value_type>
@@ -444,21 +912,24 @@ export namespace atom
     }
 
     /// --------------------------------------------------------------------------------------------
-    ///
+    /// same as `make_shared_with_alloc()`, but creates a `local_shared_ptr`.
     /// --------------------------------------------------------------------------------------------
     template <typename value_type, typename allocator_type, typename... arg_types>
-    auto make_shared_with_alloc(
-        allocator_type allocator, arg_types&&... args) -> shared_ptr<value_type>
+    auto make_local_shared_with_alloc(
+        allocator_type allocator, arg_types&&... args) -> local_shared_ptr<value_type>
     {
-        using state_type = _default_shared_ptr_state<value_type,
-            shared_ptr_default_destroyer<value_type>, shared_ptr_default_allocator>;
-
-        void* mem = allocator.alloc(sizeof(state_type) + sizeof(value_type));
-        state_type* state = mem;
-        value_type* value_ptr = static_cast<value_type*>(state + 1);
+        return make_basic_shared_with_alloc<value_type, false>(
+            move(allocator), forward<arg_types>(args)...);
+    }
 
-        type_utils::construct(value_ptr, forward<arg_types>(args)...);
-        return shared_ptr<value_type>(_shared_ptr_private_ctor(), state, value_ptr);
+    /// --------------------------------------------------------------------------------------------
+    /// same as `make_shared()`, but creates a `local_shared_ptr`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type, typename... arg_types>
+    auto make_local_shared(arg_types&&... args) -> local_shared_ptr<value_type>
+    {
+        return make_local_shared_with_alloc<value_type>(
+            shared_ptr_default_allocator(), forward<arg_types>(args)...);
     }
 }
 
@@ -470,8 +941,9 @@ namespace atom
     template <typename value_type, typename destroyer_type>
     template <typename allocator_type, typename other_value_type>
     constexpr auto unique_ptr<value_type, destroyer_type>::_to_shared(
-        allocator_type allocator) -> shared_ptr<other_value_type>
+        allocator_type allocator) -> basic_shared_ptr<other_value_type, true>
     {
-        return make_shared_with_alloc(move(allocator), _ptr);
+        return basic_shared_ptr<other_value_type, true>(
+            _release_value(), move(_destroyer), move(allocator));
     }
 }
@@ -0,0 +1,299 @@
+export module atom_core:spsc_queue;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :futex;
+import :default_mem_allocator;
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// bounded lock free queue, for one thread pushing and one thread popping.
+    ///
+    /// the positions written by each side are kept on separate cache lines, along with a cached
+    /// copy of the other side's position. so each side reads the other's cache line only when
+    /// the queue looks full or empty to it.
+    ///
+    /// `push()` and `pop()` block while the queue is full or empty, sleeping on a futex. every
+    /// push or pop checks for a sleeping thread on the other side, batches check once.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type>
+    class spsc_queue
+    {
+        using this_type = spsc_queue;
+
+    public:
+        using value_type = in_value_type;
+
+    private:
+        static_assert(type_info<value_type>::is_pure(), "value type must be pure.");
+        static_assert(alignof(value_type) <= alignof(std::max_align_t),
+            "over aligned value types are not supported.");
+
+        static constexpr usize _cache_line_size = 64;
+
+        class _slot
+        {
+        public:
+            alignas(value_type) byte storage[sizeof(value_type)];
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # constructor
+        ///
+        /// creates a queue which can hold `capacity` values, rounded up to a power of two.
+        ///
+        /// \pre `capacity > 0`.
+        /// ----------------------------------------------------------------------------------------
+        explicit spsc_queue(usize capacity)
+            : _head{ 0 }
+            , _cached_tail{ 0 }
+            , _tail{ 0 }
+            , _cached_head{ 0 }
+            , _mask{ std::bit_ceil(capacity) - 1 }
+        {
+            contract_expects(capacity > 0, "capacity is zero.");
+
+            void* mem = default_mem_allocator().alloc(sizeof(_slot) * (_mask + 1));
+            _slots = static_cast<_slot*>(mem);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        spsc_queue(const this_type& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(const this_type& that) -> this_type& = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// destroys values left in the queue.
+        /// ----------------------------------------------------------------------------------------
+        ~spsc_queue()
+        {
+            usize tail = _tail.load(std::memory_order_acquire);
+            for (usize head = _head.load(std::memory_order_relaxed); head != tail; head++)
+                std::destroy_at(_get_value(head));
+
+            default_mem_allocator().dealloc(_slots);
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// pushes `value` if the queue isn't full. called only by the producer.
+        ///
+        /// \returns `true` if pushed, else `value` is left as it was.
+        /// ----------------------------------------------------------------------------------------
+        auto try_push(const value_type& value) -> bool
+        {
+            return _try_push_one(value);
+        }
+
+        auto try_push(value_type&& value) -> bool
+        {
+            return _try_push_one(move(value));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops a value if the queue isn't empty. called only by the consumer.
+        /// ----------------------------------------------------------------------------------------
+        auto try_pop() -> option<value_type>
+        {
+            option<value_type> value;
+            if (_pop_batch(&value, 1) == 0)
+                return value;
+
+            _not_full.notify_one();
+            return value;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves values from `values` to the queue, as many as fit. called only by the producer.
+        ///
+        /// \returns count of values pushed, the first ones of `values`.
+        /// ----------------------------------------------------------------------------------------
+        auto try_push_batch(value_type* values, usize count) -> usize
+        {
+            usize pushed = _push_batch(values, count);
+            if (pushed > 0)
+                _not_empty.notify_one();
+
+            return pushed;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops upto `count` values, constructing them in `out` which must have space for them.
+        /// called only by the consumer.
+        ///
+        /// \returns count of values popped.
+        /// ----------------------------------------------------------------------------------------
+        auto try_pop_batch(value_type* out, usize count) -> usize
+        {
+            usize popped = _pop_batch(out, count);
+            if (popped > 0)
+                _not_full.notify_one();
+
+            return popped;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pushes `value`, blocking while the queue is full.
+        /// ----------------------------------------------------------------------------------------
+        auto push(value_type value) -> void
+        {
+            while (not _try_push_one(move(value)))
+            {
+                u32 key = _not_full.prepare_wait();
+
+                if (not _is_full())
+                {
+                    _not_full.cancel_wait();
+                    continue;
+                }
+
+                _not_full.commit_wait(key);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops a value, blocking while the queue is empty.
+        /// ----------------------------------------------------------------------------------------
+        auto pop() -> value_type
+        {
+            while (true)
+            {
+                if (option<value_type> value = try_pop(); value.is_value())
+                    return move(value.get());
+
+                u32 key = _not_empty.prepare_wait();
+
+                if (not _is_empty())
+                {
+                    _not_empty.cancel_wait();
+                    continue;
+                }
+
+                _not_empty.commit_wait(key);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of values in the queue. it may have changed by the time it's used, if
+        /// called while the other thread is using the queue.
+        /// ----------------------------------------------------------------------------------------
+        auto get_count() const -> usize
+        {
+            return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+        }
+
+        auto get_capacity() const -> usize
+        {
+            return _mask + 1;
+        }
+
+    private:
+        template <typename that_value_type>
+        auto _try_push_one(that_value_type&& value) -> bool
+        {
+            usize tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cached_head > _mask)
+            {
+                _cached_head = _head.load(std::memory_order_acquire);
+                if (tail - _cached_head > _mask)
+                    return false;
+            }
+
+            std::construct_at(_get_value(tail), forward<that_value_type>(value));
+            _tail.store(tail + 1, std::memory_order_release);
+
+            _not_empty.notify_one();
+            return true;
+        }
+
+        auto _push_batch(value_type* values, usize count) -> usize
+        {
+            usize tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cached_head + count > _mask + 1)
+                _cached_head = _head.load(std::memory_order_acquire);
+
+            count = std::min(count, _mask + 1 - (tail - _cached_head));
+            for (usize i = 0; i < count; i++)
+                std::construct_at(_get_value(tail + i), move(values[i]));
+
+            _tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        template <typename out_type>
+        auto _pop_batch(out_type* out, usize count) -> usize
+        {
+            usize head = _head.load(std::memory_order_relaxed);
+            if (_cached_tail - head < count)
+                _cached_tail = _tail.load(std::memory_order_acquire);
+
+            count = std::min(count, _cached_tail - head);
+            for (usize i = 0; i < count; i++)
+            {
+                value_type* value = _get_value(head + i);
+                _construct_out(out + i, move(*value));
+                std::destroy_at(value);
+            }
+
+            _head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        static auto _construct_out(value_type* out, value_type&& value) -> void
+        {
+            std::construct_at(out, move(value));
+        }
+
+        static auto _construct_out(option<value_type>* out, value_type&& value) -> void
+        {
+            out->emplace(move(value));
+        }
+
+        auto _is_full() const -> bool
+        {
+            return _tail.load(std::memory_order_relaxed) - _head.load(std::memory_order_acquire)
+                   > _mask;
+        }
+
+        auto _is_empty() const -> bool
+        {
+            return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_relaxed);
+        }
+
+        auto _get_value(usize pos) const -> value_type*
+        {
+            return reinterpret_cast<value_type*>(_slots[pos & _mask].storage);
+        }
+
+    private:
+        // consumer side.
+        std::atomic<usize> _head;
+        usize _cached_tail;
+        byte _head_padding[_cache_line_size];
+
+        // producer side.
+        std::atomic<usize> _tail;
+        usize _cached_head;
+        byte _tail_padding[_cache_line_size];
+
+        // shared, read only.
+        usize _mask;
+        _slot* _slots;
+        _event_count _not_empty;
+        _event_count _not_full;
+    };
+}
@@ -6,8 +6,8 @@ import :default_mem_allocator;
 
 export namespace atom
 {
-    template <typename value_type>
-    class shared_ptr;
+    template <typename value_type, bool is_atomic>
+    class basic_shared_ptr;
 
     template <typename value_type>
     class unique_ptr_default_destroyer
@@ -188,10 +188,10 @@ export namespace atom
         ///
         /// ----------------------------------------------------------------------------------------
         template <typename new_value_type = value_type>
-        constexpr auto to_shared() -> shared_ptr<new_value_type>
+        constexpr auto to_shared() -> basic_shared_ptr<new_value_type, true>
             requires(type_info<new_value_type>::template is_same_or_derived_from<value_type>())
         {
-            return _to_shared();
+            return _to_shared<default_mem_allocator, new_value_type>(default_mem_allocator());
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -199,10 +199,10 @@ export namespace atom
         /// ----------------------------------------------------------------------------------------
         template <typename allocator_type, typename new_value_type = value_type>
         constexpr auto to_shared_with_alloc(
-            allocator_type allocator = allocator_type()) -> shared_ptr<new_value_type>
+            allocator_type allocator = allocator_type()) -> basic_shared_ptr<new_value_type, true>
             requires(type_info<new_value_type>::template is_same_or_derived_from<value_type>())
         {
-            return _to_shared();
+            return _to_shared<allocator_type, new_value_type>(move(allocator));
         }
 
     private:
@@ -253,7 +253,8 @@ export namespace atom
         }
 
         template <typename allocator_type, typename other_value_type>
-        constexpr auto _to_shared(allocator_type allocator) -> shared_ptr<other_value_type>;
+        constexpr auto _to_shared(
+            allocator_type allocator) -> basic_shared_ptr<other_value_type, true>;
 
     private:
         destroyer_type _destroyer;
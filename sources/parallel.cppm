@@ -0,0 +1,4 @@
+export module atom_core:parallel;
+
+export import :parallel.task_scheduler;
+export import :parallel.algorithms;
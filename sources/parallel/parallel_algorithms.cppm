@@ -0,0 +1,388 @@
+export module atom_core:parallel.algorithms;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :ranges;
+import :containers;
+import :parallel.task_scheduler;
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// how an algorithm runs, on the calling thread only or split into chunks run on all cores.
+    /// --------------------------------------------------------------------------------------------
+    export class execution_policy
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// runs on the calling thread.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto sequential() -> execution_policy
+        {
+            return execution_policy{ false, 0 };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// runs in parallel, with the chunk size chosen from the count of values and threads.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto parallel() -> execution_policy
+        {
+            return execution_policy{ true, 0 };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// runs in parallel, in chunks of `grain_size` values. ranges not larger than one chunk
+        /// run on the calling thread.
+        ///
+        /// \pre `grain_size > 0`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto parallel(usize grain_size) -> execution_policy
+        {
+            contract_debug_expects(grain_size > 0, "grain size is zero.");
+
+            return execution_policy{ true, grain_size };
+        }
+
+    public:
+        constexpr auto is_parallel() const -> bool
+        {
+            return _is_parallel;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of values in each chunk, `0` if chosen automatically.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_grain_size() const -> usize
+        {
+            return _grain_size;
+        }
+
+    private:
+        constexpr execution_policy(bool is_parallel, usize grain_size)
+            : _is_parallel{ is_parallel }
+            , _grain_size{ grain_size }
+        {}
+
+    private:
+        bool _is_parallel;
+        usize _grain_size;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// split of `count` values into chunks, following `policy`.
+    /// --------------------------------------------------------------------------------------------
+    class _parallel_chunks
+    {
+    public:
+        /// automatic chunks aren't made smaller than this, to keep the cost of scheduling them
+        /// small compared to the work in them.
+        static constexpr usize min_auto_grain_size = 4096;
+
+    public:
+        _parallel_chunks(const execution_policy& policy, usize count)
+            : count{ count }
+            , grain_size{ count }
+            , chunk_count{ count == 0 ? 0u : 1u }
+        {
+            if (not policy.is_parallel() or count == 0)
+                return;
+
+            grain_size = policy.get_grain_size();
+            if (grain_size == 0)
+            {
+                // a few chunks per thread, so that threads finishing early can take over work.
+                const usize thread_count = task_scheduler::get_shared().get_worker_count();
+                grain_size = std::max(count / (thread_count * 4), min_auto_grain_size);
+            }
+
+            grain_size = std::min(grain_size, count);
+            chunk_count = (count + grain_size - 1) / grain_size;
+        }
+
+    public:
+        auto get_begin(usize chunk) const -> usize
+        {
+            return chunk * grain_size;
+        }
+
+        auto get_end(usize chunk) const -> usize
+        {
+            return std::min(get_begin(chunk) + grain_size, count);
+        }
+
+    public:
+        usize count;
+        usize grain_size;
+        usize chunk_count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// invokes `fn(chunk, begin, end)` for chunks in `[first, last)`, handing the upper half to
+    /// other workers until one chunk is left. thieves so take big pieces of work and split them
+    /// further themselves.
+    /// --------------------------------------------------------------------------------------------
+    template <typename function_type>
+    auto _parallel_for_chunks(task_group& group, const _parallel_chunks& chunks,
+        const function_type& fn, usize first, usize last) -> void
+    {
+        while (last - first > 1)
+        {
+            const usize mid = first + (last - first) / 2;
+            group.spawn([&group, &chunks, &fn, mid, last] {
+                _parallel_for_chunks(group, chunks, fn, mid, last);
+            });
+
+            last = mid;
+        }
+
+        fn(first, chunks.get_begin(first), chunks.get_end(first));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// invokes `fn(chunk, begin, end)` for each chunk on the shared `task_scheduler`, or on the
+    /// calling thread if there is only one.
+    /// --------------------------------------------------------------------------------------------
+    template <typename function_type>
+    auto _parallel_for(const _parallel_chunks& chunks, const function_type& fn) -> void
+    {
+        if (chunks.chunk_count <= 1)
+        {
+            if (chunks.chunk_count == 1)
+                fn(usize(0), usize(0), chunks.count);
+
+            return;
+        }
+
+        // the calling thread runs chunks too, while waiting.
+        task_group group{ task_scheduler::get_shared() };
+        _parallel_for_chunks(group, chunks, fn, 0, chunks.chunk_count);
+        group.wait();
+    }
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom::ranges
+{
+    /// --------------------------------------------------------------------------------------------
+    /// invokes `fn` with each value of `range`, in no particular order with `parallel` policies.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename function_type>
+    auto for_each(const execution_policy& policy, range_type& range, const function_type& fn)
+        -> void
+        requires random_access_range_concept<range_type>
+    {
+        auto it = ranges::get_iterator(range);
+        _parallel_for(_parallel_chunks{ policy, ranges::count_values(range) },
+            [&](usize chunk, usize begin, usize end) {
+                for (usize i = begin; i < end; i++)
+                    fn(it[isize(i)]);
+            });
+    }
+
+    /// \copydoc for_each
+    export template <typename range_type, typename function_type>
+    auto for_each(const execution_policy& policy, const range_type& range,
+        const function_type& fn) -> void
+        requires const_random_access_range_concept<range_type>
+    {
+        auto it = ranges::get_iterator(range);
+        _parallel_for(_parallel_chunks{ policy, ranges::count_values(range) },
+            [&](usize chunk, usize begin, usize end) {
+                for (usize i = begin; i < end; i++)
+                    fn(it[isize(i)]);
+            });
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// assigns `fn(value)` for each value of `range` to the value at the same index in `out`.
+    ///
+    /// \pre `out` has at least as many values as `range`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename out_range_type, typename function_type>
+    auto transform(const execution_policy& policy, const range_type& range, out_range_type& out,
+        const function_type& fn) -> void
+        requires const_random_access_range_concept<range_type>
+                 and random_access_range_concept<out_range_type>
+    {
+        const usize count = ranges::count_values(range);
+        contract_expects(ranges::count_values(out) >= count, "out is smaller than range.");
+
+        auto it = ranges::get_iterator(range);
+        auto out_it = ranges::get_iterator(out);
+        _parallel_for(_parallel_chunks{ policy, count }, [&](usize chunk, usize begin, usize end) {
+            for (usize i = begin; i < end; i++)
+                out_it[isize(i)] = fn(it[isize(i)]);
+        });
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// copies values of `range` to the same indices in `out`.
+    ///
+    /// \pre `out` has at least as many values as `range`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename out_range_type>
+    auto copy(const execution_policy& policy, const range_type& range, out_range_type& out) -> void
+        requires const_random_access_range_concept<range_type>
+                 and random_access_range_concept<out_range_type>
+    {
+        const usize count = ranges::count_values(range);
+        contract_expects(ranges::count_values(out) >= count, "out is smaller than range.");
+
+        auto it = ranges::get_iterator(range);
+        auto out_it = ranges::get_iterator(out);
+        _parallel_for(_parallel_chunks{ policy, count }, [&](usize chunk, usize begin, usize end) {
+            std::copy(it + isize(begin), it + isize(end), out_it + isize(begin));
+        });
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// combines `init` and all values of `range` using `op`.
+    ///
+    /// with `parallel` policies, chunks are combined separately and their results combined after,
+    /// so `op` must be associative and commutative.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename result_type, typename function_type>
+    auto reduce(const execution_policy& policy, const range_type& range, result_type init,
+        const function_type& op) -> result_type
+        requires const_random_access_range_concept<range_type>
+    {
+        const _parallel_chunks chunks{ policy, ranges::count_values(range) };
+        auto it = ranges::get_iterator(range);
+
+        if (chunks.chunk_count <= 1)
+        {
+            for (usize i = 0; i < chunks.count; i++)
+                init = op(move(init), it[isize(i)]);
+
+            return init;
+        }
+
+        dynamic_array<option<result_type>> partials;
+        partials.reserve(chunks.chunk_count);
+        for (usize i = 0; i < chunks.chunk_count; i++)
+            partials.emplace_last();
+
+        _parallel_for(chunks, [&](usize chunk, usize begin, usize end) {
+            result_type partial = result_type(it[isize(begin)]);
+            for (usize i = begin + 1; i < end; i++)
+                partial = op(move(partial), it[isize(i)]);
+
+            partials.get_at(chunk).emplace(move(partial));
+        });
+
+        for (usize i = 0; i < chunks.chunk_count; i++)
+            init = op(move(init), move(partials.get_at(i).get()));
+
+        return init;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns count of values of `range` accepted by `pred`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename function_type>
+    auto count_if(const execution_policy& policy, const range_type& range,
+        const function_type& pred) -> usize
+        requires const_random_access_range_concept<range_type>
+    {
+        std::atomic<usize> total{ 0 };
+        auto it = ranges::get_iterator(range);
+
+        _parallel_for(_parallel_chunks{ policy, ranges::count_values(range) },
+            [&](usize chunk, usize begin, usize end) {
+                usize count = 0;
+                for (usize i = begin; i < end; i++)
+                {
+                    if (pred(it[isize(i)]))
+                        count++;
+                }
+
+                total.fetch_add(count, std::memory_order_relaxed);
+            });
+
+        return total.load(std::memory_order_relaxed);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns iterator to the first value of `range` accepted by `pred`, or to the end.
+    ///
+    /// chunks after the one with the first found value are skipped, but chunks already running
+    /// are searched until they find a value or end.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename function_type>
+    auto find_if(const execution_policy& policy, const range_type& range,
+        const function_type& pred) -> const_iterator_type<range_type>
+        requires const_random_access_range_concept<range_type>
+    {
+        const usize count = ranges::count_values(range);
+        std::atomic<usize> found{ count };
+        auto it = ranges::get_iterator(range);
+
+        _parallel_for(_parallel_chunks{ policy, count }, [&](usize chunk, usize begin, usize end) {
+            if (begin >= found.load(std::memory_order_relaxed))
+                return;
+
+            for (usize i = begin; i < end; i++)
+            {
+                if (not pred(it[isize(i)]))
+                    continue;
+
+                usize current = found.load(std::memory_order_relaxed);
+                while (i < current
+                       and not found.compare_exchange_weak(
+                           current, i, std::memory_order_relaxed))
+                {}
+
+                return;
+            }
+        });
+
+        return it + isize(found.load(std::memory_order_relaxed));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// sorts values of `range` using `comparer`. chunks are sorted in parallel and then merged in
+    /// pairs, with merges of each level in parallel. the sort is not stable.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename comparer_type = std::less<>>
+    auto sort(const execution_policy& policy, range_type& range, comparer_type comparer = {})
+        -> void
+        requires random_access_range_concept<range_type>
+    {
+        const _parallel_chunks chunks{ policy, ranges::count_values(range) };
+        auto it = ranges::get_iterator(range);
+
+        _parallel_for(chunks, [&](usize chunk, usize begin, usize end) {
+            std::sort(it + isize(begin), it + isize(end), comparer);
+        });
+
+        for (usize width = chunks.grain_size; width < chunks.count; width *= 2)
+        {
+            const usize pair_count = (chunks.count + width * 2 - 1) / (width * 2);
+            _parallel_chunks pairs{ policy, pair_count };
+            pairs.grain_size = 1;
+            pairs.chunk_count = pair_count;
+
+            _parallel_for(pairs, [&](usize pair, usize, usize) {
+                const usize begin = pair * width * 2;
+                const usize mid = std::min(begin + width, chunks.count);
+                const usize end = std::min(begin + width * 2, chunks.count);
+
+                std::inplace_merge(
+                    it + isize(begin), it + isize(mid), it + isize(end), comparer);
+            });
+        }
+    }
+}
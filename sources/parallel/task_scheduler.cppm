@@ -0,0 +1,803 @@
+export module atom_core:parallel.task_scheduler;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :function_box;
+import :futex;
+import :default_mem_allocator;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    class _task_cache;
+
+    /// --------------------------------------------------------------------------------------------
+    /// a spawned task. tasks are recycled by the scheduler, so spawning doesn't allocate once the
+    /// scheduler has warmed up.
+    /// --------------------------------------------------------------------------------------------
+    class _task
+    {
+    public:
+        unique_function<void()> fn;
+
+        /// count of unfinished tasks of the group this task belongs to.
+        std::atomic<u32>* pending;
+
+        /// cache the task was allocated from, which it's returned to.
+        _task_cache* owner;
+
+        /// next task in a free list or in the injection queue.
+        _task* next;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// tasks allocated together, kept in a list to free them with the scheduler.
+    /// --------------------------------------------------------------------------------------------
+    class _task_block
+    {
+    public:
+        static constexpr usize task_count = 64;
+
+    public:
+        _task tasks[task_count];
+        _task_block* next;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// tasks which aren't running, recycled to spawn new tasks.
+    ///
+    /// tasks always go back to the cache they were allocated from, so caches of threads which
+    /// only spawn tasks, or only run them, don't keep growing. tasks returned by other threads
+    /// are pushed to a lock free list, which the owner takes all at once when it runs out.
+    /// --------------------------------------------------------------------------------------------
+    class _task_cache
+    {
+    public:
+        _task_cache()
+            : _free_tasks{ nullptr }
+            , _returned_tasks{ nullptr }
+            , _blocks{ nullptr }
+            , _block_count{ 0 }
+        {}
+
+        ~_task_cache()
+        {
+            while (_blocks != nullptr)
+            {
+                _task_block* block = _blocks;
+                _blocks = block->next;
+
+                std::destroy_at(block);
+                default_mem_allocator().dealloc(block);
+            }
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// only the owner of the cache calls this.
+        /// ----------------------------------------------------------------------------------------
+        auto alloc() -> _task*
+        {
+            if (_free_tasks == nullptr)
+                _free_tasks = _returned_tasks.exchange(nullptr, std::memory_order_acquire);
+
+            if (_free_tasks == nullptr)
+                _alloc_block();
+
+            _task* task = _free_tasks;
+            _free_tasks = task->next;
+            return task;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// recycles `task`, allocated from this cache. only the owner of the cache calls this.
+        /// ----------------------------------------------------------------------------------------
+        auto dealloc(_task* task) -> void
+        {
+            task->next = _free_tasks;
+            _free_tasks = task;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// recycles `task`, allocated from this cache, from any thread.
+        /// ----------------------------------------------------------------------------------------
+        auto give_back(_task* task) -> void
+        {
+            _task* head = _returned_tasks.load(std::memory_order_relaxed);
+            do
+            {
+                task->next = head;
+            } while (not _returned_tasks.compare_exchange_weak(
+                head, task, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of blocks allocated, from any thread.
+        /// ----------------------------------------------------------------------------------------
+        auto get_block_count() const -> usize
+        {
+            return _block_count.load(std::memory_order_relaxed);
+        }
+
+    private:
+        auto _alloc_block() -> void
+        {
+            void* mem = default_mem_allocator().alloc(sizeof(_task_block));
+            _task_block* block = std::construct_at(static_cast<_task_block*>(mem));
+            block->next = _blocks;
+            _blocks = block;
+            _block_count.fetch_add(1, std::memory_order_relaxed);
+
+            for (_task& task : block->tasks)
+            {
+                task.owner = this;
+                dealloc(&task);
+            }
+        }
+
+    private:
+        _task* _free_tasks;
+        std::atomic<_task*> _returned_tasks;
+        _task_block* _blocks;
+        std::atomic<usize> _block_count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// chase-lev deque of tasks. its owner pushes and pops tasks at the bottom, while other
+    /// threads steal from the top.
+    ///
+    /// replaced rings are kept until the deque is destroyed, since a thief may still be reading
+    /// from them.
+    /// --------------------------------------------------------------------------------------------
+    class _task_deque
+    {
+        class _ring
+        {
+        public:
+            static auto create(isize capacity, _ring* prev) -> _ring*
+            {
+                void* mem = default_mem_allocator().alloc(
+                    sizeof(_ring) + sizeof(std::atomic<_task*>) * usize(capacity));
+
+                return std::construct_at(static_cast<_ring*>(mem), capacity, prev);
+            }
+
+            static auto destroy(_ring* ring) -> void
+            {
+                std::destroy_at(ring);
+                default_mem_allocator().dealloc(ring);
+            }
+
+        public:
+            _ring(isize capacity, _ring* prev)
+                : capacity{ capacity }
+                , prev{ prev }
+            {
+                for (isize i = 0; i < capacity; i++)
+                    std::construct_at(_get_slots() + i, nullptr);
+            }
+
+        public:
+            auto get(isize i) -> _task*
+            {
+                return _get_slots()[i & (capacity - 1)].load(std::memory_order_relaxed);
+            }
+
+            auto put(isize i, _task* task) -> void
+            {
+                _get_slots()[i & (capacity - 1)].store(task, std::memory_order_relaxed);
+            }
+
+            auto grow(isize top, isize bottom) -> _ring*
+            {
+                _ring* ring = create(capacity * 2, this);
+                for (isize i = top; i < bottom; i++)
+                    ring->put(i, get(i));
+
+                return ring;
+            }
+
+        private:
+            auto _get_slots() -> std::atomic<_task*>*
+            {
+                return reinterpret_cast<std::atomic<_task*>*>(this + 1);
+            }
+
+        public:
+            isize capacity;
+            _ring* prev;
+        };
+
+    public:
+        static constexpr isize initial_capacity = 256;
+
+    public:
+        _task_deque()
+            : _top{ 0 }
+            , _bottom{ 0 }
+            , _ring_ptr{ _ring::create(initial_capacity, nullptr) }
+        {}
+
+        ~_task_deque()
+        {
+            _ring* ring = _ring_ptr.load(std::memory_order_relaxed);
+            while (ring != nullptr)
+            {
+                _ring* prev = ring->prev;
+                _ring::destroy(ring);
+                ring = prev;
+            }
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// pushes `task` at the bottom. only the owner calls this.
+        /// ----------------------------------------------------------------------------------------
+        auto push(_task* task) -> void
+        {
+            isize bottom = _bottom.load(std::memory_order_relaxed);
+            isize top = _top.load(std::memory_order_acquire);
+            _ring* ring = _ring_ptr.load(std::memory_order_relaxed);
+
+            if (bottom - top > ring->capacity - 1)
+            {
+                ring = ring->grow(top, bottom);
+                _ring_ptr.store(ring, std::memory_order_release);
+            }
+
+            ring->put(bottom, task);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops the task at the bottom, the one pushed last. only the owner calls this.
+        /// ----------------------------------------------------------------------------------------
+        auto pop() -> _task*
+        {
+            isize bottom = _bottom.load(std::memory_order_relaxed) - 1;
+            _ring* ring = _ring_ptr.load(std::memory_order_relaxed);
+            _bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            isize top = _top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            _task* task = ring->get(bottom);
+            if (top == bottom)
+            {
+                // last task, a thief may be stealing it too.
+                if (not _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                        std::memory_order_relaxed))
+                    task = nullptr;
+
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return task;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// steals the task at the top, the oldest one. returns `nullptr` if the deque is empty or
+        /// another thread took the task first.
+        /// ----------------------------------------------------------------------------------------
+        auto steal() -> _task*
+        {
+            isize top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            isize bottom = _bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return nullptr;
+
+            _ring* ring = _ring_ptr.load(std::memory_order_acquire);
+            _task* task = ring->get(top);
+
+            if (not _top.compare_exchange_strong(
+                    top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+
+            return task;
+        }
+
+    private:
+        // padding keeps thieves updating `_top` from invalidating the owner's cache line.
+        std::atomic<isize> _top;
+        byte _top_padding[64];
+        std::atomic<isize> _bottom;
+        std::atomic<_ring*> _ring_ptr;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// state of a worker thread, only its deque is used by other threads.
+    /// --------------------------------------------------------------------------------------------
+    class _task_worker
+    {
+    public:
+        _task_worker(const void* scheduler, usize index)
+            : scheduler{ scheduler }
+            , index{ index }
+            , rand_state{ 0x9e3779b97f4a7c15 * (index + 1) }
+        {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns next pseudo random number, using xorshift. picks workers to steal from.
+        /// ----------------------------------------------------------------------------------------
+        auto get_rand() -> u64
+        {
+            rand_state ^= rand_state << 13;
+            rand_state ^= rand_state >> 7;
+            rand_state ^= rand_state << 17;
+            return rand_state;
+        }
+
+    public:
+        const void* scheduler;
+        usize index;
+        u64 rand_state;
+        _task_deque deque;
+        _task_cache cache;
+    };
+
+    /// worker running on this thread, if any.
+    thread_local _task_worker* _current_task_worker = nullptr;
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export class task_group;
+
+    /// --------------------------------------------------------------------------------------------
+    /// runs tasks on a fixed set of worker threads.
+    ///
+    /// each worker has its own deque of tasks. tasks spawned on a worker go to its deque, where it
+    /// runs them newest first, while idle workers steal the oldest tasks from random workers.
+    /// tasks spawned from other threads go to a shared queue. workers with nothing to run sleep
+    /// until new tasks are spawned.
+    ///
+    /// functions of up to 48 bytes are stored inside recycled tasks, so spawning them doesn't
+    /// allocate. tasks must not throw.
+    /// --------------------------------------------------------------------------------------------
+    export class task_scheduler
+    {
+        friend class task_group;
+
+    public:
+        class options
+        {
+        public:
+            /// count of worker threads, `0` to use one per core.
+            usize worker_count = 0;
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// starts one worker thread per core.
+        /// ----------------------------------------------------------------------------------------
+        task_scheduler()
+            : task_scheduler{ options{} }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # constructor
+        /// ----------------------------------------------------------------------------------------
+        explicit task_scheduler(const options& opts)
+            : _injected_tasks{ nullptr }
+            , _injected_tasks_last{ nullptr }
+            , _injected_count{ 0 }
+            , _detached_pending{ 0 }
+            , _is_stopping{ false }
+        {
+            usize worker_count = opts.worker_count;
+            if (worker_count == 0)
+                worker_count = std::max<usize>(std::thread::hardware_concurrency(), 1);
+
+            _workers.reserve(worker_count);
+            for (usize i = 0; i < worker_count; i++)
+            {
+                void* mem = default_mem_allocator().alloc(sizeof(_task_worker));
+                _workers.push_back(std::construct_at(static_cast<_task_worker*>(mem), this, i));
+            }
+
+            _threads.reserve(worker_count);
+            for (_task_worker* worker : _workers)
+                _threads.emplace_back([this, worker] { _run_worker(worker); });
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        task_scheduler(const task_scheduler& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(const task_scheduler& that) -> task_scheduler& = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// waits for tasks spawned with `spawn()`, then stops the workers. all task groups must
+        /// be done before.
+        /// ----------------------------------------------------------------------------------------
+        ~task_scheduler()
+        {
+            _wait(_detached_pending);
+
+            _is_stopping.store(true, std::memory_order_release);
+            _event.notify_all();
+
+            for (std::thread& thread : _threads)
+                thread.join();
+
+            for (_task_worker* worker : _workers)
+            {
+                std::destroy_at(worker);
+                default_mem_allocator().dealloc(worker);
+            }
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// scheduler shared by the whole process, with one worker per core. created on first use.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_shared() -> task_scheduler&
+        {
+            static task_scheduler scheduler;
+            return scheduler;
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// spawns a task running `fn()`, without a way to wait for it. the destructor waits for
+        /// such tasks.
+        /// ----------------------------------------------------------------------------------------
+        template <typename function_type>
+        auto spawn(function_type&& fn) -> void
+        {
+            _spawn(_detached_pending, forward<function_type>(fn));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of worker threads.
+        /// ----------------------------------------------------------------------------------------
+        auto get_worker_count() const -> usize
+        {
+            return _workers.size();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of blocks of tasks allocated, which stops growing once the scheduler
+        /// has warmed up.
+        /// ----------------------------------------------------------------------------------------
+        auto get_task_block_count() const -> usize
+        {
+            usize count = _cache.get_block_count();
+            for (const _task_worker* worker : _workers)
+                count += worker->cache.get_block_count();
+
+            return count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if the calling thread is a worker of this scheduler.
+        /// ----------------------------------------------------------------------------------------
+        auto is_worker_thread() const -> bool
+        {
+            return _get_current_worker() != nullptr;
+        }
+
+    private:
+        template <typename function_type>
+        auto _spawn(std::atomic<u32>& pending, function_type&& fn) -> void
+        {
+            _task_worker* worker = _get_current_worker();
+            _task* task = _alloc_task(worker);
+            task->fn = forward<function_type>(fn);
+            task->pending = &pending;
+
+            pending.fetch_add(1, std::memory_order_relaxed);
+
+            if (worker != nullptr)
+                worker->deque.push(task);
+            else
+                _inject(task);
+
+            _event.notify_one();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// runs tasks until `pending` drops to zero, sleeping while there are none to run.
+        /// ----------------------------------------------------------------------------------------
+        auto _wait(std::atomic<u32>& pending) -> void
+        {
+            _task_worker* worker = _get_current_worker();
+
+            while (pending.load(std::memory_order_acquire) != 0)
+            {
+                if (_task* task = _find_task(worker))
+                {
+                    _run_task(worker, task);
+                    continue;
+                }
+
+                u32 key = _event.prepare_wait();
+
+                if (pending.load(std::memory_order_acquire) == 0)
+                {
+                    _event.cancel_wait();
+                    return;
+                }
+
+                if (_task* task = _find_task(worker))
+                {
+                    _event.cancel_wait();
+                    _run_task(worker, task);
+                    continue;
+                }
+
+                _event.commit_wait(key);
+            }
+        }
+
+        auto _run_worker(_task_worker* worker) -> void
+        {
+            _current_task_worker = worker;
+
+            while (true)
+            {
+                if (_task* task = _find_task_spinning(worker))
+                {
+                    _run_task(worker, task);
+                    continue;
+                }
+
+                u32 key = _event.prepare_wait();
+
+                if (_is_stopping.load(std::memory_order_acquire))
+                {
+                    _event.cancel_wait();
+                    break;
+                }
+
+                if (_task* task = _find_task(worker))
+                {
+                    _event.cancel_wait();
+                    _run_task(worker, task);
+                    continue;
+                }
+
+                _event.commit_wait(key);
+            }
+
+            _current_task_worker = nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// searches for a task a few times before giving up, since sleeping and waking up costs
+        /// more than a short spin when tasks are spawned in quick succession.
+        /// ----------------------------------------------------------------------------------------
+        auto _find_task_spinning(_task_worker* worker) -> _task*
+        {
+            static constexpr usize spin_count = 64;
+
+            for (usize i = 0; i < spin_count; i++)
+            {
+                if (_task* task = _find_task(worker))
+                    return task;
+
+                std::this_thread::yield();
+            }
+
+            return nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns a task from the own deque, the shared queue or another worker, in that order.
+        /// ----------------------------------------------------------------------------------------
+        auto _find_task(_task_worker* worker) -> _task*
+        {
+            if (worker != nullptr)
+            {
+                if (_task* task = worker->deque.pop())
+                    return task;
+            }
+
+            if (_injected_count.load(std::memory_order_acquire) > 0)
+            {
+                if (_task* task = _pop_injected())
+                    return task;
+            }
+
+            const usize worker_count = _workers.size();
+            const usize start = worker != nullptr ? usize(worker->get_rand() % worker_count) : 0;
+
+            for (usize i = 0; i < worker_count; i++)
+            {
+                _task_worker* victim = _workers[(start + i) % worker_count];
+                if (victim == worker)
+                    continue;
+
+                if (_task* task = victim->deque.steal())
+                    return task;
+            }
+
+            return nullptr;
+        }
+
+        auto _run_task(_task_worker* worker, _task* task) -> void
+        {
+            task->fn();
+            task->fn = nullptr;
+
+            std::atomic<u32>* pending = task->pending;
+            _dealloc_task(worker, task);
+
+            // waiting threads sleep on the same event as idle workers.
+            if (pending->fetch_sub(1, std::memory_order_acq_rel) == 1)
+                _event.notify_all();
+        }
+
+        auto _inject(_task* task) -> void
+        {
+            std::unique_lock lock{ _mutex };
+
+            task->next = nullptr;
+            if (_injected_tasks_last == nullptr)
+                _injected_tasks = task;
+            else
+                _injected_tasks_last->next = task;
+
+            _injected_tasks_last = task;
+            _injected_count.fetch_add(1, std::memory_order_release);
+        }
+
+        auto _pop_injected() -> _task*
+        {
+            std::unique_lock lock{ _mutex };
+
+            _task* task = _injected_tasks;
+            if (task == nullptr)
+                return nullptr;
+
+            _injected_tasks = task->next;
+            if (_injected_tasks == nullptr)
+                _injected_tasks_last = nullptr;
+
+            _injected_count.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+
+        auto _alloc_task(_task_worker* worker) -> _task*
+        {
+            if (worker != nullptr)
+                return worker->cache.alloc();
+
+            std::unique_lock lock{ _mutex };
+            return _cache.alloc();
+        }
+
+        auto _dealloc_task(_task_worker* worker, _task* task) -> void
+        {
+            if (worker != nullptr and task->owner == &worker->cache)
+                return worker->cache.dealloc(task);
+
+            task->owner->give_back(task);
+        }
+
+        auto _get_current_worker() const -> _task_worker*
+        {
+            _task_worker* worker = _current_task_worker;
+            if (worker == nullptr or worker->scheduler != this)
+                return nullptr;
+
+            return worker;
+        }
+
+    private:
+        std::vector<_task_worker*> _workers;
+        std::vector<std::thread> _threads;
+        _event_count _event;
+
+        /// guards the shared queue and allocating from `_cache`.
+        std::mutex _mutex;
+        _task* _injected_tasks;
+        _task* _injected_tasks_last;
+        std::atomic<usize> _injected_count;
+
+        /// tasks of threads which aren't workers.
+        _task_cache _cache;
+
+        std::atomic<u32> _detached_pending;
+        std::atomic<bool> _is_stopping;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// tasks spawned together, to wait for all of them.
+    ///
+    /// `wait()` runs tasks while the group isn't done, so groups can be waited for from inside
+    /// tasks without blocking workers.
+    /// --------------------------------------------------------------------------------------------
+    export class task_group
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # constructor
+        ///
+        /// creates a group spawning tasks on `scheduler`.
+        /// ----------------------------------------------------------------------------------------
+        explicit task_group(task_scheduler& scheduler = task_scheduler::get_shared())
+            : _scheduler{ scheduler }
+            , _pending{ 0 }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy constructor
+        /// ----------------------------------------------------------------------------------------
+        task_group(const task_group& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # copy operator
+        /// ----------------------------------------------------------------------------------------
+        auto operator=(const task_group& that) -> task_group& = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// waits for all tasks of the group.
+        /// ----------------------------------------------------------------------------------------
+        ~task_group()
+        {
+            wait();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// spawns a task running `fn()` in this group.
+        /// ----------------------------------------------------------------------------------------
+        template <typename function_type>
+        auto spawn(function_type&& fn) -> void
+        {
+            _scheduler._spawn(_pending, forward<function_type>(fn));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// blocks until all tasks spawned in this group are done, running tasks meanwhile.
+        /// ----------------------------------------------------------------------------------------
+        auto wait() -> void
+        {
+            _scheduler._wait(_pending);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if all tasks spawned in this group are done.
+        /// ----------------------------------------------------------------------------------------
+        auto is_done() const -> bool
+        {
+            return _pending.load(std::memory_order_acquire) == 0;
+        }
+
+        auto get_scheduler() const -> task_scheduler&
+        {
+            return _scheduler;
+        }
+
+    private:
+        task_scheduler& _scheduler;
+        std::atomic<u32> _pending;
+    };
+}
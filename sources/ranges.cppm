@@ -6,3 +6,4 @@ export import :ranges.range_concepts;
 export import :ranges.range_definition;
 export import :ranges.range_functions;
 export import :ranges.range_conversions;
+export import :ranges.range_views;
@@ -0,0 +1,376 @@
+module;
+#include "atom/core/preprocessors.h"
+
+#if defined(ATOM_ARCH_X86_64) && defined(ATOM_HAS_ATTR_TARGET)
+#    define ATOM_BYTE_SEARCH_X86
+#    include <immintrin.h>
+#endif
+
+export module atom_core:ranges.byte_search;
+
+import std;
+import :core;
+
+/// ------------------------------------------------------------------------------------------------
+/// search and comparision kernels for contiguous ranges of bytes, used by range functions for
+/// ranges like `string_view`.
+///
+/// the kernels are picked once at runtime, based on the instruction sets supported by the cpu.
+/// every kernel returns the index of the match, or `count` if there is none.
+/// ------------------------------------------------------------------------------------------------
+namespace atom::ranges
+{
+    class _byte_search_kernels
+    {
+    public:
+        auto (*find_byte)(const u8* data, usize count, u8 value) -> usize;
+        auto (*find_any_byte)(const u8* data, usize count, const u8* set, usize set_count) -> usize;
+        auto (*find_bytes)(const u8* data, usize count, const u8* needle, usize needle_count)
+            -> usize;
+        auto (*is_eq_bytes)(const u8* data, const u8* that_data, usize count) -> bool;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// portable kernels, used when no simd instruction set is available.
+    ///
+    /// the kernel classes are exported only so that tests can run each of them, whichever one is
+    /// picked for the cpu.
+    /// --------------------------------------------------------------------------------------------
+    export class _byte_search_scalar
+    {
+    public:
+        static auto find_byte(const u8* data, usize count, u8 value) -> usize
+        {
+            if (count == 0)
+                return 0;
+
+            const void* found = std::memchr(data, value, count);
+            return found == nullptr ? count : static_cast<const u8*>(found) - data;
+        }
+
+        static auto find_any_byte(const u8* data, usize count, const u8* set, usize set_count)
+            -> usize
+        {
+            bool table[256] = {};
+            for (usize i = 0; i < set_count; i++)
+                table[set[i]] = true;
+
+            for (usize i = 0; i < count; i++)
+            {
+                if (table[data[i]])
+                    return i;
+            }
+
+            return count;
+        }
+
+        static auto find_bytes(const u8* data, usize count, const u8* needle, usize needle_count)
+            -> usize
+        {
+            if (needle_count == 0)
+                return 0;
+
+            if (needle_count > count)
+                return count;
+
+            const usize last = count - needle_count;
+            usize i = 0;
+            while (i <= last)
+            {
+                usize found = find_byte(data + i, last - i + 1, needle[0]);
+                if (found == last - i + 1)
+                    return count;
+
+                i += found;
+                if (std::memcmp(data + i, needle, needle_count) == 0)
+                    return i;
+
+                i++;
+            }
+
+            return count;
+        }
+
+        static auto is_eq_bytes(const u8* data, const u8* that_data, usize count) -> bool
+        {
+            return count == 0 or std::memcmp(data, that_data, count) == 0;
+        }
+    };
+
+#if defined(ATOM_BYTE_SEARCH_X86)
+    /// --------------------------------------------------------------------------------------------
+    /// sse4.2 kernels, processing 16 bytes at a time.
+    /// --------------------------------------------------------------------------------------------
+    export class _byte_search_sse4_2
+    {
+    public:
+        ATOM_ATTR_TARGET("sse4.2")
+        static auto find_byte(const u8* data, usize count, u8 value) -> usize
+        {
+            const __m128i needle = _mm_set1_epi8(char(value));
+
+            usize i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                u32 mask = u32(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+                if (mask != 0)
+                    return i + std::countr_zero(mask);
+            }
+
+            return i + _byte_search_scalar::find_byte(data + i, count - i, value);
+        }
+
+        ATOM_ATTR_TARGET("sse4.2")
+        static auto find_any_byte(const u8* data, usize count, const u8* set, usize set_count)
+            -> usize
+        {
+            if (set_count == 0)
+                return count;
+
+            if (set_count > 16)
+                return _byte_search_scalar::find_any_byte(data, count, set, set_count);
+
+            alignas(16) u8 set_buf[16] = {};
+            std::memcpy(set_buf, set, set_count);
+            const __m128i set_vec = _mm_load_si128(reinterpret_cast<const __m128i*>(set_buf));
+            constexpr i32 mode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT;
+
+            usize i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                i32 index = _mm_cmpestri(set_vec, i32(set_count), block, 16, mode);
+                if (index != 16)
+                    return i + index;
+            }
+
+            return i + _byte_search_scalar::find_any_byte(data + i, count - i, set, set_count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// compares the first and last byte of `needle` with 16 positions at once, and only
+        /// compares the whole needle at positions where both match.
+        /// ----------------------------------------------------------------------------------------
+        ATOM_ATTR_TARGET("sse4.2")
+        static auto find_bytes(const u8* data, usize count, const u8* needle, usize needle_count)
+            -> usize
+        {
+            if (needle_count <= 1 or needle_count > count)
+            {
+                return needle_count == 1 ? find_byte(data, count, needle[0])
+                                         : _byte_search_scalar::find_bytes(
+                                               data, count, needle, needle_count);
+            }
+
+            const __m128i first = _mm_set1_epi8(char(needle[0]));
+            const __m128i last = _mm_set1_epi8(char(needle[needle_count - 1]));
+
+            usize i = 0;
+            for (; i + needle_count - 1 + 16 <= count; i += 16)
+            {
+                __m128i block_first =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                __m128i block_last =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needle_count - 1));
+
+                u32 mask = u32(_mm_movemask_epi8(_mm_and_si128(
+                    _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+
+                while (mask != 0)
+                {
+                    usize pos = i + std::countr_zero(mask);
+                    if (std::memcmp(data + pos + 1, needle + 1, needle_count - 2) == 0)
+                        return pos;
+
+                    mask &= mask - 1;
+                }
+            }
+
+            usize found =
+                _byte_search_scalar::find_bytes(data + i, count - i, needle, needle_count);
+            return i + found;
+        }
+
+        ATOM_ATTR_TARGET("sse4.2")
+        static auto is_eq_bytes(const u8* data, const u8* that_data, usize count) -> bool
+        {
+            usize i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                __m128i that_block =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(that_data + i));
+
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(block, that_block)) != 0xFFFF)
+                    return false;
+            }
+
+            return _byte_search_scalar::is_eq_bytes(data + i, that_data + i, count - i);
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// avx2 kernels, processing 32 bytes at a time.
+    /// --------------------------------------------------------------------------------------------
+    export class _byte_search_avx2
+    {
+    public:
+        ATOM_ATTR_TARGET("avx2")
+        static auto find_byte(const u8* data, usize count, u8 value) -> usize
+        {
+            const __m256i needle = _mm256_set1_epi8(char(value));
+
+            usize i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                u32 mask = u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+                if (mask != 0)
+                    return i + std::countr_zero(mask);
+            }
+
+            return i + _byte_search_sse4_2::find_byte(data + i, count - i, value);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// small sets are compared byte by byte with each block, bigger sets use the sse4.2
+        /// kernel which compares with up to 16 bytes in one instruction.
+        /// ----------------------------------------------------------------------------------------
+        ATOM_ATTR_TARGET("avx2")
+        static auto find_any_byte(const u8* data, usize count, const u8* set, usize set_count)
+            -> usize
+        {
+            if (set_count == 0)
+                return count;
+
+            if (set_count > 4)
+                return _byte_search_sse4_2::find_any_byte(data, count, set, set_count);
+
+            __m256i set_vecs[4];
+            for (usize i = 0; i < 4; i++)
+                set_vecs[i] = _mm256_set1_epi8(char(set[i < set_count ? i : 0]));
+
+            usize i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i matches = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, set_vecs[0]),
+                        _mm256_cmpeq_epi8(block, set_vecs[1])),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, set_vecs[2]),
+                        _mm256_cmpeq_epi8(block, set_vecs[3])));
+
+                u32 mask = u32(_mm256_movemask_epi8(matches));
+                if (mask != 0)
+                    return i + std::countr_zero(mask);
+            }
+
+            return i + _byte_search_sse4_2::find_any_byte(data + i, count - i, set, set_count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// same as the sse4.2 kernel, with 32 positions at once.
+        /// ----------------------------------------------------------------------------------------
+        ATOM_ATTR_TARGET("avx2")
+        static auto find_bytes(const u8* data, usize count, const u8* needle, usize needle_count)
+            -> usize
+        {
+            if (needle_count <= 1 or needle_count > count)
+            {
+                return needle_count == 1 ? find_byte(data, count, needle[0])
+                                         : _byte_search_scalar::find_bytes(
+                                               data, count, needle, needle_count);
+            }
+
+            const __m256i first = _mm256_set1_epi8(char(needle[0]));
+            const __m256i last = _mm256_set1_epi8(char(needle[needle_count - 1]));
+
+            usize i = 0;
+            for (; i + needle_count - 1 + 32 <= count; i += 32)
+            {
+                __m256i block_first =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i block_last = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(data + i + needle_count - 1));
+
+                u32 mask = u32(_mm256_movemask_epi8(_mm256_and_si256(
+                    _mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+
+                while (mask != 0)
+                {
+                    usize pos = i + std::countr_zero(mask);
+                    if (std::memcmp(data + pos + 1, needle + 1, needle_count - 2) == 0)
+                        return pos;
+
+                    mask &= mask - 1;
+                }
+            }
+
+            usize found =
+                _byte_search_sse4_2::find_bytes(data + i, count - i, needle, needle_count);
+            return i + found;
+        }
+
+        ATOM_ATTR_TARGET("avx2")
+        static auto is_eq_bytes(const u8* data, const u8* that_data, usize count) -> bool
+        {
+            usize i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i that_block =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(that_data + i));
+
+                if (u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, that_block))) != ~u32(0))
+                    return false;
+            }
+
+            return _byte_search_sse4_2::is_eq_bytes(data + i, that_data + i, count - i);
+        }
+    };
+#endif
+
+    /// --------------------------------------------------------------------------------------------
+    /// \returns kernels for the best instruction set supported by the cpu.
+    /// --------------------------------------------------------------------------------------------
+    inline auto _select_byte_search_kernels() -> _byte_search_kernels
+    {
+#if defined(ATOM_BYTE_SEARCH_X86)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return _byte_search_kernels{
+                .find_byte = &_byte_search_avx2::find_byte,
+                .find_any_byte = &_byte_search_avx2::find_any_byte,
+                .find_bytes = &_byte_search_avx2::find_bytes,
+                .is_eq_bytes = &_byte_search_avx2::is_eq_bytes,
+            };
+        }
+
+        if (__builtin_cpu_supports("sse4.2"))
+        {
+            return _byte_search_kernels{
+                .find_byte = &_byte_search_sse4_2::find_byte,
+                .find_any_byte = &_byte_search_sse4_2::find_any_byte,
+                .find_bytes = &_byte_search_sse4_2::find_bytes,
+                .is_eq_bytes = &_byte_search_sse4_2::is_eq_bytes,
+            };
+        }
+#endif
+
+        return _byte_search_kernels{
+            .find_byte = &_byte_search_scalar::find_byte,
+            .find_any_byte = &_byte_search_scalar::find_any_byte,
+            .find_bytes = &_byte_search_scalar::find_bytes,
+            .is_eq_bytes = &_byte_search_scalar::is_eq_bytes,
+        };
+    }
+
+    inline auto _get_byte_search_kernels() -> const _byte_search_kernels&
+    {
+        static const _byte_search_kernels kernels = _select_byte_search_kernels();
+        return kernels;
+    }
+}
@@ -8,7 +8,9 @@ import :ranges.iterator_definition;
 export namespace atom::ranges
 {
     /// --------------------------------------------------------------------------------------------
-    ///
+    /// `iterator_end_type` can be a different type than `iterator_type`, which is only compared
+    /// with it. so this doesn't use `std::equality_comparable_with`, which needs a common
+    /// reference between the two types.
     /// --------------------------------------------------------------------------------------------
     template <typename iterator_type, typename iterator_end_type>
     concept iterator_end_concept =
@@ -16,7 +18,10 @@ export namespace atom::ranges
         and type_info<iterator_end_type>::is_copyable()
         and type_info<iterator_end_type>::is_moveable()
         and type_info<iterator_end_type>::is_destructible()
-        and type_info<iterator_end_type>::template is_equality_comparable_with<iterator_type>();
+        and requires(const iterator_type& it, const iterator_end_type& it_end) {
+                { it == it_end } -> std::convertible_to<bool>;
+                { it != it_end } -> std::convertible_to<bool>;
+            };
 
     /// --------------------------------------------------------------------------------------------
     ///
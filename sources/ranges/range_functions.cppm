@@ -522,6 +522,21 @@ export namespace atom::ranges
         return impl_type<range_type>::find_range(range, that_range);
     }
 
+    /// ----------------------------------------------------------------------------------------
+    /// \returns iterator to the first value in `range` which is equal to any value in
+    /// `that_range`, or end iterator if there is none.
+    /// ----------------------------------------------------------------------------------------
+    template <typename range_type, typename that_range_type>
+    constexpr auto find_any(const range_type& range,
+        const that_range_type& that_range) -> const_iterator_type<range_type>
+        requires const_range_concept<range_type>
+                 and const_unidirectional_range_concept<that_range_type>
+                 and (type_info<value_type<range_type>>::template is_equality_comparable_with<
+                     typename that_range_type::value_type>())
+    {
+        return impl_type<range_type>::find_any(range, that_range);
+    }
+
     template <typename range_type, typename that_range_type>
     constexpr auto count_any(const range_type& range, const that_range_type& that_range) -> usize
         requires const_range_concept<range_type>
@@ -605,7 +620,7 @@ export namespace atom::ranges
                  and type_info<value_type<range_type>>::template is_equality_comparable_with<
                      typename that_range_type::value_type>())
     {
-        return impl_type<range_type>::contains(range, that_range);
+        return impl_type<range_type>::contains_range(range, that_range);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -6,6 +6,7 @@ import :types;
 import :ranges.iterator_concepts;
 import :ranges.range_concepts;
 import :ranges.range_definition;
+import :ranges.byte_search;
 
 namespace atom::ranges
 {
@@ -125,12 +126,53 @@ namespace atom::ranges
         static constexpr auto find_value(
             const range_type& range, const that_value_type& value) -> const_iterator_type
         {
+            if constexpr (_is_byte_range<range_type>() and _is_byte<that_value_type>())
+            {
+                if not consteval
+                {
+                    usize count = get_count(range);
+                    if (count == 0)
+                        return get_iterator(range);
+
+                    usize index =
+                        _get_byte_search_kernels().find_byte(_get_bytes(range), count, u8(value));
+                    return get_iterator_at(range, index);
+                }
+            }
+
             auto begin = get_iterator(range);
             auto end = get_iterator_end(range);
 
             return std::find(begin, end, value);
         }
 
+        template <typename that_range_type>
+        static constexpr auto find_any(
+            const range_type& range, const that_range_type& that_range) -> const_iterator_type
+        {
+            if constexpr (_is_byte_range<range_type>() and _is_byte_range<that_range_type>())
+            {
+                if not consteval
+                {
+                    usize count = get_count(range);
+                    usize that_count = _get_range_count(that_range);
+                    if (count == 0 or that_count == 0)
+                        return get_iterator_end(range);
+
+                    usize index = _get_byte_search_kernels().find_any_byte(
+                        _get_bytes(range), count, _get_bytes(that_range), that_count);
+                    return get_iterator_at(range, index);
+                }
+            }
+
+            auto begin = get_iterator(range);
+            auto end = get_iterator_end(range);
+            auto that_begin = range_definition<that_range_type>::get_const_iterator(that_range);
+            auto that_end = range_definition<that_range_type>::get_const_iterator_end(that_range);
+
+            return std::find_first_of(begin, end, that_begin, that_end);
+        }
+
         template <typename function_type>
         static constexpr auto find_if(
             const range_type& range, const function_type& pred) -> const_iterator_type
@@ -145,6 +187,24 @@ namespace atom::ranges
         static constexpr auto find_range(
             const range_type& range, const that_range_type& that_range) -> const_iterator_type
         {
+            if constexpr (_is_byte_range<range_type>() and _is_byte_range<that_range_type>())
+            {
+                if not consteval
+                {
+                    usize count = get_count(range);
+                    usize that_count = _get_range_count(that_range);
+                    if (that_count == 0)
+                        return get_iterator(range);
+
+                    if (count < that_count)
+                        return get_iterator_end(range);
+
+                    usize index = _get_byte_search_kernels().find_bytes(
+                        _get_bytes(range), count, _get_bytes(that_range), that_count);
+                    return get_iterator_at(range, index);
+                }
+            }
+
             auto begin = get_iterator(range);
             auto end = get_iterator_end(range);
             auto that_begin = get_iterator(that_range);
@@ -157,6 +217,22 @@ namespace atom::ranges
         static constexpr auto compare(
             const range_type& range, const that_range_type& that_range) -> i8
         {
+            if constexpr (_is_byte_range<range_type>() and _is_byte_range<that_range_type>())
+            {
+                if not consteval
+                {
+                    usize count = get_count(range);
+                    if (count != _get_range_count(that_range))
+                        return 1;
+
+                    if (count == 0)
+                        return 0;
+
+                    return not _get_byte_search_kernels().is_eq_bytes(
+                        _get_bytes(range), _get_bytes(that_range), count);
+                }
+            }
+
             auto begin = get_iterator(range);
             auto end = get_iterator_end(range);
             auto that_begin = get_iterator(that_range);
@@ -175,7 +251,8 @@ namespace atom::ranges
         static constexpr auto count_values(const range_type& range) -> usize
         {
             if constexpr (ranges::const_random_access_iterator_pair_concept<const_iterator_type,
-                              const_iterator_end_type>)
+                              const_iterator_end_type>
+                          or std::sized_sentinel_for<const_iterator_end_type, const_iterator_type>)
             {
                 return get_iterator_end(range) - get_iterator(range);
             }
@@ -196,6 +273,11 @@ namespace atom::ranges
         static constexpr auto contains(
             const range_type& range, const that_value_type& value) -> bool
         {
+            if constexpr (_is_byte_range<range_type>() and _is_byte<that_value_type>())
+            {
+                return find_value(range, value) != get_iterator_end(range);
+            }
+
             return std::ranges::contains(get_iterator(range), get_iterator_end(range), value);
         }
 
@@ -211,6 +293,11 @@ namespace atom::ranges
         static constexpr auto contains_range(
             const range_type& range, const that_range_type& that_range) -> bool
         {
+            if constexpr (_is_byte_range<range_type>() and _is_byte_range<that_range_type>())
+            {
+                return find_range(range, that_range) != get_iterator_end(range);
+            }
+
             auto begin = get_iterator(range);
             auto end = get_iterator_end(range);
             auto that_begin = get_iterator(that_range);
@@ -218,5 +305,46 @@ namespace atom::ranges
 
             return std::search(begin, end, that_begin, that_end) != end;
         }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// `true` if values of type `value_type` can be compared as raw bytes.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type>
+        static consteval auto _is_byte() -> bool
+        {
+            return sizeof(value_type) == 1
+                   and (std::is_integral_v<value_type> or std::is_enum_v<value_type>);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// `true` if `other_range_type` is contiguous range of bytes, which can be searched with
+        /// the kernels from `:ranges.byte_search`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_range_type>
+        static consteval auto _is_byte_range() -> bool
+        {
+            if constexpr (ranges::const_array_range_concept<other_range_type>)
+            {
+                return _is_byte<typename range_definition<other_range_type>::value_type>();
+            }
+
+            return false;
+        }
+
+        template <typename other_range_type>
+        static constexpr auto _get_range_count(const other_range_type& range) -> usize
+        {
+            return range_definition<other_range_type>::get_const_iterator_end(range)
+                   - range_definition<other_range_type>::get_const_iterator(range);
+        }
+
+        /// \pre `range` is not empty.
+        template <typename other_range_type>
+        static constexpr auto _get_bytes(const other_range_type& range) -> const u8*
+        {
+            return reinterpret_cast<const u8*>(
+                &*range_definition<other_range_type>::get_const_iterator(range));
+        }
     };
 }
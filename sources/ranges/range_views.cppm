@@ -0,0 +1,1436 @@
+export module atom_core:ranges.range_views;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :ranges.iterator_definition;
+import :ranges.iterator_concepts;
+import :ranges.range_definition;
+import :ranges.range_concepts;
+import :ranges.range_conversions;
+import :ranges.range_functions;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom::ranges
+{
+    export class view_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// `iterator_end_type` can tell the distance from `iterator_type` without iterating.
+    /// --------------------------------------------------------------------------------------------
+    template <typename iterator_type, typename iterator_end_type>
+    concept _sized_iterator_pair_concept =
+        std::sized_sentinel_for<iterator_end_type, iterator_type>;
+
+    /// --------------------------------------------------------------------------------------------
+    /// `iterator_type` can jump to any position in constant time.
+    /// --------------------------------------------------------------------------------------------
+    template <typename iterator_type, typename iterator_end_type>
+    concept _jump_iterator_pair_concept =
+        std::random_access_iterator<iterator_type>
+        and _sized_iterator_pair_concept<iterator_type, iterator_end_type>;
+
+    /// --------------------------------------------------------------------------------------------
+    /// views can only be iterated multiple times if their base can.
+    /// --------------------------------------------------------------------------------------------
+    template <typename iterator_type>
+    using _view_iterator_category = std::conditional_t<std::forward_iterator<iterator_type>,
+        std::forward_iterator_tag, std::input_iterator_tag>;
+
+    template <typename range_type>
+    using _view_base_iterator_type = typename range_definition<range_type>::const_iterator_type;
+
+    template <typename range_type>
+    using _view_base_iterator_end_type =
+        typename range_definition<range_type>::const_iterator_end_type;
+
+    template <typename range_type>
+    using _view_base_value_type = typename range_definition<range_type>::value_type;
+
+    /// --------------------------------------------------------------------------------------------
+    /// advances `it` by `steps`, stopping at `it_end`.
+    ///
+    /// \returns count of steps advanced.
+    /// --------------------------------------------------------------------------------------------
+    template <typename iterator_type, typename iterator_end_type>
+    constexpr auto _advance_bounded(
+        iterator_type& it, usize steps, const iterator_end_type& it_end) -> usize
+    {
+        if constexpr (_jump_iterator_pair_concept<iterator_type, iterator_end_type>)
+        {
+            steps = std::min(steps, usize(it_end - it));
+            it += isize(steps);
+            return steps;
+        }
+        else
+        {
+            usize count = 0;
+            for (; count < steps and it != it_end; count++)
+                ++it;
+
+            return count;
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// range stored in a view. other views are cheap to copy and are often temporaries in a
+    /// pipeline, so they are stored by value. other ranges are referred to and must outlive the
+    /// view.
+    /// --------------------------------------------------------------------------------------------
+    template <typename range_type>
+    class _view_base
+    {
+    public:
+        constexpr _view_base(const range_type& range)
+            : _range{ &range }
+        {}
+
+    public:
+        constexpr auto get() const -> const range_type&
+        {
+            return *_range;
+        }
+
+    private:
+        const range_type* _range;
+    };
+
+    template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<view_tag>())
+    class _view_base<range_type>
+    {
+    public:
+        constexpr _view_base(const range_type& range)
+            : _range{ range }
+        {}
+
+    public:
+        constexpr auto get() const -> const range_type&
+        {
+            return _range;
+        }
+
+    private:
+        range_type _range;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// end of views whose iterators wrap their base iterators one to one.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_end_type>
+    class _view_iterator_end
+    {
+    public:
+        base_iterator_end_type it_end;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// end of views whose iterators know where their base ends.
+    /// --------------------------------------------------------------------------------------------
+    class _view_bounded_iterator_end
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// iterator for `map_view`.
+    ///
+    /// the function is invoked only when the value is accessed, at most once per position. the
+    /// result is kept in the iterator, so that it can be returned by reference.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_type, typename base_iterator_end_type, typename function_type>
+    class _map_iterator
+    {
+        using this_type = _map_iterator;
+        using base_value_type = typename iterator_definition<base_iterator_type>::value_type;
+        using end_type = _view_iterator_end<base_iterator_end_type>;
+
+    public:
+        using value_type = std::remove_cvref_t<
+            std::invoke_result_t<const function_type&, const base_value_type&>>;
+        using difference_type = isize;
+        using iterator_category = _view_iterator_category<base_iterator_type>;
+
+    public:
+        constexpr _map_iterator()
+            : _fn{ nullptr }
+            , _it{}
+            , _value{}
+        {}
+
+        constexpr _map_iterator(const function_type* fn, base_iterator_type it)
+            : _fn{ fn }
+            , _it{ move(it) }
+            , _value{}
+        {}
+
+    public:
+        constexpr auto operator*() const -> const value_type&
+        {
+            if (not _value.is_value())
+                _value.emplace(std::invoke(*_fn, *_it));
+
+            return _value.get();
+        }
+
+        constexpr auto operator->() const -> const value_type*
+        {
+            return &**this;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            ++_it;
+            _value.reset();
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _it == that._it;
+        }
+
+        constexpr auto operator==(const end_type& end) const -> bool
+        {
+            return _it == end.it_end;
+        }
+
+        friend constexpr auto operator-(const end_type& end, const this_type& it) -> isize
+            requires _sized_iterator_pair_concept<base_iterator_type, base_iterator_end_type>
+        {
+            return end.it_end - it._it;
+        }
+
+        friend constexpr auto operator-(const this_type& it, const end_type& end) -> isize
+            requires _sized_iterator_pair_concept<base_iterator_type, base_iterator_end_type>
+        {
+            return it._it - end.it_end;
+        }
+
+    private:
+        const function_type* _fn;
+        base_iterator_type _it;
+        mutable option<value_type> _value;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// iterator for `filter_view`, always positioned at a value accepted by the predicate.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_type, typename base_iterator_end_type, typename function_type>
+    class _filter_iterator
+    {
+        using this_type = _filter_iterator;
+
+    public:
+        using value_type = typename iterator_definition<base_iterator_type>::value_type;
+        using difference_type = isize;
+        using iterator_category = _view_iterator_category<base_iterator_type>;
+
+    public:
+        constexpr _filter_iterator()
+            : _pred{ nullptr }
+            , _it{}
+            , _it_end{}
+        {}
+
+        constexpr _filter_iterator(
+            const function_type* pred, base_iterator_type it, base_iterator_end_type it_end)
+            : _pred{ pred }
+            , _it{ move(it) }
+            , _it_end{ move(it_end) }
+        {
+            _skip();
+        }
+
+    public:
+        constexpr auto operator*() const -> const value_type&
+        {
+            return *_it;
+        }
+
+        constexpr auto operator->() const -> const value_type*
+        {
+            return &*_it;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            ++_it;
+            _skip();
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _it == that._it;
+        }
+
+        constexpr auto operator==(const _view_bounded_iterator_end& end) const -> bool
+        {
+            return _it == _it_end;
+        }
+
+    private:
+        constexpr auto _skip() -> void
+        {
+            while (_it != _it_end and not std::invoke(*_pred, *_it))
+                ++_it;
+        }
+
+    private:
+        const function_type* _pred;
+        base_iterator_type _it;
+        base_iterator_end_type _it_end;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// iterator for `take_view`, when the end of the base can't be found by jumping.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_type, typename base_iterator_end_type>
+    class _take_iterator
+    {
+        using this_type = _take_iterator;
+
+    public:
+        using value_type = typename iterator_definition<base_iterator_type>::value_type;
+        using difference_type = isize;
+        using iterator_category = _view_iterator_category<base_iterator_type>;
+
+    public:
+        constexpr _take_iterator()
+            : _it{}
+            , _it_end{}
+            , _remaining{ 0 }
+        {}
+
+        constexpr _take_iterator(
+            base_iterator_type it, base_iterator_end_type it_end, usize remaining)
+            : _it{ move(it) }
+            , _it_end{ move(it_end) }
+            , _remaining{ remaining }
+        {}
+
+    public:
+        constexpr auto operator*() const -> const value_type&
+        {
+            return *_it;
+        }
+
+        constexpr auto operator->() const -> const value_type*
+        {
+            return &*_it;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            ++_it;
+            _remaining--;
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _remaining == that._remaining;
+        }
+
+        constexpr auto operator==(const _view_bounded_iterator_end& end) const -> bool
+        {
+            return _remaining == 0 or _it == _it_end;
+        }
+
+    private:
+        base_iterator_type _it;
+        base_iterator_end_type _it_end;
+        usize _remaining;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// iterator for `stride_view`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_type, typename base_iterator_end_type>
+    class _stride_iterator
+    {
+        using this_type = _stride_iterator;
+
+    public:
+        using value_type = typename iterator_definition<base_iterator_type>::value_type;
+        using difference_type = isize;
+        using iterator_category = _view_iterator_category<base_iterator_type>;
+
+    public:
+        constexpr _stride_iterator()
+            : _it{}
+            , _it_end{}
+            , _step{ 1 }
+        {}
+
+        constexpr _stride_iterator(
+            base_iterator_type it, base_iterator_end_type it_end, usize step)
+            : _it{ move(it) }
+            , _it_end{ move(it_end) }
+            , _step{ step }
+        {}
+
+    public:
+        constexpr auto operator*() const -> const value_type&
+        {
+            return *_it;
+        }
+
+        constexpr auto operator->() const -> const value_type*
+        {
+            return &*_it;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _advance_bounded(_it, _step, _it_end);
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _it == that._it;
+        }
+
+        constexpr auto operator==(const _view_bounded_iterator_end& end) const -> bool
+        {
+            return _it == _it_end;
+        }
+
+        friend constexpr auto operator-(
+            const _view_bounded_iterator_end& end, const this_type& it) -> isize
+            requires _sized_iterator_pair_concept<base_iterator_type, base_iterator_end_type>
+        {
+            const isize remaining = it._it_end - it._it;
+            return (remaining + isize(it._step) - 1) / isize(it._step);
+        }
+
+        friend constexpr auto operator-(
+            const this_type& it, const _view_bounded_iterator_end& end) -> isize
+            requires _sized_iterator_pair_concept<base_iterator_type, base_iterator_end_type>
+        {
+            return -(end - it);
+        }
+
+    private:
+        base_iterator_type _it;
+        base_iterator_end_type _it_end;
+        usize _step;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// iterator for `chunk_view`. each chunk is a range of base iterators.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_type, typename base_iterator_end_type>
+    class _chunk_iterator
+    {
+        using this_type = _chunk_iterator;
+
+    public:
+        using value_type = _range_from_iterator_pair<base_iterator_type, base_iterator_type>;
+        using difference_type = isize;
+        using iterator_category = std::forward_iterator_tag;
+
+    public:
+        constexpr _chunk_iterator()
+            : _chunk{ base_iterator_type{}, base_iterator_type{} }
+            , _it_end{}
+            , _size{ 1 }
+        {}
+
+        constexpr _chunk_iterator(base_iterator_type it, base_iterator_end_type it_end, usize size)
+            : _chunk{ it, it }
+            , _it_end{ move(it_end) }
+            , _size{ size }
+        {
+            _advance_bounded(_chunk.it_end, _size, _it_end);
+        }
+
+    public:
+        constexpr auto operator*() const -> const value_type&
+        {
+            return _chunk;
+        }
+
+        constexpr auto operator->() const -> const value_type*
+        {
+            return &_chunk;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _chunk.it = _chunk.it_end;
+            _advance_bounded(_chunk.it_end, _size, _it_end);
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _chunk.it == that._chunk.it;
+        }
+
+        constexpr auto operator==(const _view_bounded_iterator_end& end) const -> bool
+        {
+            return _chunk.it == _it_end;
+        }
+
+        friend constexpr auto operator-(
+            const _view_bounded_iterator_end& end, const this_type& it) -> isize
+            requires _sized_iterator_pair_concept<base_iterator_type, base_iterator_end_type>
+        {
+            const isize remaining = it._it_end - it._chunk.it;
+            return (remaining + isize(it._size) - 1) / isize(it._size);
+        }
+
+        friend constexpr auto operator-(
+            const this_type& it, const _view_bounded_iterator_end& end) -> isize
+            requires _sized_iterator_pair_concept<base_iterator_type, base_iterator_end_type>
+        {
+            return -(end - it);
+        }
+
+    private:
+        value_type _chunk;
+        base_iterator_end_type _it_end;
+        usize _size;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom::ranges
+{
+    /// --------------------------------------------------------------------------------------------
+    /// value of `enumerate_view`, the index of a value with reference to it.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type>
+    class enumerate_entry
+    {
+    public:
+        using value_type = in_value_type;
+
+    public:
+        constexpr enumerate_entry()
+            : _index{ 0 }
+            , _value{ nullptr }
+        {}
+
+        constexpr enumerate_entry(usize index, const value_type& value)
+            : _index{ index }
+            , _value{ &value }
+        {}
+
+    public:
+        constexpr auto get_index() const -> usize
+        {
+            return _index;
+        }
+
+        constexpr auto get_value() const -> const value_type&
+        {
+            return *_value;
+        }
+
+    private:
+        usize _index;
+        const value_type* _value;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// value of `zip_view`, references to the values at the same position in both ranges.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_first_type, typename in_second_type>
+    class zip_entry
+    {
+    public:
+        using first_type = in_first_type;
+        using second_type = in_second_type;
+
+    public:
+        constexpr zip_entry()
+            : _first{ nullptr }
+            , _second{ nullptr }
+        {}
+
+        constexpr zip_entry(const first_type& first, const second_type& second)
+            : _first{ &first }
+            , _second{ &second }
+        {}
+
+    public:
+        constexpr auto get_first() const -> const first_type&
+        {
+            return *_first;
+        }
+
+        constexpr auto get_second() const -> const second_type&
+        {
+            return *_second;
+        }
+
+    private:
+        const first_type* _first;
+        const second_type* _second;
+    };
+}
+
+namespace atom::ranges
+{
+    /// --------------------------------------------------------------------------------------------
+    /// iterator for `enumerate_view`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_type, typename base_iterator_end_type>
+    class _enumerate_iterator
+    {
+        using this_type = _enumerate_iterator;
+        using base_value_type = typename iterator_definition<base_iterator_type>::value_type;
+        using end_type = _view_iterator_end<base_iterator_end_type>;
+
+    public:
+        using value_type = enumerate_entry<base_value_type>;
+        using difference_type = isize;
+        using iterator_category = _view_iterator_category<base_iterator_type>;
+
+    public:
+        constexpr _enumerate_iterator()
+            : _it{}
+            , _index{ 0 }
+            , _entry{}
+        {}
+
+        constexpr _enumerate_iterator(base_iterator_type it)
+            : _it{ move(it) }
+            , _index{ 0 }
+            , _entry{}
+        {}
+
+    public:
+        constexpr auto operator*() const -> const value_type&
+        {
+            _entry = value_type{ _index, *_it };
+            return _entry;
+        }
+
+        constexpr auto operator->() const -> const value_type*
+        {
+            return &**this;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            ++_it;
+            _index++;
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _it == that._it;
+        }
+
+        constexpr auto operator==(const end_type& end) const -> bool
+        {
+            return _it == end.it_end;
+        }
+
+        friend constexpr auto operator-(const end_type& end, const this_type& it) -> isize
+            requires _sized_iterator_pair_concept<base_iterator_type, base_iterator_end_type>
+        {
+            return end.it_end - it._it;
+        }
+
+        friend constexpr auto operator-(const this_type& it, const end_type& end) -> isize
+            requires _sized_iterator_pair_concept<base_iterator_type, base_iterator_end_type>
+        {
+            return it._it - end.it_end;
+        }
+
+    private:
+        base_iterator_type _it;
+        usize _index;
+        mutable value_type _entry;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// end of `zip_view`, reached when either range ends.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_end_type0, typename base_iterator_end_type1>
+    class _zip_iterator_end
+    {
+    public:
+        base_iterator_end_type0 it_end0;
+        base_iterator_end_type1 it_end1;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// iterator for `zip_view`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename base_iterator_type0, typename base_iterator_end_type0,
+        typename base_iterator_type1, typename base_iterator_end_type1>
+    class _zip_iterator
+    {
+        using this_type = _zip_iterator;
+        using end_type = _zip_iterator_end<base_iterator_end_type0, base_iterator_end_type1>;
+
+        static constexpr bool _is_sized =
+            _sized_iterator_pair_concept<base_iterator_type0, base_iterator_end_type0>
+            and _sized_iterator_pair_concept<base_iterator_type1, base_iterator_end_type1>;
+
+        static constexpr bool _is_forward = std::forward_iterator<base_iterator_type0>
+                                            and std::forward_iterator<base_iterator_type1>;
+
+    public:
+        using value_type =
+            zip_entry<typename iterator_definition<base_iterator_type0>::value_type,
+                typename iterator_definition<base_iterator_type1>::value_type>;
+        using difference_type = isize;
+        using iterator_category = std::conditional_t<_is_forward, std::forward_iterator_tag,
+            std::input_iterator_tag>;
+
+    public:
+        constexpr _zip_iterator()
+            : _it0{}
+            , _it1{}
+            , _entry{}
+        {}
+
+        constexpr _zip_iterator(base_iterator_type0 it0, base_iterator_type1 it1)
+            : _it0{ move(it0) }
+            , _it1{ move(it1) }
+            , _entry{}
+        {}
+
+    public:
+        constexpr auto operator*() const -> const value_type&
+        {
+            _entry = value_type{ *_it0, *_it1 };
+            return _entry;
+        }
+
+        constexpr auto operator->() const -> const value_type*
+        {
+            return &**this;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            ++_it0;
+            ++_it1;
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _it0 == that._it0;
+        }
+
+        constexpr auto operator==(const end_type& end) const -> bool
+        {
+            return _it0 == end.it_end0 or _it1 == end.it_end1;
+        }
+
+        friend constexpr auto operator-(const end_type& end, const this_type& it) -> isize
+            requires _is_sized
+        {
+            return std::min<isize>(end.it_end0 - it._it0, end.it_end1 - it._it1);
+        }
+
+        friend constexpr auto operator-(const this_type& it, const end_type& end) -> isize
+            requires _is_sized
+        {
+            return -(end - it);
+        }
+
+    private:
+        base_iterator_type0 _it0;
+        base_iterator_type1 _it1;
+        mutable value_type _entry;
+    };
+}
+
+namespace atom::ranges
+{
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of the results of a function invoked with each value of a range.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_range_type, typename in_function_type>
+    class map_view: public view_tag
+    {
+        using _base_iterator_type = _view_base_iterator_type<in_range_type>;
+        using _base_iterator_end_type = _view_base_iterator_end_type<in_range_type>;
+
+    public:
+        using range_type = in_range_type;
+        using function_type = in_function_type;
+        using const_iterator_type =
+            _map_iterator<_base_iterator_type, _base_iterator_end_type, function_type>;
+        using const_iterator_end_type = _view_iterator_end<_base_iterator_end_type>;
+        using value_type = typename const_iterator_type::value_type;
+
+    public:
+        constexpr map_view(const range_type& range, function_type fn)
+            : _base{ range }
+            , _fn{ move(fn) }
+        {}
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ &_fn, ranges::get_iterator(_base.get()) };
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{ ranges::get_iterator_end(_base.get()) };
+        }
+
+    private:
+        _view_base<range_type> _base;
+        function_type _fn;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of the values of a range accepted by a predicate.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_range_type, typename in_function_type>
+    class filter_view: public view_tag
+    {
+        using _base_iterator_type = _view_base_iterator_type<in_range_type>;
+        using _base_iterator_end_type = _view_base_iterator_end_type<in_range_type>;
+
+    public:
+        using range_type = in_range_type;
+        using function_type = in_function_type;
+        using value_type = _view_base_value_type<range_type>;
+        using const_iterator_type =
+            _filter_iterator<_base_iterator_type, _base_iterator_end_type, function_type>;
+        using const_iterator_end_type = _view_bounded_iterator_end;
+
+    public:
+        constexpr filter_view(const range_type& range, function_type pred)
+            : _base{ range }
+            , _pred{ move(pred) }
+        {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first value accepted by the predicate.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ &_pred, ranges::get_iterator(_base.get()),
+                ranges::get_iterator_end(_base.get()) };
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{};
+        }
+
+    private:
+        _view_base<range_type> _base;
+        function_type _pred;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of the first `count` values of a range.
+    ///
+    /// if the base can jump to its end, this iterates using the base iterators, so an array stays
+    /// an array.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_range_type>
+    class take_view: public view_tag
+    {
+        using _base_iterator_type = _view_base_iterator_type<in_range_type>;
+        using _base_iterator_end_type = _view_base_iterator_end_type<in_range_type>;
+
+        static constexpr bool _can_jump =
+            _jump_iterator_pair_concept<_base_iterator_type, _base_iterator_end_type>;
+
+    public:
+        using range_type = in_range_type;
+        using value_type = _view_base_value_type<range_type>;
+        using const_iterator_type = std::conditional_t<_can_jump, _base_iterator_type,
+            _take_iterator<_base_iterator_type, _base_iterator_end_type>>;
+        using const_iterator_end_type =
+            std::conditional_t<_can_jump, _base_iterator_type, _view_bounded_iterator_end>;
+
+    public:
+        constexpr take_view(const range_type& range, usize count)
+            : _base{ range }
+            , _count{ count }
+        {}
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            if constexpr (_can_jump)
+            {
+                return ranges::get_iterator(_base.get());
+            }
+            else
+            {
+                return const_iterator_type{ ranges::get_iterator(_base.get()),
+                    ranges::get_iterator_end(_base.get()), _count };
+            }
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            if constexpr (_can_jump)
+            {
+                _base_iterator_type it = ranges::get_iterator(_base.get());
+                _advance_bounded(it, _count, ranges::get_iterator_end(_base.get()));
+                return it;
+            }
+            else
+            {
+                return const_iterator_end_type{};
+            }
+        }
+
+    private:
+        _view_base<range_type> _base;
+        usize _count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of the values of a range after the first `count`.
+    ///
+    /// this iterates using the base iterators, so an array stays an array. if the base can't jump
+    /// `count` values, they are skipped each time `get_iterator()` is called.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_range_type>
+    class drop_view: public view_tag
+    {
+    public:
+        using range_type = in_range_type;
+        using value_type = _view_base_value_type<range_type>;
+        using const_iterator_type = _view_base_iterator_type<range_type>;
+        using const_iterator_end_type = _view_base_iterator_end_type<range_type>;
+
+    public:
+        constexpr drop_view(const range_type& range, usize count)
+            : _base{ range }
+            , _count{ count }
+        {}
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            const_iterator_type it = ranges::get_iterator(_base.get());
+            _advance_bounded(it, _count, ranges::get_iterator_end(_base.get()));
+            return it;
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return ranges::get_iterator_end(_base.get());
+        }
+
+    private:
+        _view_base<range_type> _base;
+        usize _count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of pairs of values at the same position in two ranges, as long as the shorter
+    /// one.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_range_type0, typename in_range_type1>
+    class zip_view: public view_tag
+    {
+        using _base_iterator_end_type0 = _view_base_iterator_end_type<in_range_type0>;
+        using _base_iterator_end_type1 = _view_base_iterator_end_type<in_range_type1>;
+
+    public:
+        using range_type0 = in_range_type0;
+        using range_type1 = in_range_type1;
+        using const_iterator_type = _zip_iterator<_view_base_iterator_type<range_type0>,
+            _base_iterator_end_type0, _view_base_iterator_type<range_type1>,
+            _base_iterator_end_type1>;
+        using const_iterator_end_type =
+            _zip_iterator_end<_base_iterator_end_type0, _base_iterator_end_type1>;
+        using value_type = typename const_iterator_type::value_type;
+
+    public:
+        constexpr zip_view(const range_type0& range0, const range_type1& range1)
+            : _base0{ range0 }
+            , _base1{ range1 }
+        {}
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ ranges::get_iterator(_base0.get()),
+                ranges::get_iterator(_base1.get()) };
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{ ranges::get_iterator_end(_base0.get()),
+                ranges::get_iterator_end(_base1.get()) };
+        }
+
+    private:
+        _view_base<range_type0> _base0;
+        _view_base<range_type1> _base1;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of the values of a range with their indices.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_range_type>
+    class enumerate_view: public view_tag
+    {
+        using _base_iterator_type = _view_base_iterator_type<in_range_type>;
+        using _base_iterator_end_type = _view_base_iterator_end_type<in_range_type>;
+
+    public:
+        using range_type = in_range_type;
+        using const_iterator_type =
+            _enumerate_iterator<_base_iterator_type, _base_iterator_end_type>;
+        using const_iterator_end_type = _view_iterator_end<_base_iterator_end_type>;
+        using value_type = typename const_iterator_type::value_type;
+
+    public:
+        constexpr enumerate_view(const range_type& range)
+            : _base{ range }
+        {}
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ ranges::get_iterator(_base.get()) };
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{ ranges::get_iterator_end(_base.get()) };
+        }
+
+    private:
+        _view_base<range_type> _base;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of consecutive ranges of `size` values of a range. the last chunk can be
+    /// smaller.
+    ///
+    /// each chunk is a range of the base iterators, so chunks of an array are arrays.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_range_type>
+    class chunk_view: public view_tag
+    {
+        using _base_iterator_type = _view_base_iterator_type<in_range_type>;
+        using _base_iterator_end_type = _view_base_iterator_end_type<in_range_type>;
+
+    public:
+        using range_type = in_range_type;
+        using const_iterator_type = _chunk_iterator<_base_iterator_type, _base_iterator_end_type>;
+        using const_iterator_end_type = _view_bounded_iterator_end;
+        using value_type = typename const_iterator_type::value_type;
+
+    public:
+        constexpr chunk_view(const range_type& range, usize size)
+            : _base{ range }
+            , _size{ size }
+        {
+            contract_debug_expects(size > 0, "chunk size is zero.");
+        }
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ ranges::get_iterator(_base.get()),
+                ranges::get_iterator_end(_base.get()), _size };
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{};
+        }
+
+    private:
+        _view_base<range_type> _base;
+        usize _size;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of every `step`th value of a range, starting from the first.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_range_type>
+    class stride_view: public view_tag
+    {
+        using _base_iterator_type = _view_base_iterator_type<in_range_type>;
+        using _base_iterator_end_type = _view_base_iterator_end_type<in_range_type>;
+
+    public:
+        using range_type = in_range_type;
+        using value_type = _view_base_value_type<range_type>;
+        using const_iterator_type = _stride_iterator<_base_iterator_type, _base_iterator_end_type>;
+        using const_iterator_end_type = _view_bounded_iterator_end;
+
+    public:
+        constexpr stride_view(const range_type& range, usize step)
+            : _base{ range }
+            , _step{ step }
+        {
+            contract_debug_expects(step > 0, "step is zero.");
+        }
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ ranges::get_iterator(_base.get()),
+                ranges::get_iterator_end(_base.get()), _step };
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{};
+        }
+
+    private:
+        _view_base<range_type> _base;
+        usize _step;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<view_tag>())
+    class range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+
+    public:
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// view functions and their closures, used to compose views using `operator|`.
+///
+/// views refer to the ranges they are created from, which must outlive them. views created from
+/// other views store them by value, so a whole pipeline can be kept in one variable.
+/// ------------------------------------------------------------------------------------------------
+namespace atom::ranges
+{
+    export template <typename function_type>
+    class map_closure
+    {
+    public:
+        template <typename range_type>
+        constexpr auto operator|(
+            const range_type& range) const -> map_view<range_type, function_type>
+            requires const_range_concept<range_type>
+        {
+            return map_view<range_type, function_type>{ range, fn };
+        }
+
+    public:
+        function_type fn;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazily invokes `fn` with each value of `range`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename function_type>
+    constexpr auto map(
+        const range_type& range, function_type fn) -> map_view<range_type, function_type>
+        requires const_range_concept<range_type>
+    {
+        return map_view<range_type, function_type>{ range, move(fn) };
+    }
+
+    /// \copydoc map
+    export template <typename function_type>
+    constexpr auto map(function_type fn) -> map_closure<function_type>
+    {
+        return map_closure<function_type>{ move(fn) };
+    }
+
+    export template <typename function_type>
+    class filter_closure
+    {
+    public:
+        template <typename range_type>
+        constexpr auto operator|(
+            const range_type& range) const -> filter_view<range_type, function_type>
+            requires const_range_concept<range_type>
+        {
+            return filter_view<range_type, function_type>{ range, pred };
+        }
+
+    public:
+        function_type pred;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazily skips values of `range` not accepted by `pred`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename function_type>
+    constexpr auto filter(
+        const range_type& range, function_type pred) -> filter_view<range_type, function_type>
+        requires const_range_concept<range_type>
+    {
+        return filter_view<range_type, function_type>{ range, move(pred) };
+    }
+
+    /// \copydoc filter
+    export template <typename function_type>
+    constexpr auto filter(function_type pred) -> filter_closure<function_type>
+    {
+        return filter_closure<function_type>{ move(pred) };
+    }
+
+    export class take_closure
+    {
+    public:
+        template <typename range_type>
+        constexpr auto operator|(const range_type& range) const -> take_view<range_type>
+            requires const_range_concept<range_type>
+        {
+            return take_view<range_type>{ range, count };
+        }
+
+    public:
+        usize count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazily takes the first `count` values of `range`, or all if it has less.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto take(const range_type& range, usize count) -> take_view<range_type>
+        requires const_range_concept<range_type>
+    {
+        return take_view<range_type>{ range, count };
+    }
+
+    /// \copydoc take
+    export constexpr auto take(usize count) -> take_closure
+    {
+        return take_closure{ count };
+    }
+
+    export class drop_closure
+    {
+    public:
+        template <typename range_type>
+        constexpr auto operator|(const range_type& range) const -> drop_view<range_type>
+            requires const_range_concept<range_type>
+        {
+            return drop_view<range_type>{ range, count };
+        }
+
+    public:
+        usize count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazily skips the first `count` values of `range`, or all if it has less.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto drop(const range_type& range, usize count) -> drop_view<range_type>
+        requires const_range_concept<range_type>
+    {
+        return drop_view<range_type>{ range, count };
+    }
+
+    /// \copydoc drop
+    export constexpr auto drop(usize count) -> drop_closure
+    {
+        return drop_closure{ count };
+    }
+
+    export template <typename range_type1>
+    class zip_closure
+    {
+    public:
+        template <typename range_type0>
+        constexpr auto operator|(
+            const range_type0& range0) const -> zip_view<range_type0, range_type1>
+            requires const_range_concept<range_type0>
+        {
+            return zip_view<range_type0, range_type1>{ range0, range1.get() };
+        }
+
+    public:
+        _view_base<range_type1> range1;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazily pairs the values of `range0` and `range1`, until either ends.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type0, typename range_type1>
+    constexpr auto zip(
+        const range_type0& range0, const range_type1& range1) -> zip_view<range_type0, range_type1>
+        requires const_range_concept<range_type0> and const_range_concept<range_type1>
+    {
+        return zip_view<range_type0, range_type1>{ range0, range1 };
+    }
+
+    /// \copydoc zip
+    export template <typename range_type1>
+    constexpr auto zip(const range_type1& range1) -> zip_closure<range_type1>
+        requires const_range_concept<range_type1>
+    {
+        return zip_closure<range_type1>{ range1 };
+    }
+
+    export class enumerate_closure
+    {
+    public:
+        template <typename range_type>
+        constexpr auto operator|(const range_type& range) const -> enumerate_view<range_type>
+            requires const_range_concept<range_type>
+        {
+            return enumerate_view<range_type>{ range };
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazily pairs the values of `range` with their indices.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto enumerate(const range_type& range) -> enumerate_view<range_type>
+        requires const_range_concept<range_type>
+    {
+        return enumerate_view<range_type>{ range };
+    }
+
+    /// \copydoc enumerate
+    export constexpr auto enumerate() -> enumerate_closure
+    {
+        return enumerate_closure{};
+    }
+
+    export class chunk_closure
+    {
+    public:
+        template <typename range_type>
+        constexpr auto operator|(const range_type& range) const -> chunk_view<range_type>
+            requires const_unidirectional_range_concept<range_type>
+        {
+            return chunk_view<range_type>{ range, size };
+        }
+
+    public:
+        usize size;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazily splits `range` into chunks of `size` values.
+    ///
+    /// \pre `size > 0`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto chunk(const range_type& range, usize size) -> chunk_view<range_type>
+        requires const_unidirectional_range_concept<range_type>
+    {
+        return chunk_view<range_type>{ range, size };
+    }
+
+    /// \copydoc chunk
+    export constexpr auto chunk(usize size) -> chunk_closure
+    {
+        return chunk_closure{ size };
+    }
+
+    export class stride_closure
+    {
+    public:
+        template <typename range_type>
+        constexpr auto operator|(const range_type& range) const -> stride_view<range_type>
+            requires const_range_concept<range_type>
+        {
+            return stride_view<range_type>{ range, step };
+        }
+
+    public:
+        usize step;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazily takes every `step`th value of `range`.
+    ///
+    /// \pre `step > 0`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto stride(const range_type& range, usize step) -> stride_view<range_type>
+        requires const_range_concept<range_type>
+    {
+        return stride_view<range_type>{ range, step };
+    }
+
+    /// \copydoc stride
+    export constexpr auto stride(usize step) -> stride_closure
+    {
+        return stride_closure{ step };
+    }
+}
@@ -7,6 +7,9 @@ export import :strings.string_formatter;
 export import :strings.string_formatting;
 export import :strings.string_slice;
 export import :strings.string_view;
+export import :strings.string_split;
+export import :strings.num_chars;
+export import :strings.symbol;
 export import :strings.string;
 export import :strings.format_string;
 export import :strings.static_string;
@@ -1,6 +1,7 @@
 export module atom_core:strings.format_string;
 
 import fmt;
+import :core;
 import :types;
 import :strings.format_arg_wrapper;
 import :strings.string_view;
@@ -21,9 +22,148 @@ namespace atom
         string_view str;
     };
 
+    /// --------------------------------------------------------------------------------------------
+    /// part of a format string, either literal text or a replacement field.
+    ///
+    /// for literals `[begin, begin + count)` is the text to write. for fields it's the format spec
+    /// after `:` including the closing `}`, ready to be parsed by the arg's formatter.
+    /// --------------------------------------------------------------------------------------------
+    class _format_segment
+    {
+    public:
+        static constexpr u8 literal_arg = 255;
+
+    public:
+        u16 begin;
+        u16 count;
+        u8 arg_index;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// replacement field layout of a format string, resolved at compile time so formatting doesn't
+    /// need to parse the format string again.
+    ///
+    /// if the format string cannot be described by the layout, like when it has too many fields
+    /// or a field uses dynamic width or precision, `is_compiled` is `false` and formatting falls
+    /// back to parsing the format string at runtime.
+    /// --------------------------------------------------------------------------------------------
+    class _format_layout
+    {
+    public:
+        static constexpr usize max_segments = 16;
+
+    public:
+        constexpr _format_layout()
+            : segments{}
+            , segment_count{ 0 }
+            , is_compiled{ false }
+        {}
+
+        static consteval auto parse(string_view str, usize arg_count) -> _format_layout
+        {
+            _format_layout layout;
+            const char* data = str.get_data();
+            const usize count = str.get_count();
+
+            if (count > nums::get_max<u16>() or arg_count >= _format_segment::literal_arg)
+                return layout;
+
+            usize literal_begin = 0;
+            usize next_arg_index = 0;
+            usize i = 0;
+            while (i < count)
+            {
+                if (data[i] != '{' and data[i] != '}')
+                {
+                    i++;
+                    continue;
+                }
+
+                // escaped `{{` or `}}`, keep the first one as part of the literal.
+                if (i + 1 < count and data[i + 1] == data[i])
+                {
+                    if (not layout._add_segment(literal_begin, i + 1 - literal_begin))
+                        return _format_layout();
+
+                    i += 2;
+                    literal_begin = i;
+                    continue;
+                }
+
+                if (data[i] == '}')
+                    return _format_layout();
+
+                if (not layout._add_segment(literal_begin, i - literal_begin))
+                    return _format_layout();
+
+                i++;
+
+                usize arg_index = next_arg_index++;
+                if (i < count and data[i] >= '0' and data[i] <= '9')
+                {
+                    arg_index = 0;
+                    while (i < count and data[i] >= '0' and data[i] <= '9')
+                    {
+                        arg_index = arg_index * 10 + (data[i] - '0');
+                        i++;
+                    }
+                }
+
+                if (i < count and data[i] == ':')
+                    i++;
+
+                usize spec_begin = i;
+                while (i < count and data[i] != '}')
+                {
+                    // nested fields for dynamic width or precision, or named args.
+                    if (data[i] == '{')
+                        return _format_layout();
+
+                    i++;
+                }
+
+                if (i == count or arg_index >= arg_count)
+                    return _format_layout();
+
+                i++;
+                if (not layout._add_segment(spec_begin, i - spec_begin, arg_index))
+                    return _format_layout();
+
+                literal_begin = i;
+            }
+
+            if (not layout._add_segment(literal_begin, count - literal_begin))
+                return _format_layout();
+
+            layout.is_compiled = true;
+            return layout;
+        }
+
+    private:
+        constexpr auto _add_segment(
+            usize begin, usize count, usize arg_index = _format_segment::literal_arg) -> bool
+        {
+            if (count == 0 and arg_index == _format_segment::literal_arg)
+                return true;
+
+            if (segment_count == max_segments)
+                return false;
+
+            segments[segment_count++] = _format_segment{
+                .begin = u16(begin), .count = u16(count), .arg_index = u8(arg_index)
+            };
+            return true;
+        }
+
+    public:
+        _format_segment segments[max_segments];
+        u8 segment_count;
+        bool is_compiled;
+    };
+
     /// --------------------------------------------------------------------------------------------
     /// string type used to store the format for formatting. this also checks at compile time for
-    /// invalid format or args.
+    /// invalid format or args, and resolves the layout of replacement fields.
     /// --------------------------------------------------------------------------------------------
     template <typename... arg_types>
     class _format_string
@@ -33,19 +173,24 @@ namespace atom
         consteval _format_string(const string_type& str)
             requires(type_info<string_view>::is_constructible_from<string_type>())
             : str{ str }
+            , layout{}
         {
             using fmt_format_string = fmt::format_string<
                 format_arg_wrapper<typename type_info<arg_types>::pure_type::value_type>...>;
 
             fmt_format_string check(str);
+
+            layout = _format_layout::parse(this->str, sizeof...(arg_types));
         }
 
         constexpr _format_string(runtime_format_string str)
             : str{ str.str }
+            , layout{}
         {}
 
     public:
         string_view str;
+        _format_layout layout;
     };
 
     export template <typename... arg_types>
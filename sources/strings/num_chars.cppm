@@ -0,0 +1,413 @@
+export module atom_core:strings.num_chars;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :ranges;
+import :strings.string_view;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// error returned when parsing a number from chars fails.
+    /// --------------------------------------------------------------------------------------------
+    export class parse_error: public error
+    {
+    public:
+        constexpr parse_error(string_view msg)
+            : error(msg)
+        {}
+
+        template <usize count>
+        constexpr parse_error(const char (&msg)[count])
+            : error(msg)
+        {}
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// integer types which can be converted to and from chars. `bool` and `char` are not numbers.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    concept _is_chars_int = std::is_integral_v<num_type> and not std::is_same_v<num_type, bool>
+                            and not std::is_same_v<num_type, char>;
+
+    template <typename num_type>
+    concept _is_chars_float = std::is_same_v<num_type, f32> or std::is_same_v<num_type, f64>;
+
+    template <typename num_type>
+    concept _is_chars_num = _is_chars_int<num_type> or _is_chars_float<num_type>;
+
+    /// --------------------------------------------------------------------------------------------
+    /// "00" to "99", so integers are written two digits at a time.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto _digit_pairs = [] {
+        std::array<char, 200> pairs{};
+        for (usize i = 0; i < 100; i++)
+        {
+            pairs[i * 2] = char('0' + i / 10);
+            pairs[i * 2 + 1] = char('0' + i % 10);
+        }
+
+        return pairs;
+    }();
+
+    constexpr u64 _pow10_table[] = { 1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull,
+        1000000ull, 10000000ull, 100000000ull, 1000000000ull, 10000000000ull, 100000000000ull,
+        1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull,
+        10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+        10000000000000000000ull };
+
+    /// --------------------------------------------------------------------------------------------
+    /// counts decimal digits of `num` without a loop. `bit_width * 1233 / 4096` approximates
+    /// `log10`, which is then corrected with one compare.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto _count_digits(u64 num) -> usize
+    {
+        // `| 1` gives `0` one digit and doesn't change the result for other numbers.
+        const u64 value = num | 1;
+        const usize approx = (usize(std::bit_width(value)) * 1233) >> 12;
+
+        return approx - usize(value < _pow10_table[approx]) + 1;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// writes digits of `num` into `out`, two at a time from the end.
+    ///
+    /// \returns count of chars written.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto _write_digits(u64 num, char* out) -> usize
+    {
+        const usize count = _count_digits(num);
+        char* it = out + count;
+
+        while (num >= 100)
+        {
+            const usize pair = usize(num % 100) * 2;
+            num /= 100;
+
+            it -= 2;
+            it[0] = _digit_pairs[pair];
+            it[1] = _digit_pairs[pair + 1];
+        }
+
+        if (num >= 10)
+        {
+            const usize pair = usize(num) * 2;
+            it[-2] = _digit_pairs[pair];
+            it[-1] = _digit_pairs[pair + 1];
+        }
+        else
+        {
+            it[-1] = char('0' + num);
+        }
+
+        return count;
+    }
+
+    template <typename num_type>
+    constexpr auto _write_int(num_type num, char* out) -> usize
+    {
+        if constexpr (std::is_signed_v<num_type>)
+        {
+            if (num < 0)
+            {
+                // negate in unsigned, so the min value doesn't overflow.
+                *out = '-';
+                return 1 + _write_digits(u64(0) - u64(num), out + 1);
+            }
+        }
+
+        return _write_digits(u64(num), out);
+    }
+
+    template <typename num_type>
+    auto _write_float(num_type num, char* out, usize count) -> usize
+    {
+        // shortest representation which parses back to the same value.
+        std::to_chars_result result = std::to_chars(out, out + count, num);
+        contract_asserts(result.ec == std::errc(), "out is too small.");
+
+        return usize(result.ptr - out);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// swar helpers, testing and converting 8 digits at once in a `u64`. only valid for little
+    /// endian loads.
+    /// --------------------------------------------------------------------------------------------
+    constexpr bool _can_parse_swar = std::endian::native == std::endian::little;
+
+    inline auto _load_eight_chars(const char* str) -> u64
+    {
+        u64 chunk;
+        std::memcpy(&chunk, str, 8);
+        return chunk;
+    }
+
+    constexpr auto _is_eight_digits(u64 chunk) -> bool
+    {
+        constexpr u64 high_nibbles = 0xF0F0F0F0F0F0F0F0;
+
+        // each byte is a digit if its high nibble is `3`, and still is `3` after adding `6`.
+        const u64 high = chunk & high_nibbles;
+        const u64 high_after_add = (chunk + 0x0606060606060606) & high_nibbles;
+
+        return (high | (high_after_add >> 4)) == 0x3333333333333333;
+    }
+
+    constexpr auto _parse_eight_digits(u64 chunk) -> u64
+    {
+        constexpr u64 mask = 0x000000FF000000FF;
+        constexpr u64 mul0 = 100 + (1000000ull << 32);
+        constexpr u64 mul1 = 1 + (10000ull << 32);
+
+        chunk -= 0x3030303030303030;
+        chunk = (chunk * 10) + (chunk >> 8);
+        return (((chunk & mask) * mul0) + (((chunk >> 16) & mask) * mul1)) >> 32;
+    }
+
+    template <typename num_type>
+    constexpr auto _parse_int(const char* it, const char* end) -> result<num_type, parse_error>
+    {
+        if (it == end)
+            return parse_error{ "string is empty." };
+
+        bool is_negative = false;
+        if constexpr (std::is_signed_v<num_type>)
+        {
+            if (*it == '-')
+            {
+                is_negative = true;
+                it++;
+            }
+        }
+
+        const char* digits_begin = it;
+
+        // leading zeros don't count towards the overflow check.
+        while (it != end and *it == '0')
+            it++;
+
+        const char* significant_begin = it;
+
+        // wraps on overflow, which is detected below using the count of digits.
+        u64 value = 0;
+
+        if not consteval
+        {
+            if constexpr (_can_parse_swar)
+            {
+                while (end - it >= 8)
+                {
+                    const u64 chunk = _load_eight_chars(it);
+                    if (not _is_eight_digits(chunk))
+                        break;
+
+                    value = value * 100000000 + _parse_eight_digits(chunk);
+                    it += 8;
+                }
+            }
+        }
+
+        while (it != end and u8(*it - '0') < 10)
+        {
+            value = value * 10 + u64(*it - '0');
+            it++;
+        }
+
+        if (it != end or it == digits_begin)
+            return parse_error{ "string has invalid chars." };
+
+        // `u64` holds any 19 digits, and 20 digits only if they start with `1` and didn't wrap.
+        const usize digit_count = usize(it - significant_begin);
+        if (digit_count > 20
+            or (digit_count == 20
+                and (*significant_begin > '1' or value < 10000000000000000000ull)))
+            return parse_error{ "value is out of range." };
+
+        constexpr u64 max = u64(std::numeric_limits<num_type>::max());
+
+        if (is_negative)
+        {
+            if (value > max + 1)
+                return parse_error{ "value is out of range." };
+
+            return num_type(u64(0) - value);
+        }
+
+        if (value > max)
+            return parse_error{ "value is out of range." };
+
+        return num_type(value);
+    }
+
+    template <typename num_type>
+    auto _parse_float(const char* it, const char* end) -> result<num_type, parse_error>
+    {
+        if (it == end)
+            return parse_error{ "string is empty." };
+
+        num_type value;
+        std::from_chars_result result = std::from_chars(it, end, value);
+
+        if (result.ec == std::errc::result_out_of_range)
+            return parse_error{ "value is out of range." };
+
+        if (result.ec != std::errc() or result.ptr != end)
+            return parse_error{ "string has invalid chars." };
+
+        return value;
+    }
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+export namespace atom::nums
+{
+    /// --------------------------------------------------------------------------------------------
+    /// \returns max count of chars `to_chars()` writes for `num_type`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    consteval auto get_max_chars() -> usize
+        requires _is_chars_num<num_type>
+    {
+        if constexpr (_is_chars_float<num_type>)
+        {
+            // "-1.17549435e-38" and "-2.2250738585072014e-308".
+            return std::is_same_v<num_type, f32> ? 15 : 24;
+        }
+        else
+        {
+            return std::numeric_limits<num_type>::digits10 + 1 + std::is_signed_v<num_type>;
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// writes `num` as decimal chars into `out`, without a null terminator. floats are written in
+    /// the shortest form that parses back to the same value.
+    ///
+    /// \returns count of chars written.
+    ///
+    /// \pre `out` has space for `get_max_chars<num_type>()` chars.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type, typename range_type>
+    constexpr auto to_chars(num_type num, range_type& out) -> usize
+        requires _is_chars_num<num_type> and ranges::array_range_concept<range_type, char>
+    {
+        contract_debug_expects(
+            ranges::get_count(out) >= get_max_chars<num_type>(), "out is too small.");
+
+        if constexpr (_is_chars_int<num_type>)
+        {
+            return _write_int(num, ranges::get_data(out));
+        }
+        else
+        {
+            return _write_float(num, ranges::get_data(out), ranges::get_count(out));
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// writes each number in `nums` at the end of `out`, separated by `separator`. chars are
+    /// written into a local chunk first and inserted into `out` in bulk.
+    /// --------------------------------------------------------------------------------------------
+    template <typename range_type, typename output_type>
+    auto to_chars(const range_type& nums, char separator, output_type& out) -> void
+        requires ranges::const_array_range_concept<range_type, ranges::value_type<range_type>>
+                 and _is_chars_num<ranges::value_type<range_type>>
+    {
+        using num_type = ranges::value_type<range_type>;
+
+        constexpr usize chunk_size = 512;
+        char chunk[chunk_size];
+        usize chunk_count = 0;
+
+        const num_type* data = ranges::get_data(nums);
+        const usize count = ranges::get_count(nums);
+
+        for (usize i = 0; i < count; i++)
+        {
+            if (chunk_size - chunk_count < get_max_chars<num_type>() + 1)
+            {
+                out.insert_range_last(ranges::from(chunk, chunk_count));
+                chunk_count = 0;
+            }
+
+            if (i != 0)
+                chunk[chunk_count++] = separator;
+
+            if constexpr (_is_chars_int<num_type>)
+            {
+                chunk_count += _write_int(data[i], chunk + chunk_count);
+            }
+            else
+            {
+                chunk_count += _write_float(data[i], chunk + chunk_count, chunk_size - chunk_count);
+            }
+        }
+
+        if (chunk_count != 0)
+            out.insert_range_last(ranges::from(chunk, chunk_count));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// parses all chars of `str` as a decimal `num_type`. integers accept a leading `-` only if
+    /// signed, floats accept the same format as `std::from_chars()`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto from_chars(string_view str) -> result<num_type, parse_error>
+        requires _is_chars_num<num_type>
+    {
+        const char* begin = str.get_data();
+        const char* end = begin + str.get_count();
+
+        if constexpr (_is_chars_int<num_type>)
+        {
+            return _parse_int<num_type>(begin, end);
+        }
+        else
+        {
+            return _parse_float<num_type>(begin, end);
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// parses each string of `strs` into the num at the same index in `out`. stops at the first
+    /// string which fails to parse.
+    ///
+    /// \pre `out` has the same count as `strs`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename strs_range_type, typename range_type>
+    constexpr auto from_chars(const strs_range_type& strs, range_type& out)
+        -> result<void, parse_error>
+        requires ranges::const_array_range_concept<strs_range_type, string_view>
+                 and ranges::array_range_concept<range_type, ranges::value_type<range_type>>
+                 and _is_chars_num<ranges::value_type<range_type>>
+    {
+        using num_type = ranges::value_type<range_type>;
+
+        const usize count = ranges::get_count(strs);
+        contract_debug_expects(ranges::get_count(out) == count, "out count doesn't match.");
+
+        const string_view* str_data = ranges::get_data(strs);
+        num_type* out_data = ranges::get_data(out);
+
+        for (usize i = 0; i < count; i++)
+        {
+            result<num_type, parse_error> parsed = from_chars<num_type>(str_data[i]);
+            if (parsed.is_error())
+                return parsed.template get_error<parse_error>();
+
+            out_data[i] = parsed.get_value();
+        }
+
+        return { create_from_void };
+    }
+}
@@ -9,6 +9,7 @@ import :strings.string_format_context;
 import :strings.string_formatter_provider;
 import :strings.string_format_error;
 import :strings.format_string;
+import :ranges;
 import :strings.string_view;
 import :strings.format_arg_wrapper;
 
@@ -28,60 +29,237 @@ namespace atom
         return fmt::runtime(std::string_view{ fmt.str });
     }
 
+    /// --------------------------------------------------------------------------------------------
+    /// fmt buffer writing directly into the reserved places of an array of chars, like `string`.
+    /// the array is grown in bulk when fmt runs out of space and its count is updated once at the
+    /// end, instead of inserting each char.
+    /// --------------------------------------------------------------------------------------------
     template <typename output_type>
-    constexpr auto _wrap_output_type_atom_to_fmt(output_type* out)
+    class _fmt_array_sink: public fmt::detail::buffer<char>
     {
-        class _wrapper
+        using base_type = fmt::detail::buffer<char>;
+
+    public:
+        _fmt_array_sink(output_type& out, usize size_hint)
+            : base_type{ &_grow }
+            , _out{ out }
         {
-        public:
-            using valueue_type = char;
-            using difference_type = std::ptrdiff_t;
-            using pointer = char*;
-            using reference = char&;
-            using iterator_category = std::output_iterator_tag;
-
-        public:
-            constexpr auto operator++() -> _wrapper&
-            {
-                return *this;
-            }
+            _out.reserve_more(size_hint);
+            this->set(_out.get_data(), _out.get_capacity());
+            this->try_resize(_out.get_count());
+        }
+
+    public:
+        auto flush() -> void
+        {
+            _out.commit_reserved(this->size() - _out.get_count());
+        }
+
+    private:
+        static auto _grow(base_type& buf, usize capacity) -> void
+        {
+            _fmt_array_sink& self = static_cast<_fmt_array_sink&>(buf);
+
+            // commit the written chars first, so they are moved if the array reallocates.
+            self.flush();
+            self._out.reserve(capacity);
+            self.set(self._out.get_data(), self._out.get_capacity());
+        }
+
+    private:
+        output_type& _out;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// fmt buffer writing directly into the spare capacity of a byte buffer, like `dynamic_buffer`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename output_type>
+    class _fmt_buffer_sink: public fmt::detail::buffer<char>
+    {
+        using base_type = fmt::detail::buffer<char>;
+
+    public:
+        _fmt_buffer_sink(output_type& out, usize size_hint)
+            : base_type{ &_grow }
+            , _out{ out }
+        {
+            _out.reserve(_out.get_size() + size_hint);
+            this->set(_get_out_data(_out), _out.get_capacity());
+            this->try_resize(_out.get_size());
+        }
+
+    public:
+        auto flush() -> void
+        {
+            _out.set_size(this->size());
+        }
+
+    private:
+        static auto _grow(base_type& buf, usize capacity) -> void
+        {
+            _fmt_buffer_sink& self = static_cast<_fmt_buffer_sink&>(buf);
+
+            self.flush();
+            self._out.reserve(capacity);
+            self.set(_get_out_data(self._out), self._out.get_capacity());
+        }
+
+        static auto _get_out_data(output_type& out) -> char*
+        {
+            return reinterpret_cast<char*>(out.get_data());
+        }
+
+    private:
+        output_type& _out;
+    };
 
-            constexpr auto operator++(int) -> _wrapper&
+    /// --------------------------------------------------------------------------------------------
+    /// fmt buffer collecting chars in a fixed chunk, which is written to the output when full. used
+    /// for outputs whose storage cannot be written directly, like `filesystem::file`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename output_type>
+    class _fmt_chunk_sink: public fmt::detail::buffer<char>
+    {
+        using base_type = fmt::detail::buffer<char>;
+
+        static constexpr usize _chunk_size = 512;
+
+    public:
+        _fmt_chunk_sink(output_type& out, usize size_hint)
+            : base_type{ &_grow, _chunk, 0, _chunk_size }
+            , _out{ out }
+        {}
+
+    public:
+        auto flush() -> void
+        {
+            if (this->size() == 0)
+                return;
+
+            if constexpr (requires(string_view str) { _out.write_str(str); })
             {
-                return *this;
+                _out.write_str(string_view{ ranges::from(_chunk, this->size()) });
             }
-
-            constexpr auto operator*() -> _wrapper&
+            else
             {
-                return *this;
+                _out.insert_range_last(ranges::from(_chunk, this->size()));
             }
 
-            constexpr auto operator=(char ch) -> _wrapper&
+            this->clear();
+        }
+
+    private:
+        static auto _grow(base_type& buf, usize capacity) -> void
+        {
+            _fmt_chunk_sink& self = static_cast<_fmt_chunk_sink&>(buf);
+
+            if (self.size() == _chunk_size)
+                self.flush();
+        }
+
+    private:
+        output_type& _out;
+        char _chunk[_chunk_size];
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// creates the fastest sink `out` supports.
+    /// --------------------------------------------------------------------------------------------
+    template <typename output_type>
+    auto _make_fmt_sink(output_type& out, usize size_hint)
+    {
+        if constexpr (requires { out.commit_reserved(usize()); })
+        {
+            return _fmt_array_sink<output_type>{ out, size_hint };
+        }
+        else if constexpr (requires {
+                               out.set_size(usize());
+                               out.reserve(usize());
+                           })
+        {
+            return _fmt_buffer_sink<output_type>{ out, size_hint };
+        }
+        else
+        {
+            return _fmt_chunk_sink<output_type>{ out, size_hint };
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// formats `arg` with the format spec `spec`, parsed by the arg's formatter.
+    /// --------------------------------------------------------------------------------------------
+    template <typename arg_type>
+    auto _format_arg_compiled(
+        fmt::detail::buffer<char>& sink, fmt::string_view spec, const arg_type& arg) -> void
+    {
+        format_arg_wrapper wrapper(arg);
+        fmt::formatter<decltype(wrapper)> formatter;
+
+        fmt::format_parse_context parse_ctx(spec);
+        parse_ctx.advance_to(formatter.parse(parse_ctx));
+
+        fmt::format_context ctx(fmt::appender(sink), fmt::format_args());
+        formatter.format(wrapper, ctx);
+    }
+
+    template <usize... indices, typename... arg_types>
+    auto _format_arg_compiled_at(fmt::detail::buffer<char>& sink, fmt::string_view spec,
+        usize index, std::index_sequence<indices...>, const arg_types&... args) -> void
+    {
+        ((indices == index ? _format_arg_compiled(sink, spec, args) : void()), ...);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// formats using the layout resolved at compile time, writing literals as they are and
+    /// handing each field directly to its formatter.
+    /// --------------------------------------------------------------------------------------------
+    template <typename... arg_types>
+    auto _format_compiled(fmt::detail::buffer<char>& sink, const _format_layout& layout,
+        const char* str, const arg_types&... args) -> void
+    {
+        for (usize i = 0; i < layout.segment_count; i++)
+        {
+            const _format_segment& segment = layout.segments[i];
+            const char* begin = str + segment.begin;
+
+            if (segment.arg_index == _format_segment::literal_arg)
             {
-                *out += char(ch);
-                return *this;
+                sink.append(begin, begin + segment.count);
+                continue;
             }
 
-        public:
-            type_info<output_type>::pure_type::value_type* out;
-        };
-
-        return _wrapper(out);
+            _format_arg_compiled_at(sink, fmt::string_view(begin, segment.count),
+                segment.arg_index, std::index_sequence_for<arg_types...>(), args...);
+        }
     }
 
     template <typename output_type, typename... arg_types>
     constexpr auto _format_to(
         output_type&& out, format_string<arg_types...> fmt, arg_types&&... args)
     {
+        // guess of the output size, so short outputs don't need to grow.
+        const usize size_hint = fmt.str.get_count() + sizeof...(arg_types) * 8;
+
+        auto sink = _make_fmt_sink(out, size_hint);
+
         try
         {
-            fmt::format_to(_wrap_output_type_atom_to_fmt(&out),
-                _convert_format_string_atom_to_fmt<arg_types...>(fmt),
-                format_arg_wrapper(atom::forward<arg_types>(args))...);
+            if (fmt.layout.is_compiled)
+            {
+                _format_compiled(sink, fmt.layout, fmt.str.get_data(), args...);
+            }
+            else
+            {
+                fmt::format_to(fmt::appender(sink),
+                    _convert_format_string_atom_to_fmt<arg_types...>(fmt),
+                    format_arg_wrapper(atom::forward<arg_types>(args))...);
+            }
         }
         catch (const fmt::format_error& err)
         {
             throw _fmt_error_to_string_format_error(err);
         }
+
+        sink.flush();
     }
 }
@@ -0,0 +1,497 @@
+export module atom_core:strings.string_split;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :ranges;
+import :strings.string_view;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// position and size of a delimiter found by a splitter.
+    /// --------------------------------------------------------------------------------------------
+    class _split_match
+    {
+    public:
+        usize index;
+        usize count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// splitters decide where `string_split_view` splits the string.
+    ///
+    /// `find(str)` returns the first delimiter in `str`, with `index` equal to `str.get_count()`
+    /// if there is none. `trim(slice)` adjusts each slice before it's returned. `skip_empty`
+    /// drops all empty slices and `skip_last_empty` drops the empty slice after a delimiter at
+    /// the end.
+    /// --------------------------------------------------------------------------------------------
+    class _split_by_char
+    {
+    public:
+        static constexpr bool skip_empty = false;
+        static constexpr bool skip_last_empty = false;
+
+    public:
+        auto find(string_view str) const -> _split_match
+        {
+            return { .index = usize(ranges::find(str, delim) - str.get_data()), .count = 1 };
+        }
+
+        auto trim(string_view slice) const -> string_view
+        {
+            return slice;
+        }
+
+    public:
+        char delim;
+    };
+
+    class _split_by_str
+    {
+    public:
+        static constexpr bool skip_empty = false;
+        static constexpr bool skip_last_empty = false;
+
+    public:
+        auto find(string_view str) const -> _split_match
+        {
+            return { .index = usize(ranges::find_range(str, delim) - str.get_data()),
+                .count = delim.get_count() };
+        }
+
+        auto trim(string_view slice) const -> string_view
+        {
+            return slice;
+        }
+
+    public:
+        string_view delim;
+    };
+
+    class _split_by_any
+    {
+    public:
+        static constexpr bool skip_empty = false;
+        static constexpr bool skip_last_empty = false;
+
+    public:
+        auto find(string_view str) const -> _split_match
+        {
+            return { .index = usize(ranges::find_any(str, set) - str.get_data()), .count = 1 };
+        }
+
+        auto trim(string_view slice) const -> string_view
+        {
+            return slice;
+        }
+
+    public:
+        string_view set;
+    };
+
+    class _split_by_line
+    {
+    public:
+        static constexpr bool skip_empty = false;
+        static constexpr bool skip_last_empty = true;
+
+    public:
+        auto find(string_view str) const -> _split_match
+        {
+            return { .index = usize(ranges::find(str, '\n') - str.get_data()), .count = 1 };
+        }
+
+        /// removes `\r` of `\r\n` line endings.
+        auto trim(string_view slice) const -> string_view
+        {
+            usize count = slice.get_count();
+            if (count != 0 and slice.get_data()[count - 1] == '\r')
+                return string_view{ ranges::from(slice.get_data(), count - 1) };
+
+            return slice;
+        }
+    };
+
+    template <typename function_type>
+    class _split_by_pred
+    {
+    public:
+        static constexpr bool skip_empty = true;
+        static constexpr bool skip_last_empty = true;
+
+    public:
+        auto find(string_view str) const -> _split_match
+        {
+            const char* data = str.get_data();
+            const usize count = str.get_count();
+
+            for (usize i = 0; i < count; i++)
+            {
+                if (pred(data[i]))
+                    return { .index = i, .count = 1 };
+            }
+
+            return { .index = count, .count = 0 };
+        }
+
+        auto trim(string_view slice) const -> string_view
+        {
+            return slice;
+        }
+
+    public:
+        function_type pred;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// end iterator for `string_split_view`.
+    /// --------------------------------------------------------------------------------------------
+    class _string_split_iterator_end
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// forward iterator over the slices of `string_split_view`, finding each delimiter only when
+    /// advanced to it.
+    /// --------------------------------------------------------------------------------------------
+    template <typename splitter_type>
+    class _string_split_iterator
+    {
+        using this_type = _string_split_iterator;
+
+    public:
+        using value_type = string_view;
+        using difference_type = isize;
+        using iterator_category = std::forward_iterator_tag;
+
+    public:
+        constexpr _string_split_iterator()
+            : _splitter{ nullptr }
+            , _current{}
+            , _next{ nullptr }
+            , _end{ nullptr }
+        {}
+
+        constexpr _string_split_iterator(const splitter_type* splitter, string_view str)
+            : _splitter{ splitter }
+            , _current{}
+            , _next{ str.get_data() }
+            , _end{ str.get_data() + str.get_count() }
+        {
+            // an empty string has no slices.
+            if (str.get_count() == 0)
+                _next = nullptr;
+
+            _advance();
+        }
+
+    public:
+        constexpr auto operator*() const -> const string_view&
+        {
+            return _current;
+        }
+
+        constexpr auto operator->() const -> const string_view*
+        {
+            return &_current;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _advance();
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            _advance();
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _current.get_data() == that._current.get_data() and _next == that._next
+                   and _splitter == that._splitter;
+        }
+
+        constexpr auto operator==(const _string_split_iterator_end& that) const -> bool
+        {
+            return _splitter == nullptr;
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// moves to the slice starting at `_next`, `_next` is `nullptr` after the last slice.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _advance() -> void
+        {
+            while (true)
+            {
+                if (_next == nullptr)
+                {
+                    _splitter = nullptr;
+                    _current = string_view{};
+                    return;
+                }
+
+                const char* begin = _next;
+                string_view rest{ ranges::from(begin, _end) };
+                _split_match match = _splitter->find(rest);
+
+                if (match.index == rest.get_count())
+                {
+                    _next = nullptr;
+                }
+                else
+                {
+                    _next = begin + match.index + match.count;
+
+                    if (splitter_type::skip_last_empty and _next == _end)
+                        _next = nullptr;
+                }
+
+                _current = _splitter->trim(string_view{ ranges::from(begin, match.index) });
+
+                if (not splitter_type::skip_empty or _current.get_count() != 0)
+                    return;
+            }
+        }
+
+    private:
+        const splitter_type* _splitter;
+        string_view _current;
+        const char* _next;
+        const char* _end;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export class string_split_view_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of the slices of a string, split by `splitter_type`. slices are `string_view`s
+    /// into the original string, nothing is allocated and each delimiter is found only when the
+    /// iteration reaches it.
+    ///
+    /// \note the string must outlive the view and its iterators.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_splitter_type>
+    class string_split_view: public string_split_view_tag
+    {
+    public:
+        using splitter_type = in_splitter_type;
+        using value_type = string_view;
+        using const_iterator_type = _string_split_iterator<splitter_type>;
+        using const_iterator_end_type = _string_split_iterator_end;
+
+    public:
+        constexpr string_split_view(string_view str, splitter_type splitter)
+            : _str{ str }
+            , _splitter{ move(splitter) }
+        {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first slice.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type{ &_splitter, _str };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the end.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type{};
+        }
+
+    private:
+        string_view _str;
+        splitter_type _splitter;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<string_split_view_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+
+    public:
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// closure used to create `string_split_view` using `operator|`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename splitter_type>
+    class string_split_closure
+    {
+    public:
+        template <typename range_type>
+        constexpr auto operator|(const range_type& range) const -> string_split_view<splitter_type>
+            requires ranges::const_array_range_concept<range_type, char>
+        {
+            return string_split_view<splitter_type>{ string_view{ range }, splitter };
+        }
+
+    public:
+        splitter_type splitter;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `range` at each `delim`. consecutive delimiters give empty slices.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto split(const range_type& range, char delim) -> string_split_view<_split_by_char>
+        requires ranges::const_array_range_concept<range_type, char>
+    {
+        return { string_view{ range }, _split_by_char{ delim } };
+    }
+
+    /// \copydoc split
+    export constexpr auto split(char delim) -> string_split_closure<_split_by_char>
+    {
+        return { _split_by_char{ delim } };
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `range` at each occurrence of `delim`.
+    ///
+    /// \pre `delim` is not empty.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto split(
+        const range_type& range, string_view delim) -> string_split_view<_split_by_str>
+        requires ranges::const_array_range_concept<range_type, char>
+    {
+        contract_debug_expects(delim.get_count() != 0, "delim is empty.");
+
+        return { string_view{ range }, _split_by_str{ delim } };
+    }
+
+    /// \copydoc split
+    export constexpr auto split(string_view delim) -> string_split_closure<_split_by_str>
+    {
+        contract_debug_expects(delim.get_count() != 0, "delim is empty.");
+
+        return { _split_by_str{ delim } };
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `range` at each occurrence of the string literal `delim`, without its null
+    /// terminator.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, usize count>
+    constexpr auto split(
+        const range_type& range, const char (&delim)[count]) -> string_split_view<_split_by_str>
+        requires ranges::const_array_range_concept<range_type, char>
+    {
+        return split(range, string_view{ ranges::from(delim, count - 1) });
+    }
+
+    /// \copydoc split
+    export template <usize count>
+    constexpr auto split(const char (&delim)[count]) -> string_split_closure<_split_by_str>
+    {
+        return split(string_view{ ranges::from(delim, count - 1) });
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `range` at each char which is in `set`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto split_any(
+        const range_type& range, string_view set) -> string_split_view<_split_by_any>
+        requires ranges::const_array_range_concept<range_type, char>
+    {
+        return { string_view{ range }, _split_by_any{ set } };
+    }
+
+    /// \copydoc split_any
+    export constexpr auto split_any(string_view set) -> string_split_closure<_split_by_any>
+    {
+        return { _split_by_any{ set } };
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `range` at each char which is in the string literal `set`, without its null
+    /// terminator.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, usize count>
+    constexpr auto split_any(
+        const range_type& range, const char (&set)[count]) -> string_split_view<_split_by_any>
+        requires ranges::const_array_range_concept<range_type, char>
+    {
+        return split_any(range, string_view{ ranges::from(set, count - 1) });
+    }
+
+    /// \copydoc split_any
+    export template <usize count>
+    constexpr auto split_any(const char (&set)[count]) -> string_split_closure<_split_by_any>
+    {
+        return split_any(string_view{ ranges::from(set, count - 1) });
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `range` into lines, ending with `\n` or `\r\n`. the line ending is not part of the
+    /// slices, and a line ending at the end doesn't give an empty line after it.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type>
+    constexpr auto lines(const range_type& range) -> string_split_view<_split_by_line>
+        requires ranges::const_array_range_concept<range_type, char>
+    {
+        return { string_view{ range }, _split_by_line{} };
+    }
+
+    /// \copydoc lines
+    export constexpr auto lines() -> string_split_closure<_split_by_line>
+    {
+        return { _split_by_line{} };
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `range` into tokens separated by chars for which `is_separator` returns `true`.
+    /// empty tokens are skipped.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename range_type, typename function_type>
+    constexpr auto tokenize(const range_type& range,
+        function_type is_separator) -> string_split_view<_split_by_pred<function_type>>
+        requires ranges::const_array_range_concept<range_type, char>
+                 and (type_info<function_type>::template is_function<bool(char)>())
+    {
+        return { string_view{ range }, _split_by_pred<function_type>{ move(is_separator) } };
+    }
+
+    /// \copydoc tokenize
+    export template <typename function_type>
+    constexpr auto tokenize(
+        function_type is_separator) -> string_split_closure<_split_by_pred<function_type>>
+        requires(type_info<function_type>::template is_function<bool(char)>())
+    {
+        return { _split_by_pred<function_type>{ move(is_separator) } };
+    }
+}
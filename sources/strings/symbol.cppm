@@ -0,0 +1,395 @@
+export module atom_core:strings.symbol;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :ranges;
+import :arena_allocator;
+import :mutex;
+import :lock_guard;
+import :hash.hasher;
+import :strings.string_view;
+
+/// ------------------------------------------------------------------------------------------------
+/// implementations
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// a unique string stored in a `symbol_table`, followed by its chars and a null terminator.
+    /// --------------------------------------------------------------------------------------------
+    class _symbol_entry
+    {
+    public:
+        auto get_data() const -> const char*
+        {
+            return reinterpret_cast<const char*>(this + 1);
+        }
+
+        auto is_eq(string_view str, u64 str_hash) const -> bool
+        {
+            return hash == str_hash and count == str.get_count()
+                   and std::memcmp(get_data(), str.get_data(), count) == 0;
+        }
+
+    public:
+        u64 hash;
+        usize count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// entry for the empty string, shared by all tables so that default constructed symbols
+    /// don't need a table.
+    /// --------------------------------------------------------------------------------------------
+    class _symbol_empty_entry
+    {
+    public:
+        _symbol_entry entry;
+        char data[1];
+    };
+
+    inline auto _get_symbol_empty_entry() -> const _symbol_entry*
+    {
+        static const _symbol_empty_entry empty = {
+            .entry = { .hash = hash::hash_bytes("", 0, hash::get_seed()), .count = 0 },
+            .data = { '\0' },
+        };
+
+        return &empty.entry;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// open addressing array of entries. once a slot is set it never changes, so readers can probe
+    /// without locking.
+    /// --------------------------------------------------------------------------------------------
+    class _symbol_slots
+    {
+    public:
+        auto get_slots() -> std::atomic<const _symbol_entry*>*
+        {
+            return reinterpret_cast<std::atomic<const _symbol_entry*>*>(this + 1);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns entry equal to `str`, or `nullptr` with `index` set to the empty slot where it
+        ///     should be inserted.
+        /// ----------------------------------------------------------------------------------------
+        auto find(string_view str, u64 hash, usize& index) -> const _symbol_entry*
+        {
+            std::atomic<const _symbol_entry*>* slots = get_slots();
+            const usize mask = capacity - 1;
+
+            for (index = usize(hash) & mask;; index = (index + 1) & mask)
+            {
+                const _symbol_entry* entry = slots[index].load(std::memory_order_acquire);
+                if (entry == nullptr or entry->is_eq(str, hash))
+                    return entry;
+            }
+        }
+
+    public:
+        usize capacity;
+
+        /// only accessed with the table locked.
+        usize count;
+    };
+}
+
+/// ------------------------------------------------------------------------------------------------
+/// apis
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export class symbol;
+
+    /// --------------------------------------------------------------------------------------------
+    /// interning table storing each unique string once, for `symbol`.
+    ///
+    /// lookups of strings already in the table don't lock, they only load the slots. inserting
+    /// locks the table, stores the string in an `arena` and publishes it into its slot. when the
+    /// slots grow, the old array is left in the arena, so readers still probing it stay valid.
+    ///
+    /// \note strings are never removed, symbols are valid until the table is destroyed.
+    /// --------------------------------------------------------------------------------------------
+    export class symbol_table
+    {
+        friend class symbol;
+        using this_type = symbol_table;
+
+    public:
+        static constexpr usize initial_capacity = 256;
+
+    public:
+        symbol_table()
+            : _arena{}
+            , _mutex{}
+            , _slots{ nullptr }
+        {
+            _slots.store(_create_slots(initial_capacity), std::memory_order_release);
+        }
+
+        symbol_table(const this_type&) = delete;
+        symbol_table& operator=(const this_type&) = delete;
+
+        ~symbol_table() = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns the table used by `symbol` when no table is given. it's never destroyed, so
+        ///     symbols can be used until the process exits.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_global() -> symbol_table&
+        {
+            static symbol_table* table = new symbol_table{};
+            return *table;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns symbol for `str`, inserting it if it's not in the table.
+        /// ----------------------------------------------------------------------------------------
+        auto intern(string_view str) -> symbol;
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of unique strings in the table.
+        /// ----------------------------------------------------------------------------------------
+        auto get_count() const -> usize
+        {
+            lock_guard guard{ _mutex };
+            return _slots.load(std::memory_order_relaxed)->count;
+        }
+
+    private:
+        auto _intern(string_view str) -> const _symbol_entry*
+        {
+            if (str.get_count() == 0)
+                return _get_symbol_empty_entry();
+
+            const u64 str_hash =
+                hash::hash_bytes(str.get_data(), str.get_count(), hash::get_seed());
+
+            usize index;
+            _symbol_slots* slots = _slots.load(std::memory_order_acquire);
+            if (const _symbol_entry* entry = slots->find(str, str_hash, index))
+                return entry;
+
+            lock_guard guard{ _mutex };
+
+            // check again, it may have been inserted or the slots may have grown since.
+            slots = _slots.load(std::memory_order_relaxed);
+            if (const _symbol_entry* entry = slots->find(str, str_hash, index))
+                return entry;
+
+            // keep the load factor under 1/2, so probes stay short.
+            if ((slots->count + 1) * 2 > slots->capacity)
+            {
+                slots = _grow_slots(slots);
+                slots->find(str, str_hash, index);
+            }
+
+            const _symbol_entry* entry = _create_entry(str, str_hash);
+            slots->count++;
+            slots->get_slots()[index].store(entry, std::memory_order_release);
+
+            return entry;
+        }
+
+        auto _create_entry(string_view str, u64 str_hash) -> const _symbol_entry*
+        {
+            const usize count = str.get_count();
+            void* mem = _arena.alloc(sizeof(_symbol_entry) + count + 1);
+
+            _symbol_entry* entry = std::construct_at(static_cast<_symbol_entry*>(mem),
+                _symbol_entry{ .hash = str_hash, .count = count });
+
+            char* data = reinterpret_cast<char*>(entry + 1);
+            std::memcpy(data, str.get_data(), count);
+            data[count] = '\0';
+
+            return entry;
+        }
+
+        auto _create_slots(usize capacity) -> _symbol_slots*
+        {
+            using atomic_entry = std::atomic<const _symbol_entry*>;
+
+            void* mem = _arena.alloc(sizeof(_symbol_slots) + sizeof(atomic_entry) * capacity);
+            _symbol_slots* slots = std::construct_at(static_cast<_symbol_slots*>(mem),
+                _symbol_slots{ .capacity = capacity, .count = 0 });
+
+            atomic_entry* entries = slots->get_slots();
+            for (usize i = 0; i < capacity; i++)
+                std::construct_at(entries + i, nullptr);
+
+            return slots;
+        }
+
+        auto _grow_slots(_symbol_slots* old_slots) -> _symbol_slots*
+        {
+            _symbol_slots* slots = _create_slots(old_slots->capacity * 2);
+            std::atomic<const _symbol_entry*>* old_entries = old_slots->get_slots();
+            std::atomic<const _symbol_entry*>* entries = slots->get_slots();
+            const usize mask = slots->capacity - 1;
+
+            for (usize i = 0; i < old_slots->capacity; i++)
+            {
+                const _symbol_entry* entry = old_entries[i].load(std::memory_order_relaxed);
+                if (entry == nullptr)
+                    continue;
+
+                usize index = usize(entry->hash) & mask;
+                while (entries[index].load(std::memory_order_relaxed) != nullptr)
+                    index = (index + 1) & mask;
+
+                entries[index].store(entry, std::memory_order_relaxed);
+            }
+
+            slots->count = old_slots->count;
+            _slots.store(slots, std::memory_order_release);
+            return slots;
+        }
+
+    private:
+        arena _arena;
+        mutable simple_mutex _mutex;
+        std::atomic<_symbol_slots*> _slots;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// interned string. equal strings interned in the same table give the same symbol, so
+    /// comparing symbols compares one pointer, and the hash is computed once when interning.
+    ///
+    /// the hash is the same as `hasher<string_view>` gives with the process seed, so maps keyed
+    /// by `symbol` can be queried with a `string_view`.
+    /// --------------------------------------------------------------------------------------------
+    export class symbol
+    {
+        friend class symbol_table;
+        using this_type = symbol;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// initializes with the empty string.
+        /// ----------------------------------------------------------------------------------------
+        symbol()
+            : _entry{ _get_symbol_empty_entry() }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// interns `str` into the global table.
+        /// ----------------------------------------------------------------------------------------
+        explicit symbol(string_view str)
+            : _entry{ symbol_table::get_global()._intern(str) }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// interns string `range` into the global table.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        explicit symbol(const range_type& range)
+            requires ranges::const_array_range_concept<range_type, char>
+            : symbol{ string_view{ range } }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// interns the string literal `str`, without its null terminator, into the global table.
+        /// ----------------------------------------------------------------------------------------
+        template <usize count>
+        explicit symbol(const char (&str)[count])
+            : symbol{ string_view{ ranges::from(str, count - 1) } }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// interns `str` into `table`.
+        /// ----------------------------------------------------------------------------------------
+        symbol(symbol_table& table, string_view str)
+            : _entry{ table._intern(str) }
+        {}
+
+        symbol(const this_type& that) = default;
+        symbol& operator=(const this_type& that) = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns view of the chars, which are also null terminated.
+        /// ----------------------------------------------------------------------------------------
+        auto get_view() const -> string_view
+        {
+            return string_view{ ranges::from(_entry->get_data(), _entry->count) };
+        }
+
+        operator string_view() const
+        {
+            return get_view();
+        }
+
+        auto get_data() const -> const char*
+        {
+            return _entry->get_data();
+        }
+
+        auto get_count() const -> usize
+        {
+            return _entry->count;
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _entry->count == 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns hash computed when interning, using the process seed.
+        /// ----------------------------------------------------------------------------------------
+        auto get_hash() const -> u64
+        {
+            return _entry->hash;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if both are the same string. only compares pointers, so symbols from
+        ///     different tables are never equal unless empty.
+        /// ----------------------------------------------------------------------------------------
+        auto operator==(const this_type& that) const -> bool
+        {
+            return _entry == that._entry;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if the chars are equal to `str`.
+        /// ----------------------------------------------------------------------------------------
+        auto operator==(string_view str) const -> bool
+        {
+            return _entry->count == str.get_count()
+                   and std::memcmp(_entry->get_data(), str.get_data(), _entry->count) == 0;
+        }
+
+    private:
+        explicit symbol(const _symbol_entry* entry)
+            : _entry{ entry }
+        {}
+
+    private:
+        const _symbol_entry* _entry;
+    };
+
+    inline auto symbol_table::intern(string_view str) -> symbol
+    {
+        return symbol{ _intern(str) };
+    }
+
+    export template <>
+    class hasher<symbol>
+    {
+    public:
+        static auto hash(const symbol& value, u64 seed) -> u64
+        {
+            if (seed == hash::get_seed())
+                return value.get_hash();
+
+            return hash::hash_bytes(value.get_data(), value.get_count(), seed);
+        }
+    };
+}
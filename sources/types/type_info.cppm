@@ -231,6 +231,11 @@ namespace atom
             return is_trivially_move_constructible() and is_trivially_move_assignable();
         }
 
+        static consteval auto is_trivially_relocatable() -> bool
+        {
+            return is_trivially_move_constructible() and is_trivially_destructible();
+        }
+
         static consteval auto is_destructible() -> bool
         {
             return std::is_destructible_v<value_type>;
@@ -8,7 +8,9 @@ export module fmt;
 
 export namespace fmt
 {
+    using fmt::appender;
     using fmt::format;
+    using fmt::format_args;
     using fmt::format_context;
     using fmt::format_error;
     using fmt::format_parse_context;
@@ -20,3 +22,8 @@ export namespace fmt
     using fmt::runtime;
     using fmt::string_view;
 }
+
+export namespace fmt::detail
+{
+    using fmt::detail::buffer;
+}
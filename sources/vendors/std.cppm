@@ -7,6 +7,9 @@ module;
 #include <cstdlib>
 #include <unistd.h>
 #include <array>
+#include <bit>
+#include <charconv>
+#include <system_error>
 #include <iterator>
 #include <bitset>
 #include <cstddef>
@@ -25,6 +28,8 @@ module;
 #include <string_view>
 #include <string>
 #include <concepts>
+#include <condition_variable>
+#include <coroutine>
 #include <cstdint>
 #include <cmath>
 #include <numeric>
@@ -38,6 +43,8 @@ module;
 #include <unordered_map>
 #include <exception>
 #include <filesystem>
+#include <thread>
+#include <utility>
 
 export module std;
 
@@ -66,9 +73,12 @@ export namespace std
     using std::int_fast64_t;
     using std::int_fast8_t;
     using std::intmax_t;
+    using std::max_align_t;
     using std::is_floating_point_v;
     using std::is_integral_v;
     using std::is_signed_v;
+    using std::is_unsigned_v;
+    using std::make_unsigned_t;
     using std::numeric_limits;
     using std::ptrdiff_t;
     using std::round;
@@ -82,6 +92,7 @@ export namespace std
     using std::uint_fast64_t;
     using std::uint_fast8_t;
     using std::uintmax_t;
+    using std::uintptr_t;
 
     using std::initializer_list;
     using std::nullptr_t;
@@ -111,6 +122,7 @@ export namespace std
     using std::equality_comparable_with;
     using std::false_type;
     using std::is_assignable_v;
+    using std::has_virtual_destructor_v;
     using std::is_base_of_v;
     using std::is_const_v;
     using std::is_constructible_v;
@@ -121,10 +133,15 @@ export namespace std
     using std::is_destructible_v;
     using std::is_empty_v;
     using std::is_enum_v;
+    using std::is_function_v;
+    using std::has_unique_object_representations_v;
     using std::is_invocable_r_v;
+    using std::is_nothrow_move_constructible_v;
     using std::is_lvalue_reference_v;
+    using std::is_polymorphic_v;
     using std::is_move_assignable_v;
     using std::is_move_constructible_v;
+    using std::is_pointer_v;
     using std::is_reference_v;
     using std::is_rvalue_reference_v;
     using std::is_same_v;
@@ -139,6 +156,10 @@ export namespace std
     using std::is_trivially_move_constructible_v;
     using std::is_void_v;
     using std::is_volatile_v;
+    using std::decay_t;
+    using std::invoke;
+    using std::invoke_r;
+    using std::invoke_result_t;
     using std::remove_const_t;
     using std::remove_cv_t;
     using std::remove_cvref_t;
@@ -147,6 +168,7 @@ export namespace std
     using std::remove_volatile_t;
     using std::true_type;
     using std::type_identity_t;
+    using std::underlying_type_t;
 
     using std::convertible_to;
     using std::copyable;
@@ -161,10 +183,16 @@ export namespace std
     using std::bitset;
     using std::get;
     using std::hash;
+    using std::random_device;
     using std::optional;
     using std::pair;
     using std::string;
+    using std::to_string;
+    using std::index_sequence;
+    using std::index_sequence_for;
+    using std::make_index_sequence;
     using std::string_view;
+    using std::apply;
     using std::tuple;
     using std::tuple_element;
     using std::tuple_size;
@@ -191,19 +219,50 @@ export namespace std
     using std::output_iterator_tag;
     using std::random_access_iterator;
     using std::random_access_iterator_tag;
+    using std::sized_sentinel_for;
 
+    using std::endian;
+
+    using std::chars_format;
+    using std::errc;
+    using std::from_chars;
+    using std::from_chars_result;
+    using std::to_chars;
+    using std::to_chars_result;
+
+    using std::bit_cast;
+    using std::bit_ceil;
+    using std::bit_width;
+    using std::countl_zero;
+    using std::countr_zero;
+    using std::has_single_bit;
+    using std::popcount;
+
+    using std::accumulate;
+    using std::adjacent_find;
     using std::construct_at;
     using std::copy;
     using std::copy_backward;
+    using std::count_if;
     using std::destroy;
     using std::destroy_at;
     using std::equal;
+    using std::exchange;
     using std::fill;
     using std::find;
+    using std::find_first_of;
     using std::find_if;
     using std::find_if_not;
     using std::forward;
+    using std::inplace_merge;
+    using std::is_sorted;
+    using std::less;
     using std::max;
+    using std::memchr;
+    using std::memcmp;
+    using std::memcpy;
+    using std::memmove;
+    using std::memset;
     using std::min;
     using std::move;
     using std::move_backward;
@@ -211,6 +270,7 @@ export namespace std
     using std::search;
     using std::shift_left;
     using std::shift_right;
+    using std::sort;
     using std::strlen;
 
     namespace ranges
@@ -233,13 +293,35 @@ export namespace std
         using ranges::contains;
     }
 
+    namespace this_thread
+    {
+        using this_thread::yield;
+    }
+
+    using std::aligned_alloc;
     using std::atomic;
+    using std::atomic_thread_fence;
+    using std::calloc;
+    using std::condition_variable;
+    using std::coroutine_handle;
+    using std::coroutine_traits;
+    using std::noop_coroutine;
+    using std::suspend_always;
+    using std::suspend_never;
     using std::free;
     using std::function;
     using std::malloc;
+    using std::memory_order;
+    using std::memory_order_acq_rel;
+    using std::memory_order_acquire;
+    using std::memory_order_relaxed;
+    using std::memory_order_release;
+    using std::memory_order_seq_cst;
     using std::mutex;
     using std::realloc;
+    using std::thread;
     using std::type_info;
+    using std::unique_lock;
     using std::declval;
 
     auto get_errno() -> int
@@ -253,12 +335,16 @@ export namespace std
     }
 
     using std::exception;
+    using std::exception_ptr;
+    using std::current_exception;
+    using std::rethrow_exception;
     using std::fclose;
     using std::fflush;
     using std::fopen;
     using std::freopen;
     using std::fseek;
     using std::ftell;
+    using std::remove;
     using std::source_location;
     using std::strerror;
     using std::terminate;
@@ -267,6 +353,7 @@ export namespace std
 
     namespace chrono
     {
+        using chrono::steady_clock;
         using chrono::system_clock;
     }
 
@@ -0,0 +1,183 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:buf_array;
+
+import atom_core;
+import :tracked_type;
+import :counting_allocator;
+
+using namespace atom;
+using namespace atom::tests;
+
+TEST_CASE("atom_core.buf_array")
+{
+    using array_type = buf_array<i32, 4, counting_allocator>;
+
+    counting_allocator::reset();
+
+    SECTION("default constructor")
+    {
+        array_type arr;
+
+        REQUIRE(arr.get_count() == 0);
+        REQUIRE(arr.get_capacity() == 0);
+        REQUIRE(counting_allocator::alloc_count == 0);
+    }
+
+    SECTION("values upto buf_size are stored inline")
+    {
+        array_type arr;
+        arr.emplace_last(0);
+        arr.emplace_last(1);
+        arr.emplace_last(2);
+        arr.emplace_last(3);
+
+        const byte* data = reinterpret_cast<const byte*>(arr.get_data());
+        const byte* begin = reinterpret_cast<const byte*>(&arr);
+        const byte* end = reinterpret_cast<const byte*>(&arr + 1);
+
+        REQUIRE(arr.get_count() == 4);
+        REQUIRE(arr.get_capacity() == 4);
+        REQUIRE((data >= begin and data < end));
+        REQUIRE(counting_allocator::alloc_count == 0);
+    }
+
+    SECTION("spills to allocator after buf_size")
+    {
+        {
+            array_type arr;
+            for (i32 i = 0; i < 5; i++)
+                arr.emplace_last(i);
+
+            REQUIRE(arr.get_count() == 5);
+            REQUIRE(arr.get_capacity() > 4);
+            REQUIRE(counting_allocator::alloc_count == 1);
+
+            for (i32 i = 0; i < 5; i++)
+                REQUIRE(arr.get_at(i) == i);
+        }
+
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+
+    SECTION("copy constructor")
+    {
+        array_type arr0;
+        arr0.emplace_last(0);
+        arr0.emplace_last(1);
+
+        array_type arr1(arr0);
+
+        REQUIRE(arr1.get_count() == 2);
+        REQUIRE(arr1.get_data() != arr0.get_data());
+        REQUIRE(arr1.get_at(0) == 0);
+        REQUIRE(arr1.get_at(1) == 1);
+        REQUIRE(counting_allocator::alloc_count == 0);
+    }
+
+    SECTION("move constructor, inline")
+    {
+        buf_array<tracked_type, 4, counting_allocator> arr0;
+        arr0.emplace_last();
+        arr0.emplace_last();
+
+        buf_array<tracked_type, 4, counting_allocator> arr1(move(arr0));
+
+        REQUIRE(arr0.get_count() == 0);
+        REQUIRE(arr1.get_count() == 2);
+        REQUIRE(arr1.get_at(0).last_op == tracked_type::operation::move_constructor);
+        REQUIRE(counting_allocator::alloc_count == 0);
+    }
+
+    SECTION("move constructor, allocated")
+    {
+        array_type arr0;
+        for (i32 i = 0; i < 8; i++)
+            arr0.emplace_last(i);
+
+        const i32* data = arr0.get_data();
+        array_type arr1(move(arr0));
+
+        REQUIRE(arr0.get_count() == 0);
+        REQUIRE(arr1.get_count() == 8);
+        REQUIRE(arr1.get_data() == data);
+        REQUIRE(counting_allocator::alloc_count == 1);
+    }
+
+    SECTION("move operator")
+    {
+        array_type arr0;
+        arr0.emplace_last(0);
+
+        array_type arr1;
+        for (i32 i = 0; i < 8; i++)
+            arr1.emplace_last(i);
+
+        arr1 = move(arr0);
+
+        REQUIRE(arr1.get_count() == 1);
+        REQUIRE(arr1.get_at(0) == 0);
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+
+    SECTION("insert and remove")
+    {
+        array_type arr;
+        arr.emplace_last(0);
+        arr.emplace_last(3);
+        arr.emplace_at(1, 1);
+        arr.emplace_at(2, 2);
+        arr.emplace_first(-1);
+
+        REQUIRE(arr.get_count() == 5);
+        for (i32 i = 0; i < 5; i++)
+            REQUIRE(arr.get_at(i) == i - 1);
+
+        arr.remove_at(0);
+        arr.remove_last();
+
+        REQUIRE(arr.get_count() == 3);
+        REQUIRE(arr.get_at(0) == 0);
+        REQUIRE(arr.get_at(2) == 2);
+    }
+}
+
+TEST_CASE("atom_core.buf_string")
+{
+    counting_allocator::reset();
+
+    SECTION("short strings don't allocate")
+    {
+        buf_string<40, counting_allocator> str(create_from_raw, "hello, world", 12);
+        str += '!';
+
+        buf_string<40, counting_allocator> str0(str);
+        buf_string<40, counting_allocator> str1(move(str0));
+
+        REQUIRE(str.get_count() == 13);
+        REQUIRE(str1.get_count() == 13);
+        REQUIRE(counting_allocator::alloc_count == 0);
+    }
+
+    SECTION("long strings allocate")
+    {
+        buf_string<40, counting_allocator> str;
+        for (usize i = 0; i < 41; i++)
+            str += 'a';
+
+        REQUIRE(str.get_count() == 41);
+        REQUIRE(counting_allocator::alloc_count == 1);
+    }
+
+    SECTION("string uses its inline buffer")
+    {
+        string str(create_from_raw, "hello");
+
+        const byte* data = reinterpret_cast<const byte*>(str.get_data());
+        const byte* begin = reinterpret_cast<const byte*>(&str);
+        const byte* end = reinterpret_cast<const byte*>(&str + 1);
+
+        REQUIRE((data >= begin and data < end));
+    }
+}
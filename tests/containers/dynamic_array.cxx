@@ -3,8 +3,10 @@ module;
 
 module atom_core.tests:dynamic_array;
 
+import std;
 import atom_core;
 import :tracked_type;
+import :counting_allocator;
 
 using namespace atom;
 using namespace atom::tests;
@@ -103,3 +105,151 @@ TEST_CASE("atom_core.dynamic_array")
 
 //     SECTION("range operator") {}
 }
+
+TEST_CASE("atom_core.dynamic_array.allocator")
+{
+    counting_allocator::reset();
+
+    SECTION("memory is allocated using allocator")
+    {
+        {
+            dynamic_array<i32, counting_allocator> arr;
+            arr.emplace_last(0);
+
+            REQUIRE(counting_allocator::alloc_count == 1);
+        }
+
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+
+    SECTION("trivially relocatable values grow using realloc")
+    {
+        dynamic_array<i32, counting_allocator> arr;
+        for (i32 i = 0; i < 100; i++)
+            arr.emplace_last(i);
+
+        REQUIRE(counting_allocator::alloc_count == 1);
+        REQUIRE(counting_allocator::realloc_count > 0);
+
+        for (i32 i = 0; i < 100; i++)
+            REQUIRE(arr.get_at(i) == i);
+    }
+
+    SECTION("other values grow by moving")
+    {
+        dynamic_array<tracked_type, counting_allocator> arr;
+        for (i32 i = 0; i < 10; i++)
+            arr.emplace_last();
+
+        REQUIRE(counting_allocator::realloc_count == 0);
+        REQUIRE(arr.get_at(0).last_op == tracked_type::operation::move_constructor);
+    }
+
+    SECTION("insert and remove")
+    {
+        dynamic_array<tracked_type, counting_allocator> arr;
+        for (i32 i = 0; i < 4; i++)
+            arr.emplace_last();
+
+        arr.emplace_at(2);
+        arr.remove_range(1, 3);
+
+        REQUIRE(arr.get_count() == 3);
+    }
+
+    SECTION("release_mem")
+    {
+        dynamic_array<i32, counting_allocator> arr;
+        arr.reserve(100);
+        arr.emplace_last(0);
+        arr.emplace_last(1);
+        arr.release_mem();
+
+        REQUIRE(arr.get_capacity() == 2);
+        REQUIRE(arr.get_at(1) == 1);
+
+        arr.remove_all();
+        arr.release_mem();
+
+        REQUIRE(arr.get_capacity() == 0);
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+
+    SECTION("buf_array moves values back inline on release_mem")
+    {
+        buf_array<i32, 4, counting_allocator> arr;
+        for (i32 i = 0; i < 8; i++)
+            arr.emplace_last(i);
+
+        arr.remove_last(6);
+        arr.release_mem();
+
+        REQUIRE(arr.get_capacity() == 4);
+        REQUIRE(arr.get_at(1) == 1);
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+}
+
+TEST_CASE("atom_core.dynamic_array.aliasing")
+{
+    // long strings, so they allocate and reading a freed or moved one is caught.
+    auto make_str = [](i32 i) { return std::string(32, 'a') + std::to_string(i); };
+
+    SECTION("emplace_many from a value of the array")
+    {
+        dynamic_array<std::string> arr;
+        arr.emplace_last(make_str(0));
+        arr.emplace_last(make_str(1));
+
+        for (i32 i = 0; i < 4; i++)
+        {
+            arr.emplace_many_last(3, arr.get_at(0));
+            arr.emplace_many_at(1, 3, arr.get_at(2));
+        }
+
+        REQUIRE(arr.get_count() == 26);
+        REQUIRE(arr.get_at(0) == make_str(0));
+        REQUIRE(arr.get_at(1) == make_str(0));
+        REQUIRE(arr.get_at(25) == make_str(0));
+
+        dynamic_array<i32> ints;
+        ints.emplace_last(7);
+        for (i32 i = 0; i < 10; i++)
+            ints.emplace_many_first(5, ints.get_at(0));
+
+        REQUIRE(ints.get_count() == 51);
+        for (usize i = 0; i < ints.get_count(); i++)
+            REQUIRE(ints.get_at(i) == 7);
+    }
+
+    SECTION("insert_range from the array")
+    {
+        dynamic_array<std::string> arr;
+        for (i32 i = 0; i < 3; i++)
+            arr.emplace_last(make_str(i));
+
+        arr.insert_range_last(arr);
+
+        REQUIRE(arr.get_count() == 6);
+        for (usize i = 0; i < 6; i++)
+            REQUIRE(arr.get_at(i) == make_str(i32(i % 3)));
+
+        // values after the insert position are moved, while being read.
+        arr.insert_range_at(1, arr);
+
+        REQUIRE(arr.get_count() == 12);
+        REQUIRE(arr.get_at(0) == make_str(0));
+        for (usize i = 0; i < 6; i++)
+            REQUIRE(arr.get_at(1 + i) == make_str(i32(i % 3)));
+
+        for (usize i = 1; i < 6; i++)
+            REQUIRE(arr.get_at(6 + i) == make_str(i32(i % 3)));
+
+        dynamic_array<i32> ints;
+        ints.emplace_last(0);
+        for (i32 i = 0; i < 10; i++)
+            ints.insert_range_last(ints);
+
+        REQUIRE(ints.get_count() == 1024);
+    }
+}
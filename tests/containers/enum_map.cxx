@@ -0,0 +1,210 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:enum_map;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    enum class color
+    {
+        red,
+        green,
+        blue,
+        cyan,
+        magenta,
+        yellow,
+        black,
+        white,
+    };
+
+    enum class access: u8
+    {
+        read = 1 << 0,
+        write = 1 << 1,
+        exec = 1 << 2,
+    };
+
+    template <usize count>
+    constexpr auto make_view(const char (&str)[count]) -> string_view
+    {
+        return string_view{ ranges::from(str, count - 1) };
+    }
+}
+
+template <>
+constexpr bool atom::enums::is_flags<access> = true;
+
+TEST_CASE("atom_core.enums.from_string")
+{
+    SECTION("names")
+    {
+        for (usize i = 0; i < enums::get_count<color>(); i++)
+        {
+            color value = enums::from_index_unchecked<color>(i);
+            auto result = enums::from_string<color>(enums::to_string_view(value));
+
+            REQUIRE(result.is_value());
+            REQUIRE(result.get() == value);
+        }
+    }
+
+    SECTION("not found")
+    {
+        REQUIRE(not enums::from_string<color>(make_view("")).is_value());
+        REQUIRE(not enums::from_string<color>(make_view("re")).is_value());
+        REQUIRE(not enums::from_string<color>(make_view("redd")).is_value());
+        REQUIRE(not enums::from_string<color>(make_view("Red")).is_value());
+        REQUIRE(not enums::from_string<color>(make_view("purple")).is_value());
+    }
+
+    SECTION("constexpr")
+    {
+        STATIC_REQUIRE(enums::from_string<color>(make_view("cyan")).get() == color::cyan);
+        STATIC_REQUIRE(not enums::from_string<color>(make_view("orange")).is_value());
+    }
+
+    SECTION("flags")
+    {
+        auto result = enums::from_string<access>(make_view("read|exec"));
+
+        REQUIRE(result.is_value());
+        REQUIRE(result.get() == (access::read | access::exec));
+        REQUIRE(not enums::from_string<access>(make_view("read|")).is_value());
+        REQUIRE(not enums::from_string<access>(make_view("read|delete")).is_value());
+    }
+}
+
+TEST_CASE("atom_core.enum_set")
+{
+    SECTION("insert, contains and remove")
+    {
+        enum_set<color> set;
+
+        REQUIRE(set.is_empty());
+
+        set.insert(color::red);
+        set.insert(color::white);
+        set.insert(color::red);
+
+        REQUIRE(set.get_count() == 2);
+        REQUIRE(set.contains(color::red));
+        REQUIRE(set.contains(color::white));
+        REQUIRE(not set.contains(color::blue));
+
+        set.remove(color::red);
+
+        REQUIRE(set.get_count() == 1);
+        REQUIRE(not set.contains(color::red));
+
+        set.remove_all();
+
+        REQUIRE(set.is_empty());
+    }
+
+    SECTION("iteration")
+    {
+        enum_set<color> set{ color::yellow, color::green, color::black };
+        std::vector<color> values;
+        for (auto it = set.get_iterator(); it != set.get_iterator_end(); it++)
+            values.push_back(*it);
+
+        REQUIRE(values == std::vector<color>{ color::green, color::yellow, color::black });
+    }
+
+    SECTION("flags")
+    {
+        enum_set<access> set{ access::read | access::write };
+
+        REQUIRE(set.get_count() == 2);
+        REQUIRE(set.contains(access::read));
+        REQUIRE(set.contains(access::read | access::write));
+        REQUIRE(not set.contains(access::exec));
+
+        set.insert(access::exec);
+        set.remove(access::read);
+
+        REQUIRE(set.to_flags() == (access::write | access::exec));
+    }
+}
+
+TEST_CASE("atom_core.enum_map")
+{
+    SECTION("default constructor")
+    {
+        enum_map<color, i32> map;
+
+        REQUIRE(map.is_empty());
+        REQUIRE(map.get_capacity() == enums::get_count<color>());
+        REQUIRE(map.get_iterator() == map.get_iterator_end());
+        REQUIRE(not map.contains(color::red));
+    }
+
+    SECTION("emplace, insert_or_assign and get_or_emplace")
+    {
+        enum_map<color, i32> map;
+
+        REQUIRE(map.emplace(color::red, 1));
+        REQUIRE(not map.emplace(color::red, 2));
+        REQUIRE(map.get_value(color::red) == 1);
+
+        REQUIRE(map.insert_or_assign(color::blue, 3));
+        REQUIRE(not map.insert_or_assign(color::blue, 4));
+        REQUIRE(map.get_value(color::blue) == 4);
+
+        map.get_or_emplace(color::white) += 5;
+        map.get_or_emplace(color::white) += 5;
+        REQUIRE(map.get_value(color::white) == 10);
+
+        REQUIRE(map.get_count() == 3);
+    }
+
+    SECTION("remove")
+    {
+        enum_map<color, std::string> map;
+        map.emplace(color::green, "green");
+        map.emplace(color::cyan, "cyan");
+
+        REQUIRE(map.remove(color::green));
+        REQUIRE(not map.remove(color::green));
+        REQUIRE(not map.contains(color::green));
+        REQUIRE(map.get_value(color::cyan) == "cyan");
+
+        map.remove_all();
+
+        REQUIRE(map.is_empty());
+    }
+
+    SECTION("copy and move")
+    {
+        enum_map<color, std::string> map;
+        map.emplace(color::magenta, "magenta");
+
+        enum_map<color, std::string> copy{ map };
+
+        REQUIRE(copy.get_value(color::magenta) == "magenta");
+
+        enum_map<color, std::string> moved{ move(map) };
+
+        REQUIRE(moved.get_value(color::magenta) == "magenta");
+        REQUIRE(map.is_empty());
+    }
+
+    SECTION("iteration")
+    {
+        enum_map<color, i32> map;
+        map.emplace(color::black, 6);
+        map.emplace(color::red, 0);
+
+        std::vector<std::pair<color, i32>> entries;
+        for (auto it = map.get_iterator(); it != map.get_iterator_end(); it++)
+            entries.push_back({ (*it).get_key(), (*it).get_value() });
+
+        REQUIRE(entries
+                == std::vector<std::pair<color, i32>>{ { color::red, 0 }, { color::black, 6 } });
+    }
+}
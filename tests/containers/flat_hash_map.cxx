@@ -0,0 +1,202 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:flat_hash_map;
+
+import atom_core;
+import :tracked_type;
+import :counting_allocator;
+
+using namespace atom;
+using namespace atom::tests;
+
+namespace
+{
+    /// --------------------------------------------------------------------------------------------
+    /// value which owns memory, and whose constructor throws if asked to.
+    /// --------------------------------------------------------------------------------------------
+    class throwing_value
+    {
+    public:
+        throwing_value(bool should_throw)
+            : values{ create_with_count, 10, 1 }
+        {
+            if (should_throw)
+                throw 0;
+        }
+
+    public:
+        dynamic_array<i32> values;
+    };
+}
+
+TEST_CASE("atom_core.flat_hash_map")
+{
+    SECTION("default constructor")
+    {
+        flat_hash_map<i32, i32> map;
+
+        REQUIRE(map.get_count() == 0);
+        REQUIRE(map.get_capacity() == 0);
+        REQUIRE(map.is_empty());
+        REQUIRE(map.get_iterator() == map.get_iterator_end());
+        REQUIRE(not map.contains(0));
+    }
+
+    SECTION("emplace and find")
+    {
+        flat_hash_map<i32, i32> map;
+        for (i32 i = 0; i < 1000; i++)
+            REQUIRE(map.emplace(i, i * 2));
+
+        REQUIRE(map.get_count() == 1000);
+        REQUIRE(not map.emplace(10, 0));
+        REQUIRE(map.get_value(10) == 20);
+
+        for (i32 i = 0; i < 1000; i++)
+        {
+            auto it = map.find(i);
+
+            REQUIRE(it != map.get_iterator_end());
+            REQUIRE(it->get_key() == i);
+            REQUIRE(it->get_value() == i * 2);
+        }
+
+        REQUIRE(map.find(1000) == map.get_iterator_end());
+    }
+
+    SECTION("insert_or_assign and get_or_emplace")
+    {
+        flat_hash_map<i32, i32> map;
+
+        REQUIRE(map.insert_or_assign(1, 1));
+        REQUIRE(not map.insert_or_assign(1, 2));
+        REQUIRE(map.get_value(1) == 2);
+
+        map.get_or_emplace(2) += 5;
+        map.get_or_emplace(2) += 5;
+        REQUIRE(map.get_value(2) == 10);
+    }
+
+    SECTION("remove")
+    {
+        flat_hash_map<i32, tracked_type> map;
+        for (i32 i = 0; i < 100; i++)
+            map.emplace(i);
+
+        for (i32 i = 0; i < 100; i += 2)
+            REQUIRE(map.remove(i));
+
+        REQUIRE(not map.remove(0));
+        REQUIRE(map.get_count() == 50);
+
+        for (i32 i = 0; i < 100; i++)
+            REQUIRE(map.contains(i) == (i % 2 == 1));
+
+        // reinserting into deleted slots.
+        for (i32 i = 0; i < 100; i += 2)
+            REQUIRE(map.emplace(i));
+
+        REQUIRE(map.get_count() == 100);
+    }
+
+    SECTION("iteration")
+    {
+        flat_hash_map<i32, i32> map;
+        for (i32 i = 0; i < 100; i++)
+            map.emplace(i, 1);
+
+        i32 sum = 0;
+        for (auto& entry : map)
+            sum += entry.get_value();
+
+        REQUIRE(sum == 100);
+
+        auto it = map.get_iterator();
+        while (it != map.get_iterator_end())
+            it = map.remove_at(it);
+
+        REQUIRE(map.is_empty());
+    }
+
+    SECTION("throwing constructor leaves the map unchanged")
+    {
+        flat_hash_map<i32, throwing_value> map;
+        for (i32 i = 0; i < 16; i++)
+            map.emplace(i, false);
+
+        REQUIRE_THROWS(map.emplace(100, true));
+        REQUIRE(map.get_count() == 16);
+        REQUIRE(not map.contains(100));
+
+        usize count = 0;
+        for (auto& entry : map)
+            count += entry.get_value().values.get_count() == 10;
+
+        REQUIRE(count == 16);
+        REQUIRE(map.emplace(100, false));
+        REQUIRE(map.get_count() == 17);
+    }
+
+    SECTION("heterogeneous lookup")
+    {
+        flat_hash_map<string, i32> map;
+        map.emplace(string(create_from_raw, "one"), 1);
+        map.emplace(string(create_from_raw, "two"), 2);
+
+        string key(create_from_raw, "two");
+        string_view view(key);
+
+        REQUIRE(map.contains(view));
+        REQUIRE(map.get_value(view) == 2);
+    }
+
+    SECTION("copy and move")
+    {
+        flat_hash_map<i32, i32> map0;
+        for (i32 i = 0; i < 100; i++)
+            map0.emplace(i, i);
+
+        flat_hash_map<i32, i32> map1(map0);
+        REQUIRE(map1.get_count() == 100);
+        REQUIRE(map1.get_value(50) == 50);
+
+        flat_hash_map<i32, i32> map2(move(map0));
+        REQUIRE(map0.get_count() == 0);
+        REQUIRE(map2.get_count() == 100);
+    }
+
+    SECTION("memory is allocated using allocator")
+    {
+        counting_allocator::reset();
+
+        {
+            flat_hash_map<i32, i32, flat_hash_default_hasher, flat_hash_default_key_eq,
+                counting_allocator>
+                map(create_with_capacity, 100);
+
+            for (i32 i = 0; i < 100; i++)
+                map.emplace(i, i);
+
+            REQUIRE(counting_allocator::alloc_count == 1);
+        }
+
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+}
+
+TEST_CASE("atom_core.flat_hash_set")
+{
+    flat_hash_set<i32> set;
+    for (i32 i = 0; i < 100; i++)
+        REQUIRE(set.insert(i));
+
+    REQUIRE(not set.insert(0));
+    REQUIRE(set.get_count() == 100);
+    REQUIRE(set.contains(99));
+    REQUIRE(not set.contains(100));
+
+    REQUIRE(set.remove(99));
+    REQUIRE(not set.contains(99));
+    REQUIRE(*set.find(98) == 98);
+}
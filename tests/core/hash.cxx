@@ -0,0 +1,124 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:hash;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    enum class color
+    {
+        red,
+        green,
+    };
+
+    auto make_view(const std::string& str) -> string_view
+    {
+        return string_view{ ranges::from(str.data(), str.size()) };
+    }
+}
+
+TEST_CASE("atom_core.hash")
+{
+    const u64 seed = 42;
+
+    SECTION("hash_bytes()")
+    {
+        // covers the short paths, the 16 byte loop and the 48 byte lanes.
+        std::string text(200, 'a');
+        std::unordered_map<u64, usize> hashes;
+
+        for (usize count = 0; count <= text.size(); count++)
+        {
+            const u64 hash = hash::hash_bytes(text.data(), count, seed);
+
+            REQUIRE(hash == hash::hash_bytes(text.data(), count, seed));
+            hashes[hash] = count;
+        }
+
+        REQUIRE(hashes.size() == text.size() + 1);
+        REQUIRE(hash::hash_bytes("abc", 3, seed) != hash::hash_bytes("abd", 3, seed));
+        REQUIRE(hash::hash_bytes("abc", 3, seed) != hash::hash_bytes("abc", 3, seed + 1));
+    }
+
+    SECTION("process seed")
+    {
+        REQUIRE(hash::get_seed() == hash::get_seed());
+        REQUIRE(hash::get_hash(i32(5)) == hash::get_hash(i32(5), hash::get_seed()));
+    }
+
+    SECTION("integers and enums")
+    {
+        REQUIRE(hash::get_hash(i32(1), seed) != hash::get_hash(i32(2), seed));
+        REQUIRE(hash::get_hash(i32(-1), seed) == hash::get_hash(i64(-1), seed));
+        REQUIRE(hash::get_hash(color::green, seed) == hash::get_hash(1, seed));
+        REQUIRE(hash::get_hash(0.0, seed) == hash::get_hash(-0.0, seed));
+    }
+
+    SECTION("hash_combine()")
+    {
+        const u64 first = hash::get_hash(1, seed);
+        const u64 second = hash::get_hash(2, seed);
+
+        REQUIRE(hash::hash_combine(first, second) != hash::hash_combine(second, first));
+    }
+
+    SECTION("strings")
+    {
+        std::string text = "hello world";
+        string str(create_from_raw, "hello world");
+
+        REQUIRE(hash::get_hash(str, seed) == hash::get_hash(make_view(text), seed));
+        REQUIRE(std::hash<string>()(str) == std::hash<string_view>()(make_view(text)));
+        REQUIRE(hash::get_hash(str, seed) != hash::get_hash(make_view("hello"), seed));
+    }
+
+    SECTION("dynamic_array")
+    {
+        dynamic_array<i32> arr0;
+        dynamic_array<i32> arr1;
+        for (i32 i = 0; i < 100; i++)
+        {
+            arr0.emplace_last(i);
+            arr1.emplace_last(i);
+        }
+
+        REQUIRE(hash::get_hash(arr0, seed) == hash::get_hash(arr1, seed));
+
+        arr1.emplace_last(0);
+        REQUIRE(hash::get_hash(arr0, seed) != hash::get_hash(arr1, seed));
+    }
+
+    SECTION("tuple, option, variant and result")
+    {
+        REQUIRE(hash::get_hash(tuple<i32, char>{ 1, 'a' }, seed)
+                == hash::get_hash(tuple<i32, char>{ 1, 'a' }, seed));
+        REQUIRE(hash::get_hash(tuple<i32, i32>{ 1, 2 }, seed)
+                != hash::get_hash(tuple<i32, i32>{ 2, 1 }, seed));
+
+        option<i32> none = { create_from_null };
+        option<i32> zero = i32(0);
+        REQUIRE(hash::get_hash(none, seed) != hash::get_hash(zero, seed));
+
+        variant<i32, u32> signed_one = i32(1);
+        variant<i32, u32> unsigned_one = u32(1);
+        REQUIRE(hash::get_hash(signed_one, seed) != hash::get_hash(unsigned_one, seed));
+
+        result<i32, color> value = i32(1);
+        result<i32, color> error = color::green;
+        REQUIRE(hash::get_hash(value, seed) != hash::get_hash(error, seed));
+    }
+
+    SECTION("hashable_concept")
+    {
+        STATIC_REQUIRE(hashable_concept<i32>);
+        STATIC_REQUIRE(hashable_concept<string>);
+        STATIC_REQUIRE(hashable_concept<option<string_view>>);
+        STATIC_REQUIRE(not hashable_concept<error>);
+        STATIC_REQUIRE(not hashable_concept<option<error>>);
+    }
+}
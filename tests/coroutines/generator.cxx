@@ -0,0 +1,104 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:generator;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto iota(i32 count) -> generator<i32>
+    {
+        for (i32 i = 0; i < count; i++)
+            co_yield i;
+    }
+
+    auto fibonacci() -> generator<u64>
+    {
+        u64 a = 0;
+        u64 b = 1;
+        while (true)
+        {
+            co_yield a;
+
+            b = std::exchange(a, b) + b;
+        }
+    }
+
+    auto split_words(const char* str) -> generator<std::string>
+    {
+        std::string word;
+        for (; *str != '\0'; str++)
+        {
+            if (*str != ' ')
+            {
+                word += *str;
+                continue;
+            }
+
+            if (not word.empty())
+                co_yield std::move(word);
+
+            word.clear();
+        }
+
+        if (not word.empty())
+            co_yield std::move(word);
+    }
+}
+
+TEST_CASE("atom_core.coroutines.generator")
+{
+    SECTION("iteration")
+    {
+        generator<i32> gen = iota(5);
+
+        std::vector<i32> values;
+        for (auto it = gen.get_iterator(); it != gen.get_iterator_end(); it++)
+            values.push_back(*it);
+
+        REQUIRE(values == std::vector<i32>{ 0, 1, 2, 3, 4 });
+
+        generator<i32> empty = iota(0);
+
+        REQUIRE(empty.get_iterator() == empty.get_iterator_end());
+    }
+
+    SECTION("lazy and infinite")
+    {
+        generator<u64> gen = fibonacci();
+
+        std::vector<u64> values;
+        for (auto it = gen.get_iterator(); values.size() < 10; it++)
+            values.push_back(*it);
+
+        REQUIRE(values == std::vector<u64>{ 0, 1, 1, 2, 3, 5, 8, 13, 21, 34 });
+    }
+
+    SECTION("moving values out")
+    {
+        generator<std::string> gen = split_words("  stream  values out ");
+
+        std::vector<std::string> words;
+        for (auto it = gen.get_iterator(); it != gen.get_iterator_end(); it++)
+            words.push_back(std::move(*it));
+
+        REQUIRE(words == std::vector<std::string>{ "stream", "values", "out" });
+    }
+
+    SECTION("views")
+    {
+        const generator<i32> gen = iota(10);
+        auto view = gen | ranges::filter([](i32 value) { return value % 3 == 0; })
+                    | ranges::map([](i32 value) { return value * 10; });
+
+        std::vector<i32> values;
+        for (auto it = ranges::get_iterator(view); it != ranges::get_iterator_end(view); it++)
+            values.push_back(*it);
+
+        REQUIRE(values == std::vector<i32>{ 0, 30, 60, 90 });
+    }
+}
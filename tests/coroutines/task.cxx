@@ -0,0 +1,169 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:task;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    class parse_error
+    {};
+
+    class range_error
+    {};
+
+    auto parse_digit(char ch) -> result<i32, parse_error>
+    {
+        if (ch < '0' or ch > '9')
+            return parse_error{};
+
+        return i32(ch - '0');
+    }
+
+    auto check_range(i32 value) -> result<void, range_error>
+    {
+        if (value > 5)
+            return range_error{};
+
+        return result<void, range_error>{ create_from_void };
+    }
+
+    using sum_result = result<i32, parse_error, range_error>;
+
+    auto parse_sum(const char* str, usize* step_count) -> task<sum_result>
+    {
+        i32 sum = 0;
+        for (; *str != '\0'; str++)
+        {
+            i32 digit = co_await parse_digit(*str);
+            co_await check_range(digit);
+
+            sum += digit;
+            (*step_count)++;
+        }
+
+        co_return sum;
+    }
+
+    auto find_even(const std::vector<i32>& values) -> option<i32>
+    {
+        for (i32 value : values)
+        {
+            if (value % 2 == 0)
+                return option<i32>{ value };
+        }
+
+        return option<i32>{};
+    }
+
+    auto half_of_even(std::vector<i32> values) -> task<option<i32>>
+    {
+        i32 even = co_await find_even(values);
+        co_return option<i32>{ even / 2 };
+    }
+
+    auto add(i32 a, i32 b) -> task<i32>
+    {
+        co_return a + b;
+    }
+
+    auto add_chain(i32 depth) -> task<i32>
+    {
+        if (depth == 0)
+            co_return 0;
+
+        // symmetric transfer keeps chains of tasks from growing the stack in optimized builds.
+        i32 rest = co_await add_chain(depth - 1);
+        co_return co_await add(rest, 1);
+    }
+}
+
+TEST_CASE("atom_core.coroutines.task")
+{
+    SECTION("lazy start")
+    {
+        bool is_started = false;
+        auto make = [&]() -> task<void> {
+            is_started = true;
+            co_return;
+        };
+
+        task<void> work = make();
+
+        REQUIRE(not is_started);
+        REQUIRE(not work.is_done());
+
+        sync_wait(move(work));
+
+        REQUIRE(is_started);
+    }
+
+    SECTION("awaiting tasks")
+    {
+        REQUIRE(sync_wait(add(2, 3)) == 5);
+        REQUIRE(sync_wait(add_chain(1000)) == 1000);
+    }
+
+    SECTION("awaiting results")
+    {
+        usize step_count = 0;
+        sum_result sum = sync_wait(parse_sum("1234", &step_count));
+
+        REQUIRE(sum.is_value());
+        REQUIRE(sum.get_value() == 10);
+        REQUIRE(step_count == 4);
+
+        // stops at the first error.
+        step_count = 0;
+        sum = sync_wait(parse_sum("12x4", &step_count));
+
+        REQUIRE(sum.is_error<parse_error>());
+        REQUIRE(step_count == 2);
+
+        step_count = 0;
+        sum = sync_wait(parse_sum("172", &step_count));
+
+        REQUIRE(sum.is_error<range_error>());
+        REQUIRE(step_count == 1);
+    }
+
+    SECTION("awaiting options")
+    {
+        option<i32> half = sync_wait(half_of_even({ 1, 3, 8 }));
+
+        REQUIRE(half.is_value());
+        REQUIRE(half.get() == 4);
+        REQUIRE(not sync_wait(half_of_even({ 1, 3, 5 })).is_value());
+    }
+
+    SECTION("schedule_on")
+    {
+        task_scheduler scheduler{ task_scheduler::options{ .worker_count = 2 } };
+
+        auto make = [&]() -> task<bool> {
+            co_await schedule_on(scheduler);
+            co_return scheduler.is_worker_thread();
+        };
+
+        REQUIRE(sync_wait(make()));
+    }
+
+    SECTION("arena frames")
+    {
+        arena frames;
+        usize used_size = 0;
+
+        {
+            arena_scope scope{ frames };
+            REQUIRE(sync_wait(add(1, 1)) == 2);
+
+            used_size = frames.get_used_size();
+        }
+
+        REQUIRE(used_size > 0);
+    }
+}
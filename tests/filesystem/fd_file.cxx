@@ -0,0 +1,145 @@
+module;
+#include "atom/core/preprocessors.h"
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:fd_file;
+
+import std;
+import atom_core;
+
+using namespace atom;
+using namespace atom::filesystem;
+
+#if defined(ATOM_PLATFORM_POSIX)
+
+namespace
+{
+    auto make_view(const char* str) -> string_view
+    {
+        return string_view{ ranges::from(str, std::strlen(str)) };
+    }
+
+    auto make_bytes(string_view str) -> memory_view
+    {
+        return memory_view{ str.get_data(), str.get_count() };
+    }
+}
+
+TEST_CASE("atom_core.filesystem.fd_file")
+{
+    const string_view path = make_view("atom_core_tests_fd_file.txt");
+
+    SECTION("write and read at")
+    {
+        const fd_file::open_flags flags = fd_file::open_flags::read
+                                          | fd_file::open_flags::write
+                                          | fd_file::open_flags::create;
+
+        fd_file::open_result result = fd_file::open(path, flags);
+
+        REQUIRE(result.is_value());
+
+        fd_file& file = result.get_value();
+
+        REQUIRE(file.write(make_bytes(make_view("hello world"))).is_value());
+        REQUIRE(file.write_at(0, make_bytes(make_view("HELLO"))).is_value());
+        REQUIRE(file.get_size().get_value() == 11);
+        REQUIRE(file.get_pos().get_value() == 11);
+
+        byte data[5];
+        REQUIRE(file.read_at(6, data, 5).get_value() == 5);
+        REQUIRE(std::memcmp(data, "world", 5) == 0);
+
+        memory_view parts[] = { make_bytes(make_view("ab")), make_bytes(make_view("cd")) };
+        REQUIRE(file.write_parts(parts).is_value());
+        REQUIRE(file.get_size().get_value() == 15);
+    }
+
+    SECTION("reader and writer")
+    {
+        {
+            fd_file::open_result result = fd_file::open(path, fd_file::open_flags::write);
+            REQUIRE(result.is_value());
+
+            byte buffer[16];
+            fd_writer writer{ result.get_value(), buffer };
+
+            for (i32 i = 0; i < 100; i++)
+                writer.write_line_fmt("line {}", i);
+
+            REQUIRE(writer.flush().is_value());
+        }
+
+        fd_file::open_result result = fd_file::open(path, fd_file::open_flags::read);
+        REQUIRE(result.is_value());
+
+        byte buffer[7];
+        fd_reader reader{ result.get_value(), buffer };
+
+        std::string content;
+        byte data[3];
+        while (true)
+        {
+            auto read = reader.read(data, 3);
+            REQUIRE(read.is_value());
+
+            if (read.get_value() == 0)
+                break;
+
+            content.append(reinterpret_cast<const char*>(data), read.get_value());
+        }
+
+        std::string expected;
+        for (i32 i = 0; i < 100; i++)
+        {
+            expected += "line ";
+            expected += std::to_string(i);
+            expected += '\n';
+        }
+
+        REQUIRE(content == expected);
+    }
+
+    SECTION("long formatted lines")
+    {
+        const std::string prefix(900, 'a');
+        const std::string line(600, 'b');
+
+        {
+            fd_file::open_result result = fd_file::open(path, fd_file::open_flags::write);
+            REQUIRE(result.is_value());
+
+            byte buffer[1024];
+            fd_writer writer{ result.get_value(), buffer };
+
+            writer.write_str(make_view(prefix.c_str()));
+            writer.write_line_fmt("{}", make_view(line.c_str()));
+
+            // the end of the line is kept in the buffer, to be written with its new line.
+            REQUIRE(writer.get_buffered_count() == line.size() + 1);
+            REQUIRE(writer.flush().is_value());
+        }
+
+        fd_file::open_result result = fd_file::open(path, fd_file::open_flags::read);
+        REQUIRE(result.is_value());
+
+        std::string content(prefix.size() + line.size() + 1, '\0');
+        byte* data = reinterpret_cast<byte*>(content.data());
+        auto read = result.get_value().read(data, content.size());
+
+        REQUIRE(read.get_value() == content.size());
+        REQUIRE(content == prefix + line + '\n');
+    }
+
+    SECTION("invalid flags")
+    {
+        fd_file::open_result result =
+            fd_file::open(path, fd_file::open_flags::read | fd_file::open_flags::create);
+
+        REQUIRE(result.is_error<invalid_options_error>());
+    }
+
+    std::remove("atom_core_tests_fd_file.txt");
+}
+
+#endif
@@ -0,0 +1,99 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:file_range;
+
+import std;
+import atom_core;
+
+using namespace atom;
+using namespace atom::filesystem;
+
+namespace
+{
+    auto make_view(const char* str) -> string_view
+    {
+        return string_view{ ranges::from(str, std::strlen(str)) };
+    }
+
+    auto open_file(string_view path) -> file
+    {
+        file::open_result result = file::open(path, file::open_flags::read);
+        REQUIRE(result.is_value());
+
+        return result.get_value();
+    }
+
+    template <typename range_type>
+    auto collect(range_type&& range) -> std::vector<std::string>
+    {
+        std::vector<std::string> items;
+        for (auto it = range.get_iterator(); it != range.get_iterator_end(); ++it)
+            items.push_back(std::string{ std::string_view{ *it } });
+
+        return items;
+    }
+}
+
+TEST_CASE("atom_core.filesystem.file_range")
+{
+    const string_view path = make_view("atom_core_tests_file_range.txt");
+    const string_view content = make_view("first\n\na much longer third line\nlast");
+
+    REQUIRE(write_file_str(path, content).is_value());
+
+    SECTION("as_lines")
+    {
+        file file = open_file(path);
+
+        REQUIRE(collect(file.as_lines())
+                == std::vector<std::string>{ "first", "", "a much longer third line", "last" });
+
+        file.close();
+    }
+
+    SECTION("small blocks")
+    {
+        file file = open_file(path);
+
+        // records longer than the block grow the buffer.
+        REQUIRE(collect(file_record_range{ file, '\n', 4 })
+                == std::vector<std::string>{ "first", "", "a much longer third line", "last" });
+
+        file.close();
+    }
+
+    SECTION("as_records")
+    {
+        file file = open_file(path);
+
+        const std::vector<std::string> expected = {
+            "first\n\na", "much", "longer", "third", "line\nlast"
+        };
+
+        REQUIRE(collect(file.as_records(' ')) == expected);
+
+        file.close();
+    }
+
+    SECTION("as_range")
+    {
+        file file = open_file(path);
+
+        std::string read;
+        usize chunk_count = 0;
+        auto range = file.as_range(8);
+        for (auto it = range.get_iterator(); it != range.get_iterator_end(); ++it)
+        {
+            read.append(reinterpret_cast<const char*>(it->get_data()), it->get_count());
+            chunk_count++;
+        }
+
+        REQUIRE(read == std::string_view{ content });
+        REQUIRE(chunk_count == (content.get_count() + 7) / 8);
+
+        file.close();
+    }
+
+    std::remove("atom_core_tests_file_range.txt");
+}
@@ -0,0 +1,101 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <cerrno>
+
+module atom_core.tests:mapped_file;
+
+import std;
+import atom_core;
+
+using namespace atom;
+using namespace atom::filesystem;
+
+namespace
+{
+    auto make_view(const char* str) -> string_view
+    {
+        return string_view{ ranges::from(str, std::strlen(str)) };
+    }
+}
+
+TEST_CASE("atom_core.filesystem.mapped_file")
+{
+    const string_view path = make_view("atom_core_tests_mapped_file.txt");
+    const string_view content = make_view("first line\nsecond line\n");
+
+    REQUIRE(write_file_str(path, content).is_value());
+
+    SECTION("open")
+    {
+        mapped_file::open_result result = mapped_file::open(path);
+
+        REQUIRE(result.is_value());
+
+        mapped_file& mapped = result.get_value();
+
+        REQUIRE(mapped.is_mapped());
+        REQUIRE(mapped.get_size() == content.get_count());
+        REQUIRE(std::string_view{ mapped.get_str() } == std::string_view{ content });
+
+        mapped.advise(mapped_file::access_hint::sequential);
+        mapped.close();
+
+        REQUIRE(mapped.is_closed());
+    }
+
+    SECTION("read_write")
+    {
+        {
+            mapped_file::open_result result =
+                mapped_file::open(path, mapped_file::access::read_write);
+
+            REQUIRE(result.is_value());
+
+            mapped_file& mapped = result.get_value();
+            mapped.get_mut_data()[0] = byte('F');
+
+            REQUIRE(mapped.flush().is_value());
+        }
+
+        auto read = read_file_str(path);
+
+        REQUIRE(read.is_value());
+        REQUIRE(std::string_view{ string_view{ read.get_value() } }.starts_with("First line"));
+    }
+
+    SECTION("file::map")
+    {
+        file::open_result file_result = file::open(path, file::open_flags::read);
+
+        REQUIRE(file_result.is_value());
+
+        file& file = file_result.get_value();
+        auto result = file.map();
+        file.close();
+
+        REQUIRE(result.is_value());
+        REQUIRE(std::string_view{ result.get_value().get_str() } == std::string_view{ content });
+    }
+
+    SECTION("file::map write only")
+    {
+        file::open_result file_result = file::open(path, file::open_flags::write);
+
+        REQUIRE(file_result.is_value());
+
+        auto result = file_result.get_value().map();
+
+        REQUIRE(result.is_error());
+        REQUIRE(result.get_error<filesystem_error>().error_no == EACCES);
+    }
+
+    SECTION("no entry")
+    {
+        mapped_file::open_result result =
+            mapped_file::open(make_view("atom_core_tests_mapped_file_missing.txt"));
+
+        REQUIRE(result.is_error<noentry_error>());
+    }
+
+    std::remove("atom_core_tests_mapped_file.txt");
+}
@@ -0,0 +1,44 @@
+export module atom_core.tests:counting_allocator;
+
+import atom_core;
+
+namespace atom::tests
+{
+    /// --------------------------------------------------------------------------------------------
+    /// allocator used to count calls made to `default_mem_allocator`.
+    /// --------------------------------------------------------------------------------------------
+    export class counting_allocator
+    {
+    public:
+        auto alloc(usize size) -> void*
+        {
+            alloc_count++;
+            return default_mem_allocator().alloc(size);
+        }
+
+        auto realloc(void* mem, usize size) -> void*
+        {
+            realloc_count++;
+            return default_mem_allocator().realloc(mem, size);
+        }
+
+        auto dealloc(void* mem) -> void
+        {
+            dealloc_count++;
+            default_mem_allocator().dealloc(mem);
+        }
+
+    public:
+        static auto reset() -> void
+        {
+            alloc_count = 0;
+            realloc_count = 0;
+            dealloc_count = 0;
+        }
+
+    public:
+        static inline usize alloc_count = 0;
+        static inline usize realloc_count = 0;
+        static inline usize dealloc_count = 0;
+    };
+}
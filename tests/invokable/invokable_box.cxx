@@ -72,6 +72,120 @@ TEST_CASE("atom_core.function_box")
         REQUIRE(capture_lambda_function() != 0);
         REQUIRE(capture_lambda_function() == captured_value);
     }
+
+    SECTION("small and big functions")
+    {
+        i64 big_capture[16] = { 1 };
+        function_box<i64()> small_function = [value = 1] { return value; };
+        function_box<i64()> big_function = [big_capture] { return big_capture[0]; };
+
+        REQUIRE(small_function() == 1);
+        REQUIRE(big_function() == 1);
+
+        function_box<i64()> big_copy = big_function;
+        function_box<i64()> big_moved = move(big_function);
+
+        REQUIRE(big_copy() == 1);
+        REQUIRE(big_moved() == 1);
+        REQUIRE(big_function == nullptr);
+    }
+
+    SECTION("copy and move")
+    {
+        function_box<i32()> function0 = [] { return 1; };
+        function_box<i32()> function1 = function0;
+
+        REQUIRE(function0() == 1);
+        REQUIRE(function1() == 1);
+
+        function_box<i32()> function2 = move(function0);
+
+        REQUIRE(function0 == nullptr);
+        REQUIRE(function2() == 1);
+
+        function2 = [] { return 2; };
+        function1 = function2;
+
+        REQUIRE(function1() == 2);
+    }
+
+    SECTION("function pointer")
+    {
+        function_box<i32(i32)> function = +[](i32 value) { return value * 2; };
+
+        REQUIRE(function(2) == 4);
+        REQUIRE(function.get_type() == typeid(i32 (*)(i32)));
+    }
+
+    SECTION("try_invoke()")
+    {
+        function_box<i32()> function;
+        i32 result = 0;
+
+        REQUIRE(not function.try_invoke(&result));
+
+        function = [] { return 1; };
+
+        REQUIRE(function.try_invoke(&result));
+        REQUIRE(result == 1);
+    }
+}
+
+TEST_CASE("atom_core.unique_function")
+{
+    SECTION("move only function")
+    {
+        unique_ptr<i32> ptr = make_unique<i32>(10);
+        unique_function<i32()> function0 = [ptr = move(ptr)] { return *ptr.to_unwrapped(); };
+
+        REQUIRE(function0() == 10);
+
+        unique_function<i32()> function1 = move(function0);
+
+        REQUIRE(function0 == nullptr);
+        REQUIRE(function1() == 10);
+    }
+
+    SECTION("destroy()")
+    {
+        unique_function<void()> function = [] {};
+
+        REQUIRE(function.has());
+
+        function.destroy();
+
+        REQUIRE(not function.has());
+    }
+}
+
+TEST_CASE("atom_core.function_ref")
+{
+    SECTION("lambda")
+    {
+        i32 count = 0;
+        auto lambda = [&](i32 value) { count += value; };
+        function_ref<void(i32)> function = lambda;
+
+        function(1);
+        function(2);
+
+        REQUIRE(count == 3);
+    }
+
+    SECTION("function pointer")
+    {
+        function_ref<i32(i32)> function = +[](i32 value) { return value * 2; };
+
+        REQUIRE(function(2) == 4);
+    }
+
+    SECTION("as parameter")
+    {
+        auto sum = [](function_ref<i32(i32)> function)
+        { return function(1) + function(2); };
+
+        REQUIRE(sum([](i32 value) { return value; }) == 3);
+    }
 }
 
 TEST_CASE("atom_core.function_box", "[benchmarks]")
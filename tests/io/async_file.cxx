@@ -0,0 +1,146 @@
+module;
+#include "atom/core/preprocessors.h"
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:async_file;
+
+import std;
+import atom_core;
+
+using namespace atom;
+using namespace atom::io;
+
+#if defined(ATOM_PLATFORM_POSIX)
+
+namespace
+{
+    auto make_view(const char* str) -> string_view
+    {
+        return string_view{ ranges::from(str, std::strlen(str)) };
+    }
+
+    auto test_engine(async_engine& engine) -> void
+    {
+        const string_view path = make_view("atom_core_tests_async_file.txt");
+        const async_file::open_flags flags = async_file::open_flags::read
+                                             | async_file::open_flags::write
+                                             | async_file::open_flags::create;
+
+        async_file::open_result result = async_file::open(engine, path, flags);
+
+        REQUIRE(result.is_value());
+
+        async_file& file = result.get_value();
+
+        // writes blocks of different bytes in one batch.
+        static constexpr usize block_count = 16;
+        static constexpr usize block_size = 4096;
+
+        std::vector<byte> out(block_count * block_size);
+        for (usize i = 0; i < out.size(); i++)
+            out[i] = byte(i / block_size);
+
+        usize written = 0;
+        for (usize i = 0; i < block_count; i++)
+        {
+            memory_view bytes{ out.data() + i * block_size, block_size };
+            file.write_at(i * block_size, bytes, [&](async_result result) {
+                REQUIRE(result.is_value());
+                written += result.get_value();
+            });
+        }
+
+        REQUIRE(engine.get_pending_count() == block_count);
+        REQUIRE(engine.wait_all() == block_count);
+        REQUIRE(written == out.size());
+
+        // reads them back in reverse order.
+        std::vector<byte> in(out.size());
+        usize read = 0;
+        for (usize i = block_count; i > 0; i--)
+        {
+            file.read_at((i - 1) * block_size, in.data() + (i - 1) * block_size, block_size,
+                [&](async_result result) {
+                    REQUIRE(result.is_value());
+                    read += result.get_value();
+                });
+        }
+
+        engine.submit();
+
+        while (engine.get_pending_count() > 0)
+            engine.wait();
+
+        REQUIRE(read == in.size());
+        REQUIRE(in == out);
+
+        // reading past the end reads nothing.
+        bool is_invoked = false;
+        file.read_at(out.size(), in.data(), block_size, [&](async_result result) {
+            REQUIRE(result.is_value());
+            REQUIRE(result.get_value() == 0);
+            is_invoked = true;
+        });
+
+        REQUIRE(engine.wait() == 1);
+        REQUIRE(is_invoked);
+
+        file.close();
+        std::remove("atom_core_tests_async_file.txt");
+    }
+}
+
+TEST_CASE("atom_core.io.async_file")
+{
+    SECTION("default backend")
+    {
+        async_engine engine;
+        test_engine(engine);
+    }
+
+    SECTION("thread pool")
+    {
+        async_engine engine{ async_engine::options{ .force_thread_pool = true } };
+
+        REQUIRE(engine.get_backend() == async_engine::backend::thread_pool);
+
+        test_engine(engine);
+    }
+
+    SECTION("errors")
+    {
+        async_engine engine;
+
+        async_file::open_result missing = async_file::open(
+            engine, make_view("atom_core_tests_async_file_missing.txt"),
+            async_file::open_flags::read);
+
+        REQUIRE(missing.is_error<filesystem::noentry_error>());
+
+        // writing to a file open for reading only fails when performed.
+        const string_view path = make_view("atom_core_tests_async_file.txt");
+        REQUIRE(filesystem::write_file_str(path, make_view("content")).is_value());
+
+        async_file::open_result result =
+            async_file::open(engine, path, async_file::open_flags::read);
+
+        REQUIRE(result.is_value());
+
+        async_file& file = result.get_value();
+        const string_view str = make_view("data");
+
+        bool is_error = false;
+        file.write_at(0, memory_view{ str.get_data(), str.get_count() }, [&](async_result result) {
+            is_error = result.is_error<filesystem::filesystem_error>();
+        });
+
+        engine.wait_all();
+
+        REQUIRE(is_error);
+
+        file.close();
+        std::remove("atom_core_tests_async_file.txt");
+    }
+}
+
+#endif
@@ -0,0 +1,165 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:arena_allocator;
+
+import atom_core;
+import :tracked_type;
+
+using namespace atom;
+using namespace atom::tests;
+
+TEST_CASE("atom_core.arena_allocator")
+{
+    SECTION("alloc")
+    {
+        arena arena;
+
+        void* mem0 = arena.alloc(3);
+        void* mem1 = arena.alloc(7);
+
+        REQUIRE(mem0 != mem1);
+        REQUIRE(reinterpret_cast<usize>(mem0) % alignof(std::max_align_t) == 0);
+        REQUIRE(reinterpret_cast<usize>(mem1) % alignof(std::max_align_t) == 0);
+    }
+
+    SECTION("alloc bigger than block")
+    {
+        arena arena{ create_with_size, 64 };
+
+        byte* mem = static_cast<byte*>(arena.alloc(1000));
+        mem[999] = 1;
+
+        REQUIRE(arena.get_used_size() >= 1000);
+    }
+
+    SECTION("realloc last allocation grows in place")
+    {
+        arena arena;
+
+        void* mem0 = arena.alloc(16);
+        void* mem1 = arena.realloc(mem0, 256);
+
+        REQUIRE(mem1 == mem0);
+    }
+
+    SECTION("realloc older allocation copies")
+    {
+        arena arena;
+
+        i32* mem0 = static_cast<i32*>(arena.alloc(sizeof(i32) * 2));
+        mem0[0] = 10;
+        mem0[1] = 20;
+
+        arena.alloc(8);
+
+        i32* mem1 = static_cast<i32*>(arena.realloc(mem0, sizeof(i32) * 4));
+
+        REQUIRE(mem1 != mem0);
+        REQUIRE(mem1[0] == 10);
+        REQUIRE(mem1[1] == 20);
+    }
+
+    SECTION("reset reuses memory")
+    {
+        arena arena{ create_with_size, 128 };
+
+        void* mem0 = arena.alloc(16);
+        for (usize i = 0; i < 32; i++)
+            arena.alloc(16);
+
+        arena.reset();
+
+        REQUIRE(arena.get_used_size() == 0);
+        REQUIRE(arena.alloc(16) == mem0);
+    }
+
+    SECTION("dynamic_array")
+    {
+        arena arena;
+        usize used_size = arena.get_used_size();
+
+        {
+            dynamic_array<i32, arena_allocator> arr{ create_with_allocator, arena };
+            for (i32 i = 0; i < 100; i++)
+                arr.emplace_last(i);
+
+            dynamic_array<i32, arena_allocator> copy = arr;
+
+            REQUIRE(copy.get_count() == 100);
+            REQUIRE(copy.get_allocator().get_arena() == &arena);
+            REQUIRE(copy.get_at(99) == 99);
+        }
+
+        REQUIRE(arena.get_used_size() > used_size);
+    }
+
+    SECTION("arena_scope")
+    {
+        arena arena;
+
+        REQUIRE(arena_scope::get_current() == nullptr);
+
+        {
+            arena_scope scope{ arena };
+
+            REQUIRE(arena_scope::get_current() == &arena);
+
+            buf_string<4, arena_allocator> str{ create_from_raw, "hello arena", 11 };
+
+            REQUIRE(str.get_allocator().get_arena() == &arena);
+            REQUIRE(arena.get_used_size() > 0);
+        }
+
+        REQUIRE(arena_scope::get_current() == nullptr);
+    }
+
+    SECTION("box")
+    {
+        arena arena;
+        arena_scope scope{ arena };
+
+        {
+            // no buffer, so the value is always allocated using the allocator.
+            box<tracked_type, 0, arena_allocator> val;
+            val.emplace<tracked_type>();
+
+            REQUIRE(val.has_val());
+            REQUIRE(val.get().last_op == tracked_type::operation::default_constructor);
+            REQUIRE(arena.get_used_size() >= sizeof(tracked_type));
+        }
+
+        // dealloc does nothing, the memory is reclaimed with the arena.
+        REQUIRE(arena.get_used_size() >= sizeof(tracked_type));
+    }
+
+    SECTION("shared_ptr")
+    {
+        arena arena;
+        tracked_type::operation last_op;
+
+        {
+            shared_ptr<tracked_type> ptr =
+                make_shared_with_alloc<tracked_type>(arena_allocator{ arena });
+
+            REQUIRE(ptr.get_count() == 1);
+            REQUIRE(arena.get_used_size() > 0);
+
+            last_op = ptr.to_unwrapped()->last_op;
+        }
+
+        REQUIRE(last_op == tracked_type::operation::default_constructor);
+    }
+
+    SECTION("dynamic_buffer")
+    {
+        arena arena;
+
+        basic_dynamic_buffer<arena_allocator> buf{ create_with_allocator, arena };
+        buf.resize(100);
+
+        REQUIRE(buf.get_size() == 100);
+        REQUIRE(buf.get_capacity() == 100);
+        REQUIRE(arena.get_used_size() >= 100);
+    }
+}
@@ -0,0 +1,148 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:intrusive_ptr;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    class counted_type: public intrusive_ref_counted<>
+    {
+    public:
+        counted_type(bool* destroyed = nullptr)
+            : destroyed{ destroyed }
+        {}
+
+        ~counted_type()
+        {
+            if (destroyed != nullptr)
+                *destroyed = true;
+        }
+
+    public:
+        bool* destroyed;
+    };
+
+    class base_type: public intrusive_ref_counted<>
+    {
+    public:
+        virtual ~base_type() = default;
+
+    public:
+        i32 base_value = 0;
+    };
+
+    class other_base_type
+    {
+    public:
+        virtual ~other_base_type() = default;
+
+    public:
+        i32 other_value = 0;
+    };
+
+    /// derives from another base first, so `base_type` isn't at the start of the value.
+    class derived_type
+        : public other_base_type
+        , public base_type
+    {
+    public:
+        derived_type(bool* destroyed)
+            : destroyed{ destroyed }
+        {}
+
+        ~derived_type() override
+        {
+            *destroyed = true;
+        }
+
+    public:
+        bool* destroyed;
+    };
+
+    static_assert(sizeof(intrusive_ptr<counted_type>) == sizeof(counted_type*),
+        "the default destroyer doesn't take space.");
+}
+
+TEST_CASE("atom_core.intrusive_ptr")
+{
+    SECTION("default constructor")
+    {
+        intrusive_ptr<counted_type> ptr;
+
+        REQUIRE(ptr.to_unwrapped() == nullptr);
+        REQUIRE(ptr.get_count() == 0);
+    }
+
+    SECTION("make_intrusive()")
+    {
+        intrusive_ptr<counted_type> ptr = make_intrusive<counted_type>();
+
+        REQUIRE(ptr.to_unwrapped() != nullptr);
+        REQUIRE(ptr.get_count() == 1);
+    }
+
+    SECTION("copy and move")
+    {
+        intrusive_ptr<counted_type> ptr0 = make_intrusive<counted_type>();
+        intrusive_ptr<counted_type> ptr1 = ptr0;
+
+        REQUIRE(ptr0.get_count() == 2);
+
+        intrusive_ptr<counted_type> ptr2 = move(ptr1);
+
+        REQUIRE(ptr1.to_unwrapped() == nullptr);
+        REQUIRE(ptr2.get_count() == 2);
+
+        ptr2 = ptr0;
+
+        REQUIRE(ptr0.get_count() == 2);
+    }
+
+    SECTION("destroys with last reference")
+    {
+        bool destroyed = false;
+        intrusive_ptr<counted_type> ptr0 = make_intrusive<counted_type>(&destroyed);
+
+        {
+            intrusive_ptr<counted_type> ptr1 = ptr0;
+        }
+
+        REQUIRE(not destroyed);
+
+        ptr0 = nullptr;
+
+        REQUIRE(destroyed);
+    }
+
+    SECTION("adopts raw pointer again")
+    {
+        intrusive_ptr<counted_type> ptr0 = make_intrusive<counted_type>();
+        intrusive_ptr<counted_type> ptr1{ ptr0.to_unwrapped() };
+
+        REQUIRE(ptr0.get_count() == 2);
+    }
+
+    SECTION("converts to base")
+    {
+        bool destroyed = false;
+        intrusive_ptr<derived_type> derived = make_intrusive<derived_type>(&destroyed);
+        intrusive_ptr<base_type> base0 = derived;
+
+        REQUIRE(base0.to_unwrapped() == derived.to_unwrapped());
+        REQUIRE(base0.get_count() == 2);
+
+        intrusive_ptr<base_type> base1 = move(derived);
+        derived = nullptr;
+
+        REQUIRE(base1.get_count() == 2);
+
+        base0 = nullptr;
+        base1 = nullptr;
+
+        REQUIRE(destroyed);
+    }
+}
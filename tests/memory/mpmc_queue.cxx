@@ -0,0 +1,195 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:mpmc_queue;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    /// --------------------------------------------------------------------------------------------
+    /// runs `producer_count` threads pushing `0..count` each and `consumer_count` threads popping
+    /// them, using blocking or batch apis.
+    ///
+    /// \returns sum of all values popped.
+    /// --------------------------------------------------------------------------------------------
+    auto run_threads(usize producer_count, usize consumer_count, u64 count, bool use_batches)
+        -> u64
+    {
+        mpmc_queue<u64> queue{ 64 };
+        std::atomic<u64> sum{ 0 };
+        std::atomic<u64> popped{ 0 };
+        const u64 total = count * producer_count;
+
+        dynamic_array<std::thread> threads;
+        for (usize i = 0; i < consumer_count; i++)
+        {
+            threads.emplace_last([&] {
+                if (not use_batches)
+                {
+                    // consumers pop their share, so that none of them blocks forever.
+                    for (u64 j = 0; j < total / consumer_count; j++)
+                        sum.fetch_add(queue.pop(), std::memory_order_relaxed);
+
+                    return;
+                }
+
+                u64 out[8];
+                while (popped.load(std::memory_order_relaxed) < total)
+                {
+                    usize batch = queue.try_pop_batch(out, 8);
+                    if (batch == 0)
+                        std::this_thread::yield();
+
+                    for (usize j = 0; j < batch; j++)
+                        sum.fetch_add(out[j], std::memory_order_relaxed);
+
+                    popped.fetch_add(batch, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (usize i = 0; i < producer_count; i++)
+        {
+            threads.emplace_last([&] {
+                if (not use_batches)
+                {
+                    for (u64 j = 0; j < count; j++)
+                        queue.push(j);
+
+                    return;
+                }
+
+                u64 values[8];
+                for (u64 pushed = 0; pushed < count; pushed += 8)
+                {
+                    for (usize j = 0; j < 8; j++)
+                        values[j] = pushed + j;
+
+                    for (usize done = 0; done < 8;)
+                    {
+                        usize pushed_now = queue.try_push_batch(values + done, 8 - done);
+                        if (pushed_now == 0)
+                            std::this_thread::yield();
+
+                        done += pushed_now;
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        return sum.load();
+    }
+
+    class counted
+    {
+    public:
+        counted(usize* live)
+            : live{ live }
+        {
+            (*live)++;
+        }
+
+        counted(const counted& that)
+            : live{ that.live }
+        {
+            (*live)++;
+        }
+
+        ~counted()
+        {
+            (*live)--;
+        }
+
+    public:
+        usize* live;
+    };
+}
+
+TEST_CASE("atom_core.mpmc_queue")
+{
+    static constexpr u64 count = 40'000;
+    static constexpr u64 sum = count * (count - 1) / 2;
+
+    SECTION("capacity")
+    {
+        REQUIRE(mpmc_queue<i32>{ 2 }.get_capacity() == 2);
+        REQUIRE(mpmc_queue<i32>{ 5 }.get_capacity() == 8);
+    }
+
+    SECTION("push and pop")
+    {
+        mpmc_queue<i32> queue{ 4 };
+
+        REQUIRE(not queue.try_pop().is_value());
+
+        for (i32 i = 0; i < 4; i++)
+            REQUIRE(queue.try_push(i));
+
+        REQUIRE(not queue.try_push(4));
+        REQUIRE(queue.get_count() == 4);
+
+        REQUIRE(queue.try_pop().get() == 0);
+        REQUIRE(queue.try_push(4));
+
+        for (i32 i = 1; i < 5; i++)
+            REQUIRE(queue.try_pop().get() == i);
+
+        REQUIRE(not queue.try_pop().is_value());
+        REQUIRE(queue.get_count() == 0);
+    }
+
+    SECTION("batches")
+    {
+        mpmc_queue<i32> queue{ 8 };
+        i32 values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        i32 out[10] = {};
+
+        REQUIRE(queue.try_push_batch(values, 10) == 8);
+        REQUIRE(queue.try_pop_batch(out, 3) == 3);
+        REQUIRE(queue.try_push_batch(values + 8, 2) == 2);
+        REQUIRE(queue.try_pop_batch(out + 3, 10) == 7);
+        REQUIRE(queue.try_pop_batch(out, 10) == 0);
+
+        for (i32 i = 0; i < 10; i++)
+            REQUIRE(out[i] == i);
+    }
+
+    SECTION("destroys values left")
+    {
+        usize live = 0;
+
+        {
+            mpmc_queue<counted> queue{ 8 };
+            for (usize i = 0; i < 5; i++)
+                queue.try_push(counted{ &live });
+
+            queue.try_pop();
+            REQUIRE(live == 4);
+        }
+
+        REQUIRE(live == 0);
+    }
+
+    SECTION("one producer, one consumer")
+    {
+        REQUIRE(run_threads(1, 1, count, false) == sum);
+    }
+
+    SECTION("many producers, many consumers")
+    {
+        REQUIRE(run_threads(4, 4, count, false) == sum * 4);
+        REQUIRE(run_threads(3, 2, count, false) == sum * 3);
+    }
+
+    SECTION("batches across threads")
+    {
+        REQUIRE(run_threads(4, 4, count, true) == sum * 4);
+    }
+}
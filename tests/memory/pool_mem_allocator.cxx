@@ -0,0 +1,117 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:pool_mem_allocator;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.pool_mem_allocator")
+{
+    pool_mem_allocator allocator;
+
+    SECTION("alloc")
+    {
+        for (usize size : { 1, 8, 16, 17, 100, 129, 1000, 8192 })
+        {
+            byte* mem = static_cast<byte*>(allocator.alloc(size));
+
+            REQUIRE(mem != nullptr);
+            REQUIRE(reinterpret_cast<usize>(mem) % 16 == 0);
+
+            mem[0] = 1;
+            mem[size - 1] = 2;
+            allocator.dealloc(mem);
+        }
+    }
+
+    SECTION("reuses freed blocks")
+    {
+        void* mem0 = allocator.alloc(32);
+        allocator.dealloc(mem0);
+        void* mem1 = allocator.alloc(32);
+
+        REQUIRE(mem1 == mem0);
+
+        allocator.dealloc(mem1);
+    }
+
+    SECTION("big allocations")
+    {
+        byte* mem = static_cast<byte*>(allocator.alloc(100'000));
+        mem[99'999] = 1;
+
+        mem = static_cast<byte*>(allocator.realloc(mem, 200'000));
+        REQUIRE(mem[99'999] == 1);
+
+        allocator.dealloc(mem);
+    }
+
+    SECTION("realloc")
+    {
+        i32* mem = static_cast<i32*>(allocator.alloc(sizeof(i32) * 4));
+        for (i32 i = 0; i < 4; i++)
+            mem[i] = i;
+
+        // same size class, stays in place.
+        REQUIRE(allocator.realloc(mem, sizeof(i32) * 3) == mem);
+
+        mem = static_cast<i32*>(allocator.realloc(mem, sizeof(i32) * 1000));
+        for (i32 i = 0; i < 4; i++)
+            REQUIRE(mem[i] == i);
+
+        mem = static_cast<i32*>(allocator.realloc(mem, sizeof(i32) * 10'000));
+        for (i32 i = 0; i < 4; i++)
+            REQUIRE(mem[i] == i);
+
+        allocator.dealloc(mem);
+    }
+
+    SECTION("free from other thread")
+    {
+        constexpr usize count = 1000;
+        void* mems[count];
+
+        for (usize i = 0; i < count; i++)
+        {
+            mems[i] = allocator.alloc(48);
+            std::memset(mems[i], 1, 48);
+        }
+
+        std::thread thread{ [&]
+            {
+                pool_mem_allocator thread_allocator;
+                for (usize i = 0; i < count; i++)
+                    thread_allocator.dealloc(mems[i]);
+            } };
+        thread.join();
+
+        // blocks freed remotely are collected and reused once the current spans run out, which
+        // happens within a few spans worth of blocks.
+        std::vector<void*> allocated;
+        usize reused_count = 0;
+        while (reused_count < count and allocated.size() < count * 8)
+        {
+            void* mem = allocator.alloc(48);
+
+            REQUIRE(mem != nullptr);
+            std::memset(mem, 2, 48);
+
+            if (std::find(mems, mems + count, mem) != mems + count)
+                reused_count++;
+
+            allocated.push_back(mem);
+        }
+
+        REQUIRE(reused_count == count);
+
+        // no block was handed out twice.
+        std::sort(allocated.begin(), allocated.end());
+        REQUIRE(std::adjacent_find(allocated.begin(), allocated.end()) == allocated.end());
+
+        for (void* mem : allocated)
+            allocator.dealloc(mem);
+    }
+}
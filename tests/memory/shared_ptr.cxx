@@ -5,55 +5,82 @@ module atom_core.tests:shared_ptr;
 
 import atom_core;
 import :tracked_type;
+import :counting_allocator;
 
 using namespace atom;
 using namespace atom::tests;
 
+namespace
+{
+    /// destructs the value without freeing its memory, for values living on the stack.
+    class stack_destroyer
+    {
+    public:
+        auto operator()(tracked_type* val)
+        {
+            val->~tracked_type();
+        }
+    };
+
+    /// value whose constructor always throws.
+    class throwing_type
+    {
+    public:
+        throwing_type()
+        {
+            throw 0;
+        }
+    };
+}
+
 TEST_CASE("atom_core.shared_ptr")
 {
     SECTION("default constructor")
     {
         shared_ptr<tracked_type> ptr;
 
-        // REQUIRE(ptr == nullptr);
+        REQUIRE(ptr.to_unwrapped() == nullptr);
+        REQUIRE(ptr.get_count() == 0);
     }
 
     SECTION("null constructor")
     {
-        shared_ptr<tracked_type> ptr;
+        shared_ptr<tracked_type> ptr(nullptr);
 
-        // REQUIRE(ptr == nullptr);
+        REQUIRE(ptr.to_unwrapped() == nullptr);
+        REQUIRE(ptr.get_count() == 0);
     }
 
     SECTION("value constructor")
     {
         tracked_type val;
-        shared_ptr<tracked_type> ptr(&val);
+        shared_ptr<tracked_type> ptr(&val, stack_destroyer());
 
-        // REQUIRE(ptr == &val);
+        REQUIRE(ptr.to_unwrapped() == &val);
         REQUIRE(ptr.get_count() == 1);
     }
 
     SECTION("copy constructor")
     {
         tracked_type val;
-        shared_ptr<tracked_type> ptr0(&val);
+        shared_ptr<tracked_type> ptr0(&val, stack_destroyer());
         shared_ptr<tracked_type> ptr1(ptr0);
 
-        // REQUIRE(ptr1 == &val);
+        REQUIRE(ptr1.to_unwrapped() == &val);
+        REQUIRE(ptr0.get_count() == 2);
         REQUIRE(ptr1.get_count() == 2);
     }
 
     SECTION("move constructor")
     {
         tracked_type val;
-        shared_ptr<tracked_type> ptr0(&val);
+        shared_ptr<tracked_type> ptr0(&val, stack_destroyer());
         shared_ptr<tracked_type> ptr1(move(ptr0));
 
-        // REQUIRE(ptr0 == nullptr);
+        REQUIRE(ptr0.to_unwrapped() == nullptr);
         REQUIRE(ptr0.get_count() == 0);
-        // REQUIRE(ptr1 == &val);
-        REQUIRE(ptr1.get_count() == 2);
+        REQUIRE(ptr1.to_unwrapped() == &val);
+        REQUIRE(ptr1.get_count() == 1);
     }
 
     SECTION("destructor")
@@ -61,7 +88,7 @@ TEST_CASE("atom_core.shared_ptr")
         tracked_type val;
 
         {
-            shared_ptr<tracked_type> ptr0(&val);
+            shared_ptr<tracked_type> ptr0(&val, stack_destroyer());
 
             {
                 shared_ptr<tracked_type> ptr1(ptr0);
@@ -76,17 +103,19 @@ TEST_CASE("atom_core.shared_ptr")
     SECTION("null operator")
     {
         tracked_type val;
-        shared_ptr<tracked_type> ptr0(&val);
+        shared_ptr<tracked_type> ptr0(&val, stack_destroyer());
         shared_ptr<tracked_type> ptr1(ptr0);
 
         ptr0 = nullptr;
 
-        // REQUIRE(ptr0 == nullptr);
+        REQUIRE(ptr0.to_unwrapped() == nullptr);
         REQUIRE(ptr0.get_count() == 0);
         REQUIRE(ptr1.get_count() == 1);
         REQUIRE(val.last_op == tracked_type::operation::default_constructor);
 
-        // REQUIRE(ptr1 == nullptr);
+        ptr1 = nullptr;
+
+        REQUIRE(ptr1.to_unwrapped() == nullptr);
         REQUIRE(ptr1.get_count() == 0);
         REQUIRE(val.last_op == tracked_type::operation::destructor);
     }
@@ -95,29 +124,40 @@ TEST_CASE("atom_core.shared_ptr")
     {
         tracked_type val0;
         tracked_type val1;
-        shared_ptr<tracked_type> ptr0(&val0);
-        shared_ptr<tracked_type> ptr1(&val1);
+        shared_ptr<tracked_type> ptr0(&val0, stack_destroyer());
+        shared_ptr<tracked_type> ptr1(&val1, stack_destroyer());
 
         ptr1 = ptr0;
 
         REQUIRE(val1.last_op == tracked_type::operation::destructor);
-        // REQUIRE(ptr1 == &val0);
+        REQUIRE(ptr1.to_unwrapped() == &val0);
         REQUIRE(ptr1.get_count() == 2);
     }
 
+    SECTION("copy operator with self")
+    {
+        shared_ptr<tracked_type> ptr = make_shared<tracked_type>();
+        shared_ptr<tracked_type>& same = ptr;
+
+        ptr = same;
+
+        REQUIRE(ptr.get_count() == 1);
+        REQUIRE(ptr.to_unwrapped()->last_op == tracked_type::operation::default_constructor);
+    }
+
     SECTION("move operator")
     {
         tracked_type val0;
         tracked_type val1;
-        shared_ptr<tracked_type> ptr0(&val0);
-        shared_ptr<tracked_type> ptr1(&val1);
+        shared_ptr<tracked_type> ptr0(&val0, stack_destroyer());
+        shared_ptr<tracked_type> ptr1(&val1, stack_destroyer());
 
         ptr1 = move(ptr0);
 
         REQUIRE(val1.last_op == tracked_type::operation::destructor);
-        // REQUIRE(ptr0 == nullptr);
+        REQUIRE(ptr0.to_unwrapped() == nullptr);
         REQUIRE(ptr0.get_count() == 0);
-        // REQUIRE(ptr1 == &val0);
+        REQUIRE(ptr1.to_unwrapped() == &val0);
         REQUIRE(ptr1.get_count() == 1);
     }
 
@@ -125,4 +165,61 @@ TEST_CASE("atom_core.shared_ptr")
     {
         // same as null operator.
     }
+
+    SECTION("make_shared() uses single allocation")
+    {
+        counting_allocator::reset();
+
+        {
+            shared_ptr<tracked_type> ptr0 = make_shared_with_alloc<tracked_type>(
+                counting_allocator());
+            shared_ptr<tracked_type> ptr1 = ptr0;
+
+            REQUIRE(ptr1.get_count() == 2);
+            REQUIRE(counting_allocator::alloc_count == 1);
+        }
+
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+
+    SECTION("make_shared() frees memory if the constructor throws")
+    {
+        counting_allocator::reset();
+
+        REQUIRE_THROWS(make_shared_with_alloc<throwing_type>(counting_allocator()));
+        REQUIRE(counting_allocator::alloc_count == 1);
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+
+    SECTION("shared across threads")
+    {
+        shared_ptr<tracked_type> ptr = make_shared<tracked_type>();
+
+        auto work = [&]
+        {
+            for (usize i = 0; i < 10'000; i++)
+            {
+                shared_ptr<tracked_type> copy = ptr;
+            }
+        };
+
+        std::thread thread0{ work };
+        std::thread thread1{ work };
+        thread0.join();
+        thread1.join();
+
+        REQUIRE(ptr.get_count() == 1);
+    }
+
+    SECTION("local_shared_ptr")
+    {
+        local_shared_ptr<tracked_type> ptr0 = make_local_shared<tracked_type>();
+        local_shared_ptr<tracked_type> ptr1 = ptr0;
+
+        REQUIRE(ptr0.get_count() == 2);
+
+        ptr1 = nullptr;
+
+        REQUIRE(ptr0.get_count() == 1);
+    }
 }
@@ -0,0 +1,177 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:spsc_queue;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    /// --------------------------------------------------------------------------------------------
+    /// counts live objects, to check that queues destroy the values they hold.
+    /// --------------------------------------------------------------------------------------------
+    class counted
+    {
+    public:
+        counted(usize* live)
+            : live{ live }
+        {
+            (*live)++;
+        }
+
+        counted(const counted& that)
+            : live{ that.live }
+        {
+            (*live)++;
+        }
+
+        ~counted()
+        {
+            (*live)--;
+        }
+
+    public:
+        usize* live;
+    };
+}
+
+TEST_CASE("atom_core.spsc_queue")
+{
+    SECTION("capacity")
+    {
+        REQUIRE(spsc_queue<i32>{ 1 }.get_capacity() == 1);
+        REQUIRE(spsc_queue<i32>{ 5 }.get_capacity() == 8);
+        REQUIRE(spsc_queue<i32>{ 16 }.get_capacity() == 16);
+    }
+
+    SECTION("push and pop")
+    {
+        spsc_queue<i32> queue{ 4 };
+
+        REQUIRE(not queue.try_pop().is_value());
+
+        REQUIRE(queue.try_push(0));
+        REQUIRE(queue.try_push(1));
+        REQUIRE(queue.try_push(2));
+        REQUIRE(queue.try_push(3));
+        REQUIRE(not queue.try_push(4));
+        REQUIRE(queue.get_count() == 4);
+
+        REQUIRE(queue.try_pop().get() == 0);
+        REQUIRE(queue.try_push(4));
+
+        for (i32 i = 1; i < 5; i++)
+            REQUIRE(queue.try_pop().get() == i);
+
+        REQUIRE(not queue.try_pop().is_value());
+        REQUIRE(queue.get_count() == 0);
+    }
+
+    SECTION("batches")
+    {
+        spsc_queue<i32> queue{ 8 };
+        i32 values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        i32 out[10] = {};
+
+        REQUIRE(queue.try_push_batch(values, 5) == 5);
+        REQUIRE(queue.try_push_batch(values + 5, 5) == 3);
+        REQUIRE(queue.try_pop_batch(out, 3) == 3);
+        REQUIRE(queue.try_push_batch(values + 8, 2) == 2);
+        REQUIRE(queue.try_pop_batch(out + 3, 10) == 7);
+        REQUIRE(queue.try_pop_batch(out, 10) == 0);
+
+        for (i32 i = 0; i < 10; i++)
+            REQUIRE(out[i] == i);
+    }
+
+    SECTION("destroys values left")
+    {
+        usize live = 0;
+
+        {
+            spsc_queue<counted> queue{ 8 };
+            for (usize i = 0; i < 5; i++)
+                queue.try_push(counted{ &live });
+
+            queue.try_pop();
+            REQUIRE(live == 4);
+        }
+
+        REQUIRE(live == 0);
+    }
+
+    SECTION("producer and consumer threads")
+    {
+        static constexpr u64 count = 100'000;
+
+        spsc_queue<u64> queue{ 64 };
+        u64 sum = 0;
+        bool is_ordered = true;
+
+        std::thread consumer{ [&] {
+            for (u64 i = 0; i < count; i++)
+            {
+                u64 value = queue.pop();
+                is_ordered = is_ordered and value == i;
+                sum += value;
+            }
+        } };
+
+        for (u64 i = 0; i < count; i++)
+            queue.push(i);
+
+        consumer.join();
+
+        REQUIRE(is_ordered);
+        REQUIRE(sum == count * (count - 1) / 2);
+    }
+
+    SECTION("batches across threads")
+    {
+        static constexpr u64 count = 100'000;
+
+        spsc_queue<u64> queue{ 64 };
+        u64 sum = 0;
+
+        std::thread consumer{ [&] {
+            u64 out[16];
+            for (u64 popped = 0; popped < count;)
+            {
+                usize batch = queue.try_pop_batch(out, 16);
+                if (batch == 0)
+                    std::this_thread::yield();
+
+                for (usize i = 0; i < batch; i++)
+                    sum += out[i];
+
+                popped += batch;
+            }
+        } };
+
+        u64 values[16];
+        for (u64 pushed = 0; pushed < count;)
+        {
+            usize batch = std::min<u64>(16, count - pushed);
+            for (usize i = 0; i < batch; i++)
+                values[i] = pushed + i;
+
+            for (usize done = 0; done < batch;)
+            {
+                usize pushed_now = queue.try_push_batch(values + done, batch - done);
+                if (pushed_now == 0)
+                    std::this_thread::yield();
+
+                done += pushed_now;
+            }
+
+            pushed += batch;
+        }
+
+        consumer.join();
+
+        REQUIRE(sum == count * (count - 1) / 2);
+    }
+}
@@ -0,0 +1,107 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:weak_ptr;
+
+import atom_core;
+import :tracked_type;
+import :counting_allocator;
+
+using namespace atom;
+using namespace atom::tests;
+
+TEST_CASE("atom_core.weak_ptr")
+{
+    SECTION("default constructor")
+    {
+        weak_ptr<tracked_type> ptr;
+
+        REQUIRE(ptr.is_expired());
+        REQUIRE(ptr.lock().to_unwrapped() == nullptr);
+    }
+
+    SECTION("lock()")
+    {
+        shared_ptr<tracked_type> shared = make_shared<tracked_type>();
+        weak_ptr<tracked_type> weak = shared;
+
+        REQUIRE(weak.get_count() == 1);
+
+        shared_ptr<tracked_type> locked = weak.lock();
+
+        REQUIRE(locked.to_unwrapped() == shared.to_unwrapped());
+        REQUIRE(shared.get_count() == 2);
+    }
+
+    SECTION("does not keep value alive")
+    {
+        weak_ptr<tracked_type> weak;
+
+        {
+            shared_ptr<tracked_type> shared = make_shared<tracked_type>();
+            weak = shared;
+
+            REQUIRE(not weak.is_expired());
+        }
+
+        REQUIRE(weak.is_expired());
+        REQUIRE(weak.lock().to_unwrapped() == nullptr);
+    }
+
+    SECTION("state outlives value")
+    {
+        counting_allocator::reset();
+
+        {
+            weak_ptr<tracked_type> weak;
+
+            {
+                shared_ptr<tracked_type> shared =
+                    make_shared_with_alloc<tracked_type>(counting_allocator());
+                weak = shared;
+            }
+
+            REQUIRE(counting_allocator::dealloc_count == 0);
+
+            weak_ptr<tracked_type> copy = weak;
+            weak.reset();
+
+            REQUIRE(counting_allocator::dealloc_count == 0);
+        }
+
+        REQUIRE(counting_allocator::dealloc_count == 1);
+    }
+
+    SECTION("lock() races with release")
+    {
+        shared_ptr<tracked_type> shared = make_shared<tracked_type>();
+        weak_ptr<tracked_type> weak = shared;
+
+        std::thread thread{ [&]
+            {
+                for (usize i = 0; i < 10'000; i++)
+                {
+                    shared_ptr<tracked_type> locked = weak.lock();
+                    if (locked.to_unwrapped() == nullptr)
+                        break;
+                }
+            } };
+
+        shared = nullptr;
+        thread.join();
+
+        REQUIRE(weak.is_expired());
+    }
+
+    SECTION("local_weak_ptr")
+    {
+        local_shared_ptr<tracked_type> shared = make_local_shared<tracked_type>();
+        local_weak_ptr<tracked_type> weak = shared;
+
+        REQUIRE(weak.lock().get_count() == 2);
+
+        shared = nullptr;
+
+        REQUIRE(weak.is_expired());
+    }
+}
@@ -0,0 +1,188 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:parallel_algorithms;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    using ints = dynamic_array<int>;
+
+    auto make_values(usize count) -> ints
+    {
+        ints values;
+        for (usize i = 0; i < count; i++)
+            values.emplace_last(int((i * 7919) % 1000));
+
+        return values;
+    }
+
+    template <typename range_type>
+    auto at(range_type& range, usize i) -> decltype(auto)
+    {
+        return ranges::get_iterator(range)[isize(i)];
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// runs each algorithm with `policy`, reading ranges made by `make_input` and writing ranges
+    /// made by `make_output`. both take the `ints` holding the values.
+    /// --------------------------------------------------------------------------------------------
+    template <typename make_input_type, typename make_output_type>
+    auto test_policy(
+        const execution_policy& policy, make_input_type make_input, make_output_type make_output)
+        -> void
+    {
+        ints storage = make_values(1000);
+        const usize count = storage.get_count();
+        const auto values = make_input(storage);
+
+        // for_each.
+        {
+            ints out_storage = storage;
+            auto out = make_output(out_storage);
+            ranges::for_each(policy, out, [](int& value) { value *= 2; });
+
+            for (usize i = 0; i < count; i++)
+                REQUIRE(at(out, i) == at(values, i) * 2);
+
+            std::atomic<usize> visited{ 0 };
+            ranges::for_each(policy, values, [&](const int&) { visited++; });
+
+            REQUIRE(visited == count);
+        }
+
+        // transform and copy.
+        {
+            ints out_storage{ create_with_count, count, 0 };
+            auto out = make_output(out_storage);
+            ranges::transform(policy, values, out, [](int value) { return value + 1; });
+
+            for (usize i = 0; i < count; i++)
+                REQUIRE(at(out, i) == at(values, i) + 1);
+
+            ranges::copy(policy, values, out);
+
+            for (usize i = 0; i < count; i++)
+                REQUIRE(at(out, i) == at(values, i));
+        }
+
+        // reduce.
+        {
+            i64 expected = 0;
+            for (usize i = 0; i < count; i++)
+                expected += at(values, i);
+
+            const i64 sum = ranges::reduce(
+                policy, values, i64(0), [](i64 sum, i64 value) { return sum + value; });
+
+            REQUIRE(sum == expected);
+
+            ints empty_storage;
+            const auto empty = make_input(empty_storage);
+
+            REQUIRE(ranges::reduce(policy, empty, 5, [](int a, int b) { return a + b; }) == 5);
+        }
+
+        // count_if.
+        {
+            usize expected = 0;
+            for (usize i = 0; i < count; i++)
+                expected += at(values, i) < 100;
+
+            REQUIRE(ranges::count_if(policy, values, [](int value) { return value < 100; })
+                    == expected);
+        }
+
+        // find_if.
+        {
+            // finds the first match, even if later chunks find theirs first.
+            ints searched_storage{ create_with_count, count, 0 };
+            searched_storage.get_at(300) = 1;
+            searched_storage.get_at(301) = 1;
+            searched_storage.get_at(900) = 1;
+
+            const auto searched = make_input(searched_storage);
+
+            auto it = ranges::find_if(policy, searched, [](int value) { return value == 1; });
+
+            REQUIRE(it == ranges::get_iterator(searched) + 300);
+
+            auto end = ranges::find_if(policy, searched, [](int value) { return value == 2; });
+
+            REQUIRE(end == ranges::get_iterator(searched) + isize(count));
+        }
+
+        // sort.
+        {
+            ints sorted_storage = storage;
+            auto sorted = make_output(sorted_storage);
+            ranges::sort(policy, sorted);
+
+            std::vector<int> expected;
+            for (usize i = 0; i < count; i++)
+                expected.push_back(at(values, i));
+
+            std::sort(expected.begin(), expected.end());
+
+            for (usize i = 0; i < count; i++)
+                REQUIRE(at(sorted, i) == expected[i]);
+
+            ranges::sort(policy, sorted, [](int a, int b) { return a > b; });
+
+            for (usize i = 1; i < count; i++)
+                REQUIRE(at(sorted, i - 1) >= at(sorted, i));
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// runs `test_policy()` on `std::vector`, `dynamic_array` and on `array_view` and
+    /// `array_slice` over a `dynamic_array`.
+    /// --------------------------------------------------------------------------------------------
+    auto test_ranges(const execution_policy& policy) -> void
+    {
+        auto to_vector = [](ints& storage) {
+            return std::vector<int>(storage.get_data(), storage.get_data() + storage.get_count());
+        };
+
+        test_policy(policy, to_vector, to_vector);
+
+        auto to_dynamic_array = [](ints& storage) { return ints{ storage }; };
+
+        test_policy(policy, to_dynamic_array, to_dynamic_array);
+
+        test_policy(
+            policy, [](ints& storage) { return array_view<int>{ storage }; },
+            [](ints& storage) { return array_slice<int>{ storage }; });
+    }
+}
+
+TEST_CASE("atom_core.parallel.parallel_algorithms")
+{
+    SECTION("execution_policy")
+    {
+        REQUIRE(not execution_policy::sequential().is_parallel());
+        REQUIRE(execution_policy::parallel().is_parallel());
+        REQUIRE(execution_policy::parallel().get_grain_size() == 0);
+        REQUIRE(execution_policy::parallel(64).get_grain_size() == 64);
+    }
+
+    SECTION("sequential")
+    {
+        test_ranges(execution_policy::sequential());
+    }
+
+    SECTION("parallel")
+    {
+        test_ranges(execution_policy::parallel());
+    }
+
+    SECTION("parallel with grain size")
+    {
+        // small grain size, to run the parallel path on small ranges.
+        test_ranges(execution_policy::parallel(7));
+    }
+}
@@ -0,0 +1,136 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:task_scheduler;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto fib(task_group& group, u64 n) -> u64
+    {
+        if (n < 2)
+            return n;
+
+        if (n < 12)
+            return fib(group, n - 1) + fib(group, n - 2);
+
+        // nested groups wait from inside tasks, running other tasks meanwhile.
+        u64 first = 0;
+        task_group nested{ group.get_scheduler() };
+        nested.spawn([&] { first = fib(nested, n - 1); });
+
+        u64 second = fib(nested, n - 2);
+        nested.wait();
+
+        return first + second;
+    }
+}
+
+TEST_CASE("atom_core.parallel.task_scheduler")
+{
+    task_scheduler scheduler{ task_scheduler::options{ .worker_count = 4 } };
+
+    REQUIRE(scheduler.get_worker_count() == 4);
+    REQUIRE(not scheduler.is_worker_thread());
+
+    SECTION("task_group")
+    {
+        static constexpr usize task_count = 10000;
+
+        std::atomic<usize> count{ 0 };
+        task_group group{ scheduler };
+
+        for (usize i = 0; i < task_count; i++)
+            group.spawn([&] { count.fetch_add(1, std::memory_order_relaxed); });
+
+        group.wait();
+
+        REQUIRE(group.is_done());
+        REQUIRE(count == task_count);
+    }
+
+    SECTION("tasks spawning tasks")
+    {
+        std::atomic<usize> count{ 0 };
+        task_group group{ scheduler };
+
+        for (usize i = 0; i < 100; i++)
+        {
+            group.spawn([&] {
+                for (usize j = 0; j < 100; j++)
+                    group.spawn([&] { count.fetch_add(1, std::memory_order_relaxed); });
+            });
+        }
+
+        group.wait();
+
+        REQUIRE(count == 100 * 100);
+    }
+
+    SECTION("nested wait")
+    {
+        task_group group{ scheduler };
+        u64 result = 0;
+        group.spawn([&] { result = fib(group, 25); });
+        group.wait();
+
+        REQUIRE(result == 75025);
+    }
+
+    SECTION("detached tasks")
+    {
+        std::atomic<usize> count{ 0 };
+
+        {
+            task_scheduler detached_scheduler{ task_scheduler::options{ .worker_count = 2 } };
+            for (usize i = 0; i < 1000; i++)
+                detached_scheduler.spawn([&] { count.fetch_add(1, std::memory_order_relaxed); });
+        }
+
+        // the destructor waits for detached tasks.
+        REQUIRE(count == 1000);
+    }
+
+    SECTION("tasks are recycled")
+    {
+        auto spawn_round = [&] {
+            std::atomic<usize> count{ 0 };
+            task_group group{ scheduler };
+            for (usize i = 0; i < 1000; i++)
+                group.spawn([&] { count.fetch_add(1, std::memory_order_relaxed); });
+
+            group.wait();
+            REQUIRE(count == 1000);
+        };
+
+        spawn_round();
+        const usize block_count = scheduler.get_task_block_count();
+
+        // tasks spawned from this thread go back to its cache, whichever worker ran them.
+        for (usize round = 0; round < 100; round++)
+            spawn_round();
+
+        REQUIRE(scheduler.get_task_block_count() == block_count);
+    }
+
+    SECTION("idle workers wake up")
+    {
+        for (usize round = 0; round < 20; round++)
+        {
+            std::this_thread::yield();
+
+            std::atomic<usize> count{ 0 };
+            task_group group{ scheduler };
+            for (usize i = 0; i < 8; i++)
+                group.spawn([&] { count.fetch_add(1, std::memory_order_relaxed); });
+
+            group.wait();
+
+            REQUIRE(count == 8);
+        }
+    }
+}
@@ -0,0 +1,186 @@
+module;
+#include "atom/core/preprocessors.h"
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:byte_search;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto make_view(const std::string& str) -> string_view
+    {
+        return string_view{ ranges::from(str.data(), str.size()) };
+    }
+
+    auto as_bytes(const std::string& str) -> const u8*
+    {
+        return reinterpret_cast<const u8*>(str.data());
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// runs the kernels of `kernel_type` directly, since the dispatched ones only cover the
+    /// kernels picked for this cpu.
+    /// --------------------------------------------------------------------------------------------
+    template <typename kernel_type>
+    auto test_kernel() -> void
+    {
+        std::string text(1000, 'a');
+        const u8* data = as_bytes(text);
+        const usize count = text.size();
+
+        for (usize pos : { 0, 15, 16, 31, 32, 33, 500, 999 })
+        {
+            std::string str = text;
+            str[pos] = 'x';
+
+            REQUIRE(kernel_type::find_byte(as_bytes(str), count, u8('x')) == pos);
+            REQUIRE(kernel_type::find_any_byte(as_bytes(str), count, as_bytes("x"), 1) == pos);
+            REQUIRE(kernel_type::find_any_byte(as_bytes(str), count, as_bytes("zyx"), 3) == pos);
+
+            std::string set_big = "0123456789:;<=>?x";
+            REQUIRE(kernel_type::find_any_byte(as_bytes(str), count, as_bytes(set_big),
+                        set_big.size())
+                    == pos);
+        }
+
+        REQUIRE(kernel_type::find_byte(data, count, u8('x')) == count);
+        REQUIRE(kernel_type::find_byte(data, 0, u8('a')) == 0);
+
+        // empty sets match nothing.
+        REQUIRE(kernel_type::find_any_byte(data, count, nullptr, 0) == count);
+        REQUIRE(kernel_type::find_any_byte(data, 0, nullptr, 0) == 0);
+        REQUIRE(kernel_type::find_any_byte(data, count, as_bytes("xyz"), 3) == count);
+
+        std::string needle = "abcab";
+        for (usize pos : { 0, 10, 31, 32, 600, 995 })
+        {
+            std::string str = text;
+            str.replace(pos, needle.size(), needle);
+
+            REQUIRE(kernel_type::find_bytes(as_bytes(str), count, as_bytes(needle), 5) == pos);
+        }
+
+        // empty needles match at the start.
+        REQUIRE(kernel_type::find_bytes(data, count, nullptr, 0) == 0);
+        REQUIRE(kernel_type::find_bytes(data, 0, nullptr, 0) == 0);
+        REQUIRE(kernel_type::find_bytes(data, count, as_bytes(needle), 5) == count);
+        REQUIRE(kernel_type::find_bytes(data, 2, as_bytes("aaa"), 3) == 2);
+        REQUIRE(kernel_type::find_bytes(data, count, as_bytes("aa"), 2) == 0);
+
+        std::string other = text;
+        REQUIRE(kernel_type::is_eq_bytes(data, as_bytes(other), count));
+        REQUIRE(kernel_type::is_eq_bytes(data, nullptr, 0));
+
+        other[777] = 'b';
+        REQUIRE(not kernel_type::is_eq_bytes(data, as_bytes(other), count));
+        REQUIRE(kernel_type::is_eq_bytes(data, as_bytes(other), 777));
+    }
+}
+
+TEST_CASE("atom_core.ranges.byte_search")
+{
+    // long enough to go through the simd loops and the scalar tails.
+    std::string text(1000, 'a');
+    string_view view = make_view(text);
+
+    SECTION("find()")
+    {
+        for (usize pos : { 0, 15, 16, 31, 32, 33, 500, 998, 999 })
+        {
+            std::string str = text;
+            str[pos] = 'x';
+            string_view str_view = make_view(str);
+
+            REQUIRE(ranges::find(str_view, 'x') == str_view.get_iterator() + pos);
+            REQUIRE(ranges::contains(str_view, 'x'));
+        }
+
+        REQUIRE(ranges::find(view, 'x') == view.get_iterator_end());
+        REQUIRE(not ranges::contains(view, 'x'));
+    }
+
+    SECTION("find_range()")
+    {
+        std::string needle = "abcab";
+
+        for (usize pos : { 0, 10, 31, 32, 600, 995 })
+        {
+            std::string str = text;
+            str.replace(pos, needle.size(), needle);
+            string_view str_view = make_view(str);
+
+            REQUIRE(
+                ranges::find_range(str_view, make_view(needle)) == str_view.get_iterator() + pos);
+        }
+
+        REQUIRE(ranges::find_range(view, make_view(needle)) == view.get_iterator_end());
+        REQUIRE(ranges::find_range(view, make_view("aaa")) == view.get_iterator());
+
+        std::string short_str = "ab";
+        string_view short_view = make_view(short_str);
+
+        REQUIRE(ranges::find_range(short_view, make_view("abc")) == short_view.get_iterator_end());
+    }
+
+    SECTION("find_any()")
+    {
+        std::string set_small = ":\r\n";
+        std::string set_big = "0123456789:;<=>?@";
+
+        for (usize pos : { 0, 17, 32, 64, 999 })
+        {
+            std::string str = text;
+            str[pos] = '\n';
+            string_view str_view = make_view(str);
+
+            REQUIRE(ranges::find_any(str_view, make_view(set_small))
+                    == str_view.get_iterator() + pos);
+
+            str[pos] = '@';
+            str_view = make_view(str);
+
+            REQUIRE(
+                ranges::find_any(str_view, make_view(set_big)) == str_view.get_iterator() + pos);
+        }
+
+        REQUIRE(ranges::find_any(view, make_view(set_small)) == view.get_iterator_end());
+    }
+
+    SECTION("compare")
+    {
+        std::string other = text;
+        REQUIRE(view == make_view(other));
+
+        other[777] = 'b';
+        REQUIRE(view != make_view(other));
+
+        other.pop_back();
+        REQUIRE(view != make_view(other));
+    }
+}
+
+TEST_CASE("atom_core.ranges.byte_search.kernels")
+{
+    SECTION("scalar")
+    {
+        test_kernel<ranges::_byte_search_scalar>();
+    }
+
+#if defined(ATOM_ARCH_X86_64) && defined(ATOM_HAS_ATTR_TARGET)
+    SECTION("sse4.2")
+    {
+        if (__builtin_cpu_supports("sse4.2"))
+            test_kernel<ranges::_byte_search_sse4_2>();
+    }
+
+    SECTION("avx2")
+    {
+        if (__builtin_cpu_supports("avx2"))
+            test_kernel<ranges::_byte_search_avx2>();
+    }
+#endif
+}
@@ -0,0 +1,132 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:range_views;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    template <typename range_type>
+    auto collect(const range_type& range) -> std::vector<ranges::value_type<range_type>>
+    {
+        std::vector<ranges::value_type<range_type>> result;
+        for (auto it = ranges::get_iterator(range); it != ranges::get_iterator_end(range); it++)
+            result.push_back(*it);
+
+        return result;
+    }
+
+    using ints = std::vector<int>;
+}
+
+TEST_CASE("atom_core.ranges.range_views")
+{
+    const ints values{ 1, 2, 3, 4, 5, 6, 7 };
+
+    SECTION("map")
+    {
+        usize call_count = 0;
+        auto view = values | ranges::map([&](int value) {
+            call_count++;
+            return value * 10;
+        });
+
+        REQUIRE(call_count == 0);
+        REQUIRE(collect(view) == ints{ 10, 20, 30, 40, 50, 60, 70 });
+        REQUIRE(call_count == values.size());
+
+        // counting doesn't need the values.
+        call_count = 0;
+
+        REQUIRE(ranges::count_values(view) == values.size());
+        REQUIRE(call_count == 0);
+    }
+
+    SECTION("filter")
+    {
+        auto view = ranges::filter(values, [](int value) { return value % 2 == 0; });
+
+        REQUIRE(collect(view) == ints{ 2, 4, 6 });
+        REQUIRE(collect(values | ranges::filter([](int value) { return value > 10; })).empty());
+    }
+
+    SECTION("take and drop")
+    {
+        auto taken = values | ranges::take(3);
+        auto dropped = values | ranges::drop(5);
+
+        // arrays stay arrays.
+        STATIC_REQUIRE(ranges::const_array_range_concept<decltype(taken)>);
+        STATIC_REQUIRE(ranges::const_array_range_concept<decltype(dropped)>);
+
+        REQUIRE(collect(taken) == ints{ 1, 2, 3 });
+        REQUIRE(collect(dropped) == ints{ 6, 7 });
+        REQUIRE(collect(values | ranges::take(100)) == values);
+        REQUIRE(collect(values | ranges::drop(100)).empty());
+    }
+
+    SECTION("zip")
+    {
+        const std::vector<char> chars{ 'a', 'b', 'c' };
+        auto view = ranges::zip(values, chars);
+
+        std::vector<std::pair<int, char>> result;
+        for (auto it = ranges::get_iterator(view); it != ranges::get_iterator_end(view); it++)
+            result.push_back({ it->get_first(), it->get_second() });
+
+        REQUIRE(result == std::vector<std::pair<int, char>>{ { 1, 'a' }, { 2, 'b' }, { 3, 'c' } });
+        REQUIRE(ranges::count_values(values | ranges::zip(chars)) == 3);
+    }
+
+    SECTION("enumerate")
+    {
+        auto view = values | ranges::drop(4) | ranges::enumerate();
+
+        std::vector<std::pair<usize, int>> result;
+        for (auto it = ranges::get_iterator(view); it != ranges::get_iterator_end(view); it++)
+            result.push_back({ it->get_index(), it->get_value() });
+
+        REQUIRE(result == std::vector<std::pair<usize, int>>{ { 0, 5 }, { 1, 6 }, { 2, 7 } });
+    }
+
+    SECTION("chunk")
+    {
+        auto view = values | ranges::chunk(3);
+
+        std::vector<ints> result;
+        for (auto it = ranges::get_iterator(view); it != ranges::get_iterator_end(view); it++)
+            result.push_back(collect(*it));
+
+        REQUIRE(result == std::vector<ints>{ { 1, 2, 3 }, { 4, 5, 6 }, { 7 } });
+        REQUIRE(ranges::count_values(view) == 3);
+    }
+
+    SECTION("stride")
+    {
+        REQUIRE(collect(values | ranges::stride(3)) == ints{ 1, 4, 7 });
+        REQUIRE(collect(values | ranges::stride(2)) == ints{ 1, 3, 5, 7 });
+        REQUIRE(ranges::count_values(values | ranges::stride(2)) == 4);
+    }
+
+    SECTION("pipeline")
+    {
+        auto view = values | ranges::filter([](int value) { return value % 2 == 1; })
+                    | ranges::map([](int value) { return value * value; }) | ranges::take(3);
+
+        REQUIRE(collect(view) == ints{ 1, 9, 25 });
+    }
+
+    SECTION("insert_range_last")
+    {
+        dynamic_array<int> array;
+        array.insert_range_last(values | ranges::map([](int value) { return value + 1; }));
+
+        REQUIRE(array.get_count() == values.size());
+        REQUIRE(array.get_at(0) == 2);
+        REQUIRE(array.get_at(6) == 8);
+    }
+}
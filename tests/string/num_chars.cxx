@@ -0,0 +1,139 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:num_chars;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto make_view(const std::string& str) -> string_view
+    {
+        return string_view{ ranges::from(str.data(), str.size()) };
+    }
+
+    template <typename num_type>
+    auto write(num_type num) -> std::string
+    {
+        char buf[nums::get_max_chars<num_type>()];
+        usize count = nums::to_chars(num, buf);
+
+        return std::string(buf, count);
+    }
+
+    template <typename num_type>
+    auto parse(const std::string& str) -> result<num_type, parse_error>
+    {
+        return nums::from_chars<num_type>(make_view(str));
+    }
+}
+
+TEST_CASE("atom_core.num_chars")
+{
+    SECTION("to_chars() integers")
+    {
+        REQUIRE(write(i32(0)) == "0");
+        REQUIRE(write(i32(7)) == "7");
+        REQUIRE(write(i32(-42)) == "-42");
+        REQUIRE(write(u32(1000)) == "1000");
+        REQUIRE(write(i8(-128)) == "-128");
+        REQUIRE(write(u64(18446744073709551615ull)) == "18446744073709551615");
+        REQUIRE(write(nums::get_min<i64>()) == "-9223372036854775808");
+
+        for (u64 num = 1; num < 10000000000000000000ull; num *= 10)
+        {
+            REQUIRE(write(num - 1) == std::to_string(num - 1));
+            REQUIRE(write(num) == std::to_string(num));
+        }
+    }
+
+    SECTION("to_chars() floats")
+    {
+        REQUIRE(write(f64(0.1)) == "0.1");
+        REQUIRE(write(f64(-1.5)) == "-1.5");
+        REQUIRE(write(f32(3.25f)) == "3.25");
+        REQUIRE(write(f64(1e300)) == "1e+300");
+    }
+
+    SECTION("from_chars() integers")
+    {
+        REQUIRE(parse<i32>("0").get_value() == 0);
+        REQUIRE(parse<i32>("-123").get_value() == -123);
+        REQUIRE(parse<u32>("000123").get_value() == 123);
+        REQUIRE(parse<u64>("1234567890123456789").get_value() == 1234567890123456789ull);
+        REQUIRE(parse<u64>("18446744073709551615").get_value() == 18446744073709551615ull);
+        REQUIRE(parse<i64>("-9223372036854775808").get_value() == nums::get_min<i64>());
+        REQUIRE(parse<i8>("-128").get_value() == -128);
+    }
+
+    SECTION("from_chars() integer errors")
+    {
+        REQUIRE(parse<i32>("").is_error());
+        REQUIRE(parse<i32>("-").is_error());
+        REQUIRE(parse<i32>("12a").is_error());
+        REQUIRE(parse<i32>("1234567a").is_error());
+        REQUIRE(parse<u32>("-1").is_error());
+        REQUIRE(parse<i8>("128").is_error());
+        REQUIRE(parse<u32>("4294967296").is_error());
+        REQUIRE(parse<u64>("18446744073709551616").is_error());
+        REQUIRE(parse<u64>("99999999999999999999").is_error());
+        REQUIRE(parse<u64>("123456789012345678901").is_error());
+    }
+
+    SECTION("from_chars() floats")
+    {
+        REQUIRE(parse<f64>("0.1").get_value() == 0.1);
+        REQUIRE(parse<f64>("-2.5e3").get_value() == -2500.0);
+        REQUIRE(parse<f32>("3.25").get_value() == 3.25f);
+        REQUIRE(parse<f64>("1.5x").is_error());
+        REQUIRE(parse<f64>("1e999").is_error());
+    }
+
+    SECTION("round trip")
+    {
+        for (f64 num : { 0.1, 1.0 / 3, 123456.789, 5e-324, 1.7976931348623157e308 })
+            REQUIRE(parse<f64>(write(num)).get_value() == num);
+    }
+
+    SECTION("batch")
+    {
+        i32 values[] = { 1, -20, 300 };
+        string str;
+        nums::to_chars(values, ',', str);
+
+        REQUIRE(std::string_view(str) == "1,-20,300");
+
+        std::string strs_storage[] = { "4", "-50", "600" };
+        string_view strs[] = { make_view(strs_storage[0]), make_view(strs_storage[1]),
+            make_view(strs_storage[2]) };
+
+        i32 out[3];
+        REQUIRE(nums::from_chars(strs, out).is_value());
+        REQUIRE(out[0] == 4);
+        REQUIRE(out[1] == -50);
+        REQUIRE(out[2] == 600);
+
+        strs_storage[1] = "x";
+        strs[1] = make_view(strs_storage[1]);
+        REQUIRE(nums::from_chars(strs, out).is_error());
+    }
+
+    SECTION("batch grows output in chunks")
+    {
+        std::vector<i64> values;
+        std::string expected;
+        for (i64 i = 0; i < 1000; i++)
+        {
+            values.push_back(i * 1000003);
+            expected += (i == 0 ? "" : " ") + std::to_string(i * 1000003);
+        }
+
+        string str;
+        nums::to_chars(array_view<i64>{ ranges::from(values.data(), values.size()) }, ' ', str);
+
+        REQUIRE(std::string_view(str) == expected);
+    }
+}
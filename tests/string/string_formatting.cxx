@@ -0,0 +1,79 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:string_formatting;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.string_formatting")
+{
+    SECTION("format into string")
+    {
+        string str = string::format("{} + {} = {}", 1, 2, 3);
+
+        REQUIRE(std::string_view(str) == "1 + 2 = 3");
+    }
+
+    SECTION("format_to appends")
+    {
+        string str = string::format("{}", 1);
+        string::format_to(str, ", {}", 2);
+
+        REQUIRE(std::string_view(str) == "1, 2");
+    }
+
+    SECTION("long output grows string")
+    {
+        string str;
+        for (i32 i = 0; i < 1000; i++)
+            string::format_to(str, "{},", i);
+
+        std::string expected;
+        for (i32 i = 0; i < 1000; i++)
+            expected += std::to_string(i) + ",";
+
+        REQUIRE(std::string_view(str) == expected);
+    }
+
+    SECTION("format specs")
+    {
+        string str = string::format("[{:>4}|{:x}|{:.2f}]", 7, 255, 1.5);
+
+        REQUIRE(std::string_view(str) == "[   7|ff|1.50]");
+    }
+
+    SECTION("escaped braces and manual indices")
+    {
+        string str = string::format("{{{1}, {0}}}", 1, 2);
+
+        REQUIRE(std::string_view(str) == "{2, 1}");
+    }
+
+    SECTION("runtime fallback")
+    {
+        // dynamic width cannot be resolved at compile time.
+        string str0 = string::format("[{:{}}]", 1, 3);
+
+        REQUIRE(std::string_view(str0) == "[  1]");
+
+        // more fields than the layout can hold.
+        string str1 = string::format("{} {} {} {} {} {} {} {} {}", 1, 2, 3, 4, 5, 6, 7, 8, 9);
+
+        REQUIRE(std::string_view(str1) == "1 2 3 4 5 6 7 8 9");
+    }
+
+    SECTION("format into dynamic_buffer")
+    {
+        dynamic_buffer buffer;
+        string::format_to(buffer, "{}-{}", 10, 20);
+        string::format_to(buffer, "-{}", 30);
+
+        std::string_view result(
+            reinterpret_cast<const char*>(buffer.get_data()), buffer.get_size());
+
+        REQUIRE(result == "10-20-30");
+    }
+}
@@ -0,0 +1,96 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:string_split;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto make_view(const std::string& str) -> string_view
+    {
+        return string_view{ ranges::from(str.data(), str.size()) };
+    }
+
+    template <typename range_type>
+    auto collect(const range_type& range) -> std::vector<std::string>
+    {
+        std::vector<std::string> result;
+        for (string_view slice : range)
+            result.emplace_back(slice.get_data(), slice.get_count());
+
+        return result;
+    }
+
+    using strings = std::vector<std::string>;
+}
+
+TEST_CASE("atom_core.string_split")
+{
+    SECTION("split by char")
+    {
+        std::string str = "a,bc,,d,";
+
+        REQUIRE(collect(split(make_view(str), ',')) == strings{ "a", "bc", "", "d", "" });
+        REQUIRE(collect(split(make_view(str), ';')) == strings{ "a,bc,,d," });
+    }
+
+    SECTION("split by string")
+    {
+        std::string str = "one::two:three::";
+
+        REQUIRE(collect(split(make_view(str), "::")) == strings{ "one", "two:three", "" });
+    }
+
+    SECTION("split_any()")
+    {
+        std::string str = "k=v;x:y";
+
+        REQUIRE(collect(split_any(make_view(str), "=;:")) == strings{ "k", "v", "x", "y" });
+    }
+
+    SECTION("lines()")
+    {
+        std::string str = "first\r\nsecond\n\nlast\n";
+
+        REQUIRE(collect(lines(make_view(str))) == strings{ "first", "second", "", "last" });
+    }
+
+    SECTION("tokenize()")
+    {
+        std::string str = "  hello \t world  ";
+        auto is_space = [](char ch) { return ch == ' ' or ch == '\t'; };
+
+        REQUIRE(collect(tokenize(make_view(str), is_space)) == strings{ "hello", "world" });
+    }
+
+    SECTION("pipe")
+    {
+        std::string str = "1 2 3";
+
+        REQUIRE(collect(make_view(str) | split(' ')) == strings{ "1", "2", "3" });
+        REQUIRE(collect(make_view(str) | split_any(" ")) == strings{ "1", "2", "3" });
+    }
+
+    SECTION("slices point into the string")
+    {
+        std::string str = "ab,cd";
+        auto slices = split(make_view(str), ',');
+        auto it = slices.get_iterator();
+
+        REQUIRE(it->get_data() == str.data());
+        ++it;
+        REQUIRE(it->get_data() == str.data() + 3);
+    }
+
+    SECTION("empty string")
+    {
+        std::string str;
+
+        REQUIRE(collect(split(make_view(str), ',')).empty());
+        REQUIRE(collect(lines(make_view(str))).empty());
+    }
+}
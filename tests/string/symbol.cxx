@@ -0,0 +1,112 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:symbol;
+
+import std;
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto make_view(const std::string& str) -> string_view
+    {
+        return string_view{ ranges::from(str.data(), str.size()) };
+    }
+}
+
+TEST_CASE("atom_core.symbol")
+{
+    SECTION("equal strings give equal symbols")
+    {
+        std::string text = "metric.name";
+        symbol sym0{ make_view(text) };
+        symbol sym1{ "metric.name" };
+        symbol sym2{ string(create_from_raw, "metric.name") };
+
+        REQUIRE(sym0 == sym1);
+        REQUIRE(sym1 == sym2);
+        REQUIRE(sym0.get_data() == sym1.get_data());
+        REQUIRE(sym0 != symbol{ "metric.other" });
+    }
+
+    SECTION("view and hash")
+    {
+        symbol sym{ "column" };
+        string_view view = sym;
+
+        REQUIRE(view.get_count() == 6);
+        REQUIRE(std::string_view(sym.get_data()) == "column");
+        REQUIRE(sym == make_view("column"));
+        REQUIRE(sym.get_hash() == hash::get_hash(make_view("column")));
+        REQUIRE(hash::get_hash(sym, 7) == hash::get_hash(make_view("column"), 7));
+    }
+
+    SECTION("empty symbol")
+    {
+        REQUIRE(symbol{} == symbol{ "" });
+        REQUIRE(symbol{}.is_empty());
+        REQUIRE(symbol{}.get_data()[0] == '\0');
+    }
+
+    SECTION("per table interning")
+    {
+        symbol_table table;
+        symbol local = table.intern(make_view("header"));
+
+        REQUIRE(local == symbol(table, make_view("header")));
+        REQUIRE(local != symbol{ "header" });
+        REQUIRE(table.get_count() == 1);
+    }
+
+    SECTION("growing keeps symbols")
+    {
+        symbol_table table;
+        std::vector<symbol> symbols;
+
+        for (i32 i = 0; i < 2000; i++)
+            symbols.push_back(table.intern(make_view(std::to_string(i))));
+
+        REQUIRE(table.get_count() == 2000);
+
+        for (i32 i = 0; i < 2000; i++)
+        {
+            std::string str = std::to_string(i);
+            REQUIRE(table.intern(make_view(str)) == symbols[i]);
+            REQUIRE(symbols[i] == make_view(str));
+        }
+    }
+
+    SECTION("concurrent interning")
+    {
+        symbol_table table;
+        std::vector<std::vector<symbol>> results(4);
+        std::vector<std::thread> threads;
+
+        for (usize t = 0; t < results.size(); t++)
+        {
+            threads.emplace_back([&, t] {
+                for (i32 i = 0; i < 1000; i++)
+                    results[t].push_back(table.intern(make_view(std::to_string(i))));
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        REQUIRE(table.get_count() == 1000);
+        for (usize t = 1; t < results.size(); t++)
+            REQUIRE(results[t] == results[0]);
+    }
+
+    SECTION("flat_hash_map keyed by symbol")
+    {
+        flat_hash_map<symbol, i32> map;
+        map.emplace(symbol{ "one" }, 1);
+        map.emplace(symbol{ "two" }, 2);
+
+        REQUIRE(map.contains(symbol{ "two" }));
+        REQUIRE(map.contains(make_view("one")));
+    }
+}